@@ -0,0 +1,93 @@
+/************************************************************************************
+ Title:         AllocationCounter.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of AllocationCounter.h. Replaces the global operator
+                new and delete with versions that count every allocation.
+ 
+ Purpose:       Lets benchmarks report allocations per operation.
+ 
+ Usage:         AllocationCounter::getCount(); AllocationCounter::getThreadCount()
+ 
+ Build with:    Link into the program that needs the counts.
+ 
+ Modifications: Every allocation is also counted for the thread that made it.
+ ***********************************************************************************/
+
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+using namespace std;
+
+static atomic<long> allocationCount(0);
+static thread_local long threadAllocationCount = 0; //Constant-initialized, so usable inside operator new
+
+/*
+ *Description: Returns the number of allocations made by all threads since the program started
+ *Precondition: AllocationCounter.cpp is linked into the program
+ *Postcondition: The allocation count is returned
+ */
+long AllocationCounter::getCount()
+{
+    return allocationCount.load(memory_order_relaxed);
+}
+
+/*
+ *Description: Returns the number of allocations made by the calling thread since it started
+ *Precondition: AllocationCounter.cpp is linked into the program
+ *Postcondition: The thread's allocation count is returned
+ */
+long AllocationCounter::getThreadCount()
+{
+    return threadAllocationCount;
+}
+
+void* operator new(size_t size)
+{
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    threadAllocationCount++;
+    if(void* memory = malloc(size ? size : 1))
+        return memory;
+    throw bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const nothrow_t&) noexcept
+{
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    threadAllocationCount++;
+    return malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const nothrow_t& tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+    free(memory);
+}
@@ -0,0 +1,44 @@
+/************************************************************************************
+ Title:         AllocationCounter.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   Counts heap allocations made through the global operator new.
+ 
+ Purpose:       Lets benchmarks report allocations per operation. Linking
+                AllocationCounter.cpp into a program replaces the global operator new and
+                delete with counting versions; programs that do not link it are unaffected.
+ 
+ Usage:         long before = AllocationCounter::getCount(); ...;
+                long allocations = AllocationCounter::getCount() - before;
+                getThreadCount counts the calling thread's allocations only, so other
+                threads' work does not show up in the difference.
+ 
+ Build with:    Link AllocationCounter.cpp into the program that needs the counts.
+ 
+ Modifications: Added the per-thread count.
+ ***********************************************************************************/
+
+#ifndef TicTacToe_AllocationCounter_h
+#define TicTacToe_AllocationCounter_h
+
+class AllocationCounter {
+
+public:
+    static long getCount();
+    /*
+     *Description: Returns the number of allocations made by all threads since the program started
+     *Precondition: AllocationCounter.cpp is linked into the program
+     *Postcondition: The allocation count is returned
+     */
+    
+    static long getThreadCount();
+    /*
+     *Description: Returns the number of allocations made by the calling thread since it started
+     *Precondition: AllocationCounter.cpp is linked into the program
+     *Postcondition: The thread's allocation count is returned
+     */
+};
+#endif
@@ -0,0 +1,765 @@
+/************************************************************************************
+ Title:         AlphaBetaSearch.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of AlphaBetaSearch.h. Negamax with alpha-beta pruning
+                over CellMasks with incrementally counted lines.
+ 
+ Purpose:       Provides a searching opponent for boards of any size, with or without a
+                deadline.
+ 
+ Usage:         AlphaBetaSearch search; Location move = search.chooseMove(board, "X");
+ 
+ Build with:    Compile with main.cpp.
+ 
+ Modifications: Works on boards of any size and can search until a deadline.
+                Added the lazy SMP search. Link with -pthread.
+                Counts lines updated and table hits and misses.
+                Evaluates with an NTupleNetwork when one is set for the board.
+                The table and helpers can be allocated before a timed search(reserve).
+                Added newGame, so a game is searched the same whatever was searched before.
+                The network only evaluates searches of up to NETWORK_MAX_DEPTH without a deadline.
+ ***********************************************************************************/
+
+#include "AlphaBetaSearch.h"
+#include "Zobrist.h"
+#include <algorithm>
+#include <cstdlib>
+using namespace std;
+
+//Scores beyond MATE_BOUND are forced wins or losses and are stored relative to the position
+static const int MATE_BOUND = AlphaBetaSearch::WIN_SCORE - 1000;
+
+//A line holding n stones of one side only is worth 8^(n-1), up to this value
+static const int MAX_WEIGHT = 4096;
+
+//Boards with more cells than this only search the cells near the stones
+static const int SMALL_BOARD_CELLS = 64;
+
+/*
+ *Description: Constructor that selects DEFAULT_DEPTH
+ *Precondition: N/A
+ *Postcondition: The search is ready; no memory has been allocated
+ */
+AlphaBetaSearch::AlphaBetaSearch()
+    : geometry(0), network(0), networkWeights(0), networkTableSize(0), winLength(0), hash(0), side(0), evaluation(0), depth(DEFAULT_DEPTH), timed(false),
+      timedOut(false), completedDepth(0), nodes(0), linesEvaluated(0), tableHits(0), tableMisses(0), score(0), threads(1), helperIndex(0), stopSignal(0),
+      stopping(false), ownTable(TABLE_BITS), table(&ownTable)
+{
+    clearHistory();
+}
+
+/*
+ *Description: Returns the best move found for the supplied ID by searching to the set depth
+ *Precondition: The game is not over
+ *Postcondition: A vacant Location is returned
+ */
+Location AlphaBetaSearch::chooseMove(const GameBoard& board, string ownID)
+{
+    timed = false;
+    return search(board, ownID, depth);
+}
+
+/*
+ *Description: Returns the best move found for the supplied ID by searching deeper until the deadline
+ *Precondition: The game is not over
+ *Postcondition: A vacant Location is returned shortly after the deadline at the latest
+ */
+Location AlphaBetaSearch::chooseMove(const GameBoard& board, string ownID, chrono::steady_clock::time_point end)
+{
+    timed = true;
+    deadline = end;
+    return search(board, ownID, MAX_DEPTH);
+}
+
+/*
+ *Description: Sets the number of moves searched ahead without a deadline, clamped to 1 to MAX_DEPTH
+ *Precondition: N/A
+ *Postcondition: The depth is updated
+ */
+void AlphaBetaSearch::setDepth(int newDepth)
+{
+    depth = min(max(newDepth, 1), static_cast<int>(MAX_DEPTH));
+}
+
+/*
+ *Description: Sets the number of threads searching each move; 0 selects one per hardware thread
+ *Precondition: The count is non-negative
+ *Postcondition: The thread count is updated
+ */
+void AlphaBetaSearch::setThreads(int count)
+{
+    threads = count;
+}
+
+/*
+ *Description: Allocates the transposition table and the helpers of the set thread count ahead of a search
+ *Precondition: N/A
+ *Postcondition: The next search allocates neither unless the thread count grows or the board changes
+ */
+void AlphaBetaSearch::reserve()
+{
+    table->allocate();
+    int threadCount = threads > 0 ? threads : static_cast<int>(thread::hardware_concurrency());
+    while(static_cast<int>(helpers.size()) < threadCount - 1)
+    {
+        helpers.push_back(unique_ptr<AlphaBetaSearch>(new AlphaBetaSearch()));
+        helpers.back()->table = table;
+        helpers.back()->helperIndex = static_cast<int>(helpers.size());
+        helpers.back()->stopSignal = &stopping;
+    }
+}
+
+/*
+ *Description: Forgets the transposition table and the move history built up by earlier searches
+ *Precondition: No search is running
+ *Postcondition: The next search depends only on its position and the settings
+ */
+void AlphaBetaSearch::newGame()
+{
+    //The helpers share the table
+    table->clear();
+    clearHistory();
+    for(size_t t = 0; t < helpers.size(); t++)
+        helpers[t]->clearHistory();
+}
+
+/*
+ *Description: Sets the network that evaluates the positions of boards of its size(0 for none) in searches
+ *             without a deadline of at most NETWORK_MAX_DEPTH
+ *Precondition: The network outlives the search and is not changed while it searches
+ *Postcondition: The network is used from the next search on; the transposition table is cleared
+ */
+void AlphaBetaSearch::setNetwork(const NTupleNetwork* newNetwork)
+{
+    //Stored scores were evaluated the old way
+    if(newNetwork != network)
+        table->clear();
+    network = newNetwork;
+}
+
+/*
+ *Description: Accessor function that returns the network set, or 0
+ *Precondition: N/A
+ *Postcondition: A pointer is returned
+ */
+const NTupleNetwork* AlphaBetaSearch::getNetwork() const
+{
+    return network;
+}
+
+/*
+ *Description: Accessor functions for the depth and the statistics of the last search
+ *Precondition: N/A
+ *Postcondition: The requested value is returned
+ */
+int AlphaBetaSearch::getDepth() const
+{
+    return depth;
+}
+
+int AlphaBetaSearch::getThreads() const
+{
+    return threads;
+}
+
+int AlphaBetaSearch::getCompletedDepth() const
+{
+    return completedDepth;
+}
+
+long AlphaBetaSearch::getNodeCount() const
+{
+    return nodes;
+}
+
+long AlphaBetaSearch::getLinesEvaluated() const
+{
+    return linesEvaluated;
+}
+
+long AlphaBetaSearch::getTableHits() const
+{
+    return tableHits;
+}
+
+long AlphaBetaSearch::getTableMisses() const
+{
+    return tableMisses;
+}
+
+int AlphaBetaSearch::getScore() const
+{
+    return score;
+}
+
+/*
+ *Description: Runs the iterations from depth 1 to the supplied depth, or until 'deadline' if 'timed'
+ *Precondition: The game is not over
+ *Postcondition: A vacant Location is returned
+ */
+Location AlphaBetaSearch::search(const GameBoard& board, string ownID, int maxDepth)
+{
+    prepare(board.getGeometry());
+    load(board, ownID);
+    timedOut = false;
+    completedDepth = 0;
+    nodes = 0;
+    linesEvaluated = 0;
+    tableHits = 0;
+    tableMisses = 0;
+    score = 0;
+    for(int s = 0; s < 2; s++)
+        for(int cell = 0; cell < CellMask::CAPACITY; cell++)
+            history[s][cell] /= 8;
+    
+    //A win is played at once; an opponent's threat must be blocked
+    CellMask wins = findWins(side);
+    if(wins.any())
+    {
+        score = WIN_SCORE;
+        return geometry->getLocation(wins.lowest());
+    }
+    CellMask threats = findWins(side ^ 1);
+    int moves[CellMask::CAPACITY];
+    int count = orderMoves(threats.any() ? threats : getCandidates(), moves, -1);
+    if(count == 1)
+        return geometry->getLocation(moves[0]);
+    
+    //Helpers search the root moves from a different starting point so the threads do not all
+    //wait on the same first move
+    if(helperIndex > 0 && count > 2)
+        rotate(moves + 1, moves + 1 + helperIndex % (count - 1), moves + count);
+    
+    int threadCount = threads > 0 ? threads : static_cast<int>(thread::hardware_concurrency());
+    vector<thread> workers;
+    vector<Location> helperMoves;
+    if(helperIndex == 0)
+    {
+        reserve();
+        if(threadCount > 1)
+        {
+            stopping.store(false, memory_order_relaxed);
+            helperMoves.resize(threadCount - 1);
+            for(int t = 0; t < threadCount - 1; t++)
+            {
+                helpers[t]->timed = timed;
+                helpers[t]->deadline = deadline;
+                helpers[t]->network = network;
+                helpers[t]->depth = depth;
+                workers.push_back(thread([this, &board, &helperMoves, ownID, t]()
+                                         { helperMoves[t] = helpers[t]->search(board, ownID, MAX_DEPTH); }));
+            }
+        }
+    }
+    
+    //Odd helpers start one depth deeper, so the threads spread over two depths at a time
+    int emptyCount = boardMask.without(occupied).count();
+    for(int iteration = 1 + helperIndex % 2; iteration <= maxDepth; iteration++)
+    {
+        if(timed && chrono::steady_clock::now() >= deadline)
+            break;
+        
+        int alpha = -WIN_SCORE - 1;
+        int best = -1;
+        for(int i = 0; i < count; i++)
+        {
+            play(moves[i]);
+            int value = -negamax(iteration - 1, 1, -WIN_SCORE - 1, -alpha);
+            undo(moves[i]);
+            if(timedOut)
+                break;
+            if(value > alpha)
+            {
+                alpha = value;
+                best = i;
+            }
+        }
+        
+        //The next iteration searches this iteration's best move first. An iteration cut short also
+        //searched the previous best move first, so a move that beat it is better still.
+        if(best >= 0)
+        {
+            int chosen = moves[best];
+            for(int i = best; i > 0; i--)
+                moves[i] = moves[i - 1];
+            moves[0] = chosen;
+            score = alpha;
+        }
+        if(timedOut)
+            break;
+        completedDepth = iteration;
+        
+        //A forced result does not change with more depth, nor does a search that reaches the end of the game
+        if(score > MATE_BOUND || score < -MATE_BOUND || iteration >= emptyCount)
+            break;
+    }
+    Location chosen = geometry->getLocation(moves[0]);
+    
+    //The helpers stop once this thread is done; one that finished a deeper iteration has the better move
+    if(!workers.empty())
+    {
+        stopping.store(true, memory_order_relaxed);
+        for(size_t t = 0; t < workers.size(); t++)
+        {
+            workers[t].join();
+            nodes += helpers[t]->nodes;
+            linesEvaluated += helpers[t]->linesEvaluated;
+            tableHits += helpers[t]->tableHits;
+            tableMisses += helpers[t]->tableMisses;
+            if(helpers[t]->completedDepth > completedDepth)
+            {
+                completedDepth = helpers[t]->completedDepth;
+                score = helpers[t]->score;
+                chosen = helperMoves[t];
+            }
+        }
+    }
+    return chosen;
+}
+
+/*
+ *Description: Copies the winning lines and the lines through each cell of the supplied geometry
+ *Precondition: N/A
+ *Postcondition: The tables match the geometry; nothing is done if they already did
+ */
+void AlphaBetaSearch::prepare(const BoardGeometry& boardGeometry)
+{
+    if(geometry == &boardGeometry)
+        return;
+    
+    //The stored positions and move statistics belong to the previous board; helpers share the table of
+    //the search that started them, which has already cleared it
+    if(geometry && helperIndex == 0)
+        table->clear();
+    clearHistory();
+    
+    geometry = &boardGeometry;
+    boardMask = geometry->getFullMask();
+    winLength = geometry->getWinLength();
+    int cellCount = geometry->getCellCount();
+    
+    lineMasks.resize(geometry->getLineCount());
+    for(int line = 0; line < geometry->getLineCount(); line++)
+        lineMasks[line] = geometry->getLine(line);
+    for(int s = 0; s < 2; s++)
+    {
+        lineCounts[s].assign(lineMasks.size(), 0);
+        threatSlots[s].assign(lineMasks.size(), -1);
+        threatLines[s].clear();
+    }
+    
+    //The power of a cell on a line is its digit's place in the line's network entry
+    cellLineStart.assign(1, 0);
+    cellLines.clear();
+    cellLinePowers.clear();
+    for(int cell = 0; cell < cellCount; cell++)
+    {
+        int count;
+        const int* lines = geometry->getCellLines(cell, count);
+        cellLines.insert(cellLines.end(), lines, lines + count);
+        for(int i = 0; i < count; i++)
+        {
+            const int* cells = geometry->getLineCells(lines[i]);
+            int power = 1;
+            for(int position = 0; position < winLength && cells[position] != cell; position++)
+                power *= 3;
+            cellLinePowers.push_back(power);
+        }
+        cellLineStart.push_back(static_cast<int>(cellLines.size()));
+    }
+    lineEntries[0].assign(lineMasks.size(), 0);
+    lineEntries[1].assign(lineMasks.size(), 0);
+    
+    //Two steps in any direction, through the layers as well
+    neighborhoods.clear();
+    if(cellCount > SMALL_BOARD_CELLS)
+    {
+        int height = geometry->getHeight();
+        neighborhoods.resize(cellCount);
+        for(int cell = 0; cell < cellCount; cell++)
+        {
+            Location from = geometry->getLocation(cell);
+            for(int other = 0; other < cellCount; other++)
+            {
+                Location to = geometry->getLocation(other);
+                if(abs(to.x / height - from.x / height) <= 2 && abs(to.x % height - from.x % height) <= 2
+                   && abs(to.y - from.y) <= 2)
+                    neighborhoods[cell].set(other);
+            }
+        }
+    }
+    
+    weights[0] = 0;
+    for(int stonesOnLine = 1; stonesOnLine <= BoardGeometry::MAX_SIDE; stonesOnLine++)
+        weights[stonesOnLine] = min(1 << min(3 * (stonesOnLine - 1), 20), MAX_WEIGHT);
+}
+
+/*
+ *Description: Sets the cutoff count of every move of both sides to 0
+ *Precondition: N/A
+ *Postcondition: The move ordering no longer depends on earlier searches
+ */
+void AlphaBetaSearch::clearHistory()
+{
+    for(int s = 0; s < 2; s++)
+        for(int cell = 0; cell < CellMask::CAPACITY; cell++)
+            history[s][cell] = 0;
+}
+
+/*
+ *Description: Sets up the search state for the supplied board with the supplied ID to move
+ *Precondition: prepare has been called for the board's geometry
+ *Postcondition: The search state holds the board's position
+ */
+void AlphaBetaSearch::load(const GameBoard& board, string ownID)
+{
+    stones[0] = CellMask();
+    stones[1] = CellMask();
+    occupied = CellMask();
+    nearby = CellMask();
+    nearCounts.assign(neighborhoods.empty() ? 0 : geometry->getCellCount(), 0);
+    for(int s = 0; s < 2; s++)
+    {
+        fill(lineCounts[s].begin(), lineCounts[s].end(), 0);
+        fill(threatSlots[s].begin(), threatSlots[s].end(), -1);
+        threatLines[s].clear();
+    }
+    evaluation = 0;
+    hash = 0;
+    side = 0;
+    
+    //The network evaluates an empty board by the empty entry of every line. It only plays better than the
+    //line weights in shallow searches, so deeper and timed searches keep the line weights.
+    networkWeights = 0;
+    if(network && network->matches(*geometry) && !timed && depth <= NETWORK_MAX_DEPTH)
+    {
+        networkWeights = network->getWeights();
+        networkTableSize = network->getTableSize();
+        for(int s = 0; s < 2; s++)
+        {
+            fill(lineEntries[s].begin(), lineEntries[s].end(), 0);
+            networkValues[s] = 0;
+            for(size_t line = 0; line < lineMasks.size(); line++)
+                networkValues[s] += networkWeights[line * networkTableSize];
+        }
+    }
+    
+    //Every empty line is one stone short of a win when a single stone wins
+    if(winLength == 1)
+        for(int s = 0; s < 2; s++)
+            for(size_t line = 0; line < lineMasks.size(); line++)
+            {
+                threatSlots[s][line] = static_cast<int>(threatLines[s].size());
+                threatLines[s].push_back(static_cast<int>(line));
+            }
+    
+    //Replaying the stones in any order builds the same counts, lists and hash as the game did
+    CellMask boardStones[2] = { board.getMask(0), board.getMask(1) };
+    for(int s = 0; s < 2; s++)
+        for(CellMask rest = boardStones[s]; rest.any(); )
+        {
+            side = s;
+            play(rest.popLowest());
+        }
+    side = (ownID == "O") ? 1 : 0;
+    hash = 0;
+    for(int s = 0; s < 2; s++)
+        for(CellMask rest = boardStones[s]; rest.any(); )
+            hash ^= Zobrist::getKey(s, rest.popLowest());
+    if(side)
+        hash ^= Zobrist::getSideKey();
+}
+
+/*
+ *Description: Places a stone of the side to move on the supplied cell
+ *Precondition: The cell is vacant and completes no line
+ *Postcondition: The side to move changes
+ */
+void AlphaBetaSearch::play(int cell)
+{
+    addStone(side, cell, 1);
+    stones[side].set(cell);
+    occupied.set(cell);
+    if(!neighborhoods.empty())
+        for(CellMask near = neighborhoods[cell]; near.any(); )
+        {
+            int other = near.popLowest();
+            if(nearCounts[other]++ == 0)
+                nearby.set(other);
+        }
+    hash ^= Zobrist::getKey(side, cell) ^ Zobrist::getSideKey();
+    side ^= 1;
+}
+
+/*
+ *Description: Takes back the stone of the side that moved last from the supplied cell
+ *Precondition: The cell was the last one played
+ *Postcondition: The side to move changes
+ */
+void AlphaBetaSearch::undo(int cell)
+{
+    side ^= 1;
+    addStone(side, cell, -1);
+    stones[side].clear(cell);
+    occupied.clear(cell);
+    if(!neighborhoods.empty())
+        for(CellMask near = neighborhoods[cell]; near.any(); )
+        {
+            int other = near.popLowest();
+            if(--nearCounts[other] == 0)
+                nearby.clear(other);
+        }
+    hash ^= Zobrist::getKey(side, cell) ^ Zobrist::getSideKey();
+}
+
+/*
+ *Description: Adds stones of the supplied side to every line through the supplied cell
+ *Precondition: The counts stay between 0 and the win length
+ *Postcondition: The line state matches the new counts
+ */
+void AlphaBetaSearch::addStone(int who, int cell, int delta)
+{
+    linesEvaluated += cellLineStart[cell + 1] - cellLineStart[cell];
+    for(int i = cellLineStart[cell]; i < cellLineStart[cell + 1]; i++)
+    {
+        int line = cellLines[i];
+        if(networkWeights)
+        {
+            lineCounts[who][line] = static_cast<unsigned char>(lineCounts[who][line] + delta);
+            
+            //The stone is digit 1 for its own side and 2 for the other
+            const short* lineWeights = networkWeights + static_cast<size_t>(line) * networkTableSize;
+            for(int s = 0; s < 2; s++)
+            {
+                int& entry = lineEntries[s][line];
+                int before = lineWeights[entry];
+                entry += delta * (s == who ? 1 : 2) * cellLinePowers[i];
+                networkValues[s] += lineWeights[entry] - before;
+            }
+        }
+        else
+        {
+            int before = lineValue(line);
+            lineCounts[who][line] = static_cast<unsigned char>(lineCounts[who][line] + delta);
+            evaluation += lineValue(line) - before;
+        }
+        
+        //Either side's threat on this line may have appeared or disappeared
+        for(int s = 0; s < 2; s++)
+        {
+            bool threat = lineCounts[s][line] == winLength - 1 && lineCounts[s ^ 1][line] == 0;
+            int& slot = threatSlots[s][line];
+            if(threat && slot < 0)
+            {
+                slot = static_cast<int>(threatLines[s].size());
+                threatLines[s].push_back(line);
+            }
+            else if(!threat && slot >= 0)
+            {
+                int last = threatLines[s].back();
+                threatLines[s][slot] = last;
+                threatSlots[s][last] = slot;
+                threatLines[s].pop_back();
+                slot = -1;
+            }
+        }
+    }
+}
+
+/*
+ *Description: Returns the vacant cells that would complete a line for the supplied side
+ *Precondition: N/A
+ *Postcondition: A mask of cells is returned
+ */
+CellMask AlphaBetaSearch::findWins(int who) const
+{
+    CellMask wins;
+    for(size_t i = 0; i < threatLines[who].size(); i++)
+        wins |= lineMasks[threatLines[who][i]];
+    return wins.without(occupied);
+}
+
+/*
+ *Description: Returns the vacant cells worth searching
+ *Precondition: N/A
+ *Postcondition: A non-empty mask is returned unless the board is full
+ */
+CellMask AlphaBetaSearch::getCandidates() const
+{
+    CellMask empty = boardMask.without(occupied);
+    if(neighborhoods.empty())
+        return empty;
+    
+    if(occupied.none())
+    {
+        CellMask center;
+        center.set(geometry->getCell(geometry->getLayerCount() / 2 * geometry->getHeight() + geometry->getHeight() / 2,
+                                     geometry->getWidth() / 2));
+        return center;
+    }
+    CellMask near = nearby.without(occupied);
+    return near.any() ? near : empty;
+}
+
+/*
+ *Description: Looks at the clock every CLOCK_INTERVAL positions of a timed search
+ *Precondition: N/A
+ *Postcondition: Returns true, and sets 'timedOut', once the deadline has passed
+ */
+bool AlphaBetaSearch::isOutOfTime()
+{
+    if(!timedOut && nodes % CLOCK_INTERVAL == 0
+       && ((stopSignal && stopSignal->load(memory_order_relaxed)) || (timed && chrono::steady_clock::now() >= deadline)))
+        timedOut = true;
+    return timedOut;
+}
+
+/*
+ *Description: Returns the score for the side to move searched to the supplied remaining depth
+ *Precondition: alpha < beta and neither side has completed a line
+ *Postcondition: The position is unchanged; once 'timedOut' is set the result is meaningless
+ */
+int AlphaBetaSearch::negamax(int remaining, int ply, int alpha, int beta)
+{
+    nodes++;
+    if(isOutOfTime())
+        return 0;
+    if(findWins(side).any())
+        return WIN_SCORE - ply;
+    if(occupied == boardMask)
+        return 0;
+    
+    //One threat of the opponent leaves a single move, which is searched without using up depth;
+    //two can not both be blocked
+    CellMask threats = findWins(side ^ 1);
+    int threatCount = threats.count();
+    if(threatCount > 1)
+        return -(WIN_SCORE - ply - 1);
+    if(threatCount == 0 && remaining <= 0)
+    {
+        //The network values the position for the side that moved last
+        int value = networkWeights ? -networkValues[side ^ 1] : side ? -evaluation : evaluation;
+        return max(-MATE_BOUND / 2, min(value, MATE_BOUND / 2));
+    }
+    
+    TranspositionEntry entry;
+    int preferred = -1;
+    if(!table->probe(hash, entry))
+        tableMisses++;
+    else
+    {
+        tableHits++;
+        preferred = entry.bestCell;
+        int stored = entry.score;
+        if(stored > MATE_BOUND)
+            stored -= ply;
+        else if(stored < -MATE_BOUND)
+            stored += ply;
+        
+        if(entry.depth >= remaining
+           && (entry.bound == TranspositionTable::EXACT
+               || (entry.bound == TranspositionTable::LOWER && stored >= beta)
+               || (entry.bound == TranspositionTable::UPPER && stored <= alpha)))
+            return stored;
+    }
+    
+    int moves[CellMask::CAPACITY];
+    int count = orderMoves(threatCount ? threats : getCandidates(), moves, preferred);
+    int childDepth = threatCount ? remaining : remaining - 1;
+    int originalAlpha = alpha;
+    int best = -WIN_SCORE - 1;
+    int bestMove = moves[0];
+    for(int i = 0; i < count; i++)
+    {
+        play(moves[i]);
+        int value = -negamax(childDepth, ply + 1, -beta, -alpha);
+        undo(moves[i]);
+        if(timedOut)
+            return 0;
+        
+        if(value > best)
+        {
+            best = value;
+            bestMove = moves[i];
+        }
+        if(value > alpha)
+            alpha = value;
+        if(alpha >= beta)
+        {
+            history[side][moves[i]] += remaining * remaining;
+            break;
+        }
+    }
+    
+    int stored = best;
+    if(stored > MATE_BOUND)
+        stored += ply;
+    else if(stored < -MATE_BOUND)
+        stored -= ply;
+    TranspositionTable::Bound bound = best <= originalAlpha ? TranspositionTable::UPPER
+                                    : best >= beta ? TranspositionTable::LOWER : TranspositionTable::EXACT;
+    table->store(hash, stored, max(remaining, 0), bound, bestMove);
+    return best;
+}
+
+/*
+ *Description: Lists the cells of the supplied mask in search order: the preferred cell first, then the
+ *             cells on the most lines still open to either side
+ *Precondition: The array has room for CellMask::CAPACITY cells
+ *Postcondition: Returns the number of cells
+ */
+int AlphaBetaSearch::orderMoves(CellMask cells, int* moves, int preferred) const
+{
+    int keys[CellMask::CAPACITY];
+    int count = 0;
+    while(cells.any())
+    {
+        int cell = cells.popLowest();
+        int key = history[side][cell];
+        if(cell == preferred)
+            key = 1 << 30;
+        else
+            for(int i = cellLineStart[cell]; i < cellLineStart[cell + 1]; i++)
+            {
+                //Extending an own line or blocking one of the opponent's
+                int line = cellLines[i];
+                int own = lineCounts[side][line];
+                int other = lineCounts[side ^ 1][line];
+                if(other == 0)
+                    key += weights[own + 1];
+                if(own == 0)
+                    key += weights[other + 1];
+            }
+        
+        //Insertion sort, highest key first
+        int j = count++;
+        for(; j > 0 && keys[j - 1] < key; j--)
+        {
+            keys[j] = keys[j - 1];
+            moves[j] = moves[j - 1];
+        }
+        keys[j] = key;
+        moves[j] = cell;
+    }
+    return count;
+}
+
+/*
+ *Description: Returns the evaluation of one line from 'X's point of view
+ *Precondition: 0 <= line < number of lines
+ *Postcondition: 0 is returned for a line holding stones of both sides or none
+ */
+int AlphaBetaSearch::lineValue(int line) const
+{
+    int x = lineCounts[0][line];
+    int o = lineCounts[1][line];
+    if(o == 0)
+        return weights[x];
+    if(x == 0)
+        return -weights[o];
+    return 0;
+}
@@ -0,0 +1,314 @@
+/************************************************************************************
+ Title:         AlphaBetaSearch.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   An alpha-beta search for boards of any size, such as the 4x4x4 Qubic
+                cube. Each side's stones are one CellMask and every winning line is a
+                CellMask, copied from the BoardGeometry together with the lines through
+                each cell; boards of up to 64 cells only ever use the first word. The
+                number of stones of each side on every line is kept up to date as moves
+                are made and taken back, so a move touches only the lines through its
+                cell(7 of the 76 on the cube), and so do the static evaluation and the
+                lists of lines one stone short of a win, which are updated with it.
+                With an NTupleNetwork the static evaluation is the network's instead: the
+                entries of every line, as seen by either side having moved last, are
+                updated with its counts, and each side's sum changes by the difference of
+                the two weights its entry selects.
+ 
+ Purpose:       Provides a searching opponent for boards too large for the perfect-play
+                searches of the 3x3 board. At every position a winning move ends the
+                search, a single threat of the opponent forces the block(without using up
+                depth) and two threats lose. On boards of more than 64 cells only the
+                cells within two steps of a stone are searched. With several threads the
+                search is a lazy SMP: every thread searches the same root on its own, in its
+                own order and partly one depth deeper, and they share one lockless
+                transposition table, so each thread's results cut the others' searches short.
+ 
+ Usage:         AlphaBetaSearch search; search.setDepth(4);
+                Location move = search.chooseMove(board, "X");
+                Location move = search.chooseMove(board, "X", deadline);
+                The second form deepens one move at a time until the deadline and
+                returns the best move of the deepest search that finished(or the best
+                so far of the one cut short), so it always answers on time.
+                search.setThreads(4); //before either form
+                search.setNetwork(&network); //evaluates shallow searches of its board with it
+                search.getCompletedDepth(); search.getNodeCount(); search.getScore();
+                Scores are from the point of view of the side to move; a forced win
+                scores WIN_SCORE minus the number of moves to it.
+ 
+ Build with:    Compile with main.cpp.
+ 
+ Modifications: Works on boards of any size: the masks are CellMasks, the threat lines are
+                kept in lists and large boards only search near the stones.
+                Added the search with a deadline.
+                Added the parallel search with a shared transposition table.
+                Counts the lines updated and the table hits and misses of each search.
+                Evaluates with an NTupleNetwork when one is set for the board.
+                The table and helpers can be allocated before a timed search.
+                newGame forgets the table and move history of earlier games.
+                The network is limited to shallow searches without a deadline.
+ ***********************************************************************************/
+
+#ifndef TicTacToe_AlphaBetaSearch_h
+#define TicTacToe_AlphaBetaSearch_h
+
+#include "BoardGeometry.h"
+#include "CellMask.h"
+#include "GameBoard.h"
+#include "Location.h"
+#include "NTupleNetwork.h"
+#include "SharedTranspositionTable.h"
+#include "TranspositionTable.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+class AlphaBetaSearch {
+
+public:
+    AlphaBetaSearch();
+    /*
+     *Description: Constructor that selects DEFAULT_DEPTH; the line tables are built for the first board searched
+     *Precondition: N/A
+     *Postcondition: The search is ready; no memory has been allocated
+     */
+    
+    Location chooseMove(const GameBoard&, string);
+    /*
+     *Description: Returns the best move found for the supplied ID('X' or 'O') by searching to the set depth,
+     *             one iteration deeper at a time so that each iteration is ordered by the one before
+     *Precondition: The game is not over
+     *Postcondition: A vacant Location is returned
+     */
+    
+    Location chooseMove(const GameBoard&, string, chrono::steady_clock::time_point);
+    /*
+     *Description: Returns the best move found for the supplied ID by searching one iteration deeper at a
+     *             time, up to MAX_DEPTH, until the supplied deadline. An iteration that runs out of time
+     *             stops within a few hundred positions and contributes the best move it had finished.
+     *Precondition: The game is not over
+     *Postcondition: A vacant Location is returned shortly after the deadline at the latest(immediately
+     *               if it has passed)
+     */
+    
+    void setDepth(int);
+    /*
+     *Description: Sets the number of moves searched ahead without a deadline, not counting forced blocks;
+     *             values outside 1 to MAX_DEPTH are clamped
+     *Precondition: N/A
+     *Postcondition: The depth is updated
+     */
+    
+    void setThreads(int);
+    /*
+     *Description: Sets the number of threads searching each move; 0 selects one per hardware thread
+     *Precondition: The count is non-negative
+     *Postcondition: The thread count is updated
+     */
+    
+    void reserve();
+    /*
+     *Description: Allocates the transposition table and the helpers of the set thread count ahead of a search,
+     *             so that a search with a deadline does not spend its time on them
+     *Precondition: N/A
+     *Postcondition: The next search allocates neither unless the thread count grows or the board changes
+     */
+    
+    void newGame();
+    /*
+     *Description: Forgets the transposition table and the move history built up by earlier searches, which
+     *             would otherwise make the moves of a game depend on the games searched before it
+     *Precondition: No search is running
+     *Postcondition: The next search depends only on its position and the settings
+     */
+    
+    void setNetwork(const NTupleNetwork*);
+    /*
+     *Description: Sets the network that evaluates the positions of boards of its size(0 for none) in
+     *             searches without a deadline of at most NETWORK_MAX_DEPTH; other boards and searches keep
+     *             the line weights
+     *Precondition: The network outlives the search and is not changed while it searches
+     *Postcondition: The network is used from the next search on; the transposition table is cleared
+     */
+    
+    const NTupleNetwork* getNetwork() const;
+    /*
+     *Description: Accessor function that returns the network set, or 0
+     *Precondition: N/A
+     *Postcondition: A pointer is returned
+     */
+    
+    int getDepth() const;
+    int getThreads() const;
+    int getCompletedDepth() const;
+    long getNodeCount() const;
+    long getLinesEvaluated() const;
+    long getTableHits() const;
+    long getTableMisses() const;
+    int getScore() const;
+    /*
+     *Description: Accessor functions for the depth and thread count, and for the deepest iteration
+     *             finished by the last search(by any thread), the number of positions its threads
+     *             visited, the line counts they updated, their transposition table probes that found
+     *             or missed their position, and the score of the move it chose
+     *Precondition: N/A
+     *Postcondition: The requested value is returned
+     */
+    
+    static const int DEFAULT_DEPTH = 4; //Moves searched ahead unless setDepth is called
+    static const int MAX_DEPTH = 32; //Deepest supported search
+    static const int WIN_SCORE = 30000; //Score of a win on the next move; later wins score less
+    static const int TABLE_BITS = 18; //The transposition table has 2^TABLE_BITS slots
+    static const int NETWORK_MAX_DEPTH = 2; //Deepest search a network evaluates; deeper it loses to the line weights
+    static const int CLOCK_INTERVAL = 32; //Positions visited between looks at the clock
+
+private:
+    Location search(const GameBoard&, string, int);
+    /*
+     *Description: Runs the iterations from depth 1 to the supplied depth, or until 'deadline' if 'timed'.
+     *             With several threads it first starts the helpers, which search until it is done, and
+     *             then returns the move of whichever thread finished the deepest iteration.
+     *Precondition: The game is not over
+     *Postcondition: A vacant Location is returned; the helpers have stopped
+     */
+    
+    void prepare(const BoardGeometry&);
+    /*
+     *Description: Copies the winning lines and the lines through each cell of the supplied geometry, and on
+     *             boards of more than 64 cells the cells within two steps of each cell
+     *Precondition: N/A
+     *Postcondition: The tables match the geometry; nothing is done if they already did
+     */
+    
+    void clearHistory();
+    /*
+     *Description: Sets the cutoff count of every move of both sides to 0
+     *Precondition: N/A
+     *Postcondition: The move ordering no longer depends on earlier searches
+     */
+    
+    void load(const GameBoard&, string);
+    /*
+     *Description: Sets up the line counts, threat lists, nearby cells, evaluation and hash of the supplied
+     *             board with the supplied ID to move
+     *Precondition: prepare has been called for the board's geometry
+     *Postcondition: The search state holds the board's position
+     */
+    
+    void play(int);
+    void undo(int);
+    /*
+     *Description: Places or takes back a stone of the side to move(for undo, the side that moved last)
+     *             on the supplied cell, updating the line counts, threat lists, nearby cells, the
+     *             evaluation and the hash
+     *Precondition: play: the cell is vacant and completes no line. undo: the cell was the last one played
+     *Postcondition: The side to move changes
+     */
+    
+    void addStone(int, int, int);
+    /*
+     *Description: Adds the supplied number of stones(1 or -1) of the supplied side to every line through
+     *             the supplied cell, keeping the evaluation and the threat lists up to date
+     *Precondition: The counts stay between 0 and the win length
+     *Postcondition: The line state matches the new counts
+     */
+    
+    CellMask findWins(int) const;
+    /*
+     *Description: Returns the vacant cells that would complete a line for the supplied side
+     *Precondition: N/A
+     *Postcondition: A mask of cells is returned
+     */
+    
+    int negamax(int, int, int, int);
+    /*
+     *Description: Returns the score for the side to move searched to the supplied remaining depth at the
+     *             supplied distance from the root, within the window (alpha, beta)
+     *Precondition: alpha < beta and neither side has completed a line
+     *Postcondition: The position is unchanged; once 'timedOut' is set the result is meaningless
+     */
+    
+    CellMask getCandidates() const;
+    /*
+     *Description: Returns the vacant cells worth searching: all of them on boards of up to 64 cells, else
+     *             those within two steps of a stone(the center of an empty board)
+     *Precondition: N/A
+     *Postcondition: A non-empty mask is returned unless the board is full
+     */
+    
+    int orderMoves(CellMask, int*, int) const;
+    /*
+     *Description: Lists the cells of the supplied mask in search order: the supplied preferred cell first,
+     *             then the cells on the most lines still open to either side
+     *Precondition: The array has room for CellMask::CAPACITY cells
+     *Postcondition: Returns the number of cells
+     */
+    
+    int lineValue(int) const;
+    /*
+     *Description: Returns the evaluation of one line from 'X's point of view
+     *Precondition: 0 <= line < number of lines
+     *Postcondition: 0 is returned for a line holding stones of both sides or none
+     */
+    
+    bool isOutOfTime();
+    /*
+     *Description: Looks at the clock(and, in a helper, at 'stopSignal') every CLOCK_INTERVAL positions
+     *Precondition: N/A
+     *Postcondition: Returns true, and sets 'timedOut', once the deadline has passed or the helper is stopped
+     */
+    
+    const BoardGeometry* geometry; //Geometry the tables were built for, or 0
+    vector<CellMask> lineMasks; //Cells of each winning line
+    vector<int> cellLineStart; //Offset of each cell's first entry in 'cellLines'; one extra entry at the end
+    vector<int> cellLines; //Lines through each cell, cell after cell
+    vector<CellMask> neighborhoods; //Cells within two steps of each cell; empty on boards of up to 64 cells
+    vector<unsigned char> lineCounts[2]; //Stones of 'X' and 'O' on each line
+    vector<int> threatLines[2]; //Lines one stone short of a win for 'X' and 'O', with no stone of the other
+    vector<int> threatSlots[2]; //Position of each line in threatLines, or -1
+    vector<unsigned char> nearCounts; //Stones within two steps of each cell(boards of more than 64 cells)
+    int weights[BoardGeometry::MAX_SIDE + 1]; //Value of a line holding that many stones of one side only
+    vector<int> cellLinePowers; //3 to the power of the cell's position on each line of 'cellLines'
+    const NTupleNetwork* network; //Evaluation of boards of its size, or 0
+    const short* networkWeights; //Weights of 'network' while it evaluates the current board, else 0
+    int networkTableSize; //Weights per line of 'network'
+    vector<int> lineEntries[2]; //Network entry of each line with 'X' and with 'O' as the side that moved last
+    int networkValues[2]; //Sum of the weights selected by lineEntries[0] and lineEntries[1]
+    int winLength; //Stones in a row needed to win
+    
+    CellMask boardMask; //Every cell of the board
+    CellMask stones[2]; //Cells of 'X' and 'O'
+    CellMask occupied; //Cells of either side
+    CellMask nearby; //Vacant or not, the cells within two steps of a stone(boards of more than 64 cells)
+    uint64_t hash; //Zobrist hash of the stones and the side to move
+    int side; //Side to move, 0 for 'X'
+    int evaluation; //Sum of lineValue over every line
+    
+    int depth; //Moves searched ahead without a deadline
+    bool timed; //Whether the current search stops at 'deadline'
+    bool timedOut; //Set once a timed search has passed its deadline
+    chrono::steady_clock::time_point deadline; //End of the current timed search
+    int completedDepth; //Deepest iteration finished by the last search
+    long nodes; //Positions visited by the last search
+    long linesEvaluated; //Line counts updated by the last search
+    long tableHits; //Transposition table probes of the last search that found their position
+    long tableMisses; //Probes that did not
+    int score; //Score of the last chosen move
+    int history[2][CellMask::CAPACITY]; //Cutoffs caused by each move, weighted by depth
+    int threads; //Threads searching each move, or 0 for one per hardware thread
+    int helperIndex; //0 for a search of its own, else the helper's number
+    const atomic<bool>* stopSignal; //Set when a helper should stop; 0 unless this is a helper
+    atomic<bool> stopping; //The helpers' stop signal
+    vector<unique_ptr<AlphaBetaSearch> > helpers; //Searches run by the other threads; created on first use
+    SharedTranspositionTable ownTable; //Results of earlier searches
+    SharedTranspositionTable* table; //'ownTable', or in a helper the table of the search that started it
+};
+#endif
@@ -0,0 +1,232 @@
+/************************************************************************************
+ Title:         BatchEvaluator.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of BatchEvaluator.h. Each vector lane holds one 16-bit
+                mask; a line is complete in a lane when (mask & line) == line, which is
+                one AND and one compare per line for all lanes at once. The lane results
+                are combined into a Status with bitwise operations and packed to bytes.
+ 
+ Purpose:       Classifies large position sets without one branchy scan per board.
+ 
+ Usage:         BatchEvaluator::evaluate(xMasks, oMasks, status, count);
+ 
+ Build with:    Compile with main.cpp. Requires GCC or Clang for the x86 vector paths;
+                other compilers and processors use the scalar path.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#include "BatchEvaluator.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BATCH_EVALUATOR_X86 1
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+//Scalar path; also handles the positions left over after the last full vector
+void evaluateScalar(const uint16_t* xMasks, const uint16_t* oMasks, unsigned char* status,
+                    size_t begin, size_t end)
+{
+    for(size_t i = begin; i < end; i++)
+        status[i] = static_cast<unsigned char>(BatchEvaluator::classify(xMasks[i], oMasks[i]));
+}
+
+#if defined(BATCH_EVALUATOR_X86) && defined(__SSE2__)
+
+//8 positions per iteration
+size_t evaluateSSE2(const uint16_t* xMasks, const uint16_t* oMasks, unsigned char* status, size_t count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i allSet = _mm_cmpeq_epi16(zero, zero);
+    const __m128i full = _mm_set1_epi16(GameBoard::FULL_MASK);
+    const __m128i xWonCode = _mm_set1_epi16(BatchEvaluator::X_WON);
+    const __m128i oWonCode = _mm_set1_epi16(BatchEvaluator::O_WON);
+    const __m128i invalidCode = _mm_set1_epi16(BatchEvaluator::INVALID);
+    const __m128i tieCode = _mm_set1_epi16(BatchEvaluator::TIE);
+    
+    size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(xMasks + i));
+        __m128i o = _mm_loadu_si128(reinterpret_cast<const __m128i*>(oMasks + i));
+        
+        __m128i xWon = zero;
+        __m128i oWon = zero;
+        for(int line = 0; line < 8; line++)
+        {
+            __m128i mask = _mm_set1_epi16(GameBoard::LINE_MASKS[line]);
+            xWon = _mm_or_si128(xWon, _mm_cmpeq_epi16(_mm_and_si128(x, mask), mask));
+            oWon = _mm_or_si128(oWon, _mm_cmpeq_epi16(_mm_and_si128(o, mask), mask));
+        }
+        
+        __m128i filled = _mm_cmpeq_epi16(_mm_or_si128(x, o), full);
+        __m128i overlap = _mm_xor_si128(_mm_cmpeq_epi16(_mm_and_si128(x, o), zero), allSet);
+        __m128i invalid = _mm_or_si128(_mm_and_si128(xWon, oWon), overlap);
+        
+        __m128i result = _mm_or_si128(_mm_and_si128(xWon, xWonCode), _mm_and_si128(oWon, oWonCode));
+        result = _mm_or_si128(result, _mm_andnot_si128(_mm_or_si128(xWon, oWon), _mm_and_si128(filled, tieCode)));
+        result = _mm_or_si128(_mm_andnot_si128(invalid, result), _mm_and_si128(invalid, invalidCode));
+        
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(status + i), _mm_packus_epi16(result, zero));
+    }
+    return i;
+}
+
+#endif
+
+#ifdef BATCH_EVALUATOR_X86
+
+//16 positions per iteration
+__attribute__((target("avx2")))
+size_t evaluateAVX2(const uint16_t* xMasks, const uint16_t* oMasks, unsigned char* status, size_t count)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i allSet = _mm256_cmpeq_epi16(zero, zero);
+    const __m256i full = _mm256_set1_epi16(GameBoard::FULL_MASK);
+    const __m256i xWonCode = _mm256_set1_epi16(BatchEvaluator::X_WON);
+    const __m256i oWonCode = _mm256_set1_epi16(BatchEvaluator::O_WON);
+    const __m256i invalidCode = _mm256_set1_epi16(BatchEvaluator::INVALID);
+    const __m256i tieCode = _mm256_set1_epi16(BatchEvaluator::TIE);
+    
+    size_t i = 0;
+    for(; i + 16 <= count; i += 16)
+    {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(xMasks + i));
+        __m256i o = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(oMasks + i));
+        
+        __m256i xWon = zero;
+        __m256i oWon = zero;
+        for(int line = 0; line < 8; line++)
+        {
+            __m256i mask = _mm256_set1_epi16(GameBoard::LINE_MASKS[line]);
+            xWon = _mm256_or_si256(xWon, _mm256_cmpeq_epi16(_mm256_and_si256(x, mask), mask));
+            oWon = _mm256_or_si256(oWon, _mm256_cmpeq_epi16(_mm256_and_si256(o, mask), mask));
+        }
+        
+        __m256i filled = _mm256_cmpeq_epi16(_mm256_or_si256(x, o), full);
+        __m256i overlap = _mm256_xor_si256(_mm256_cmpeq_epi16(_mm256_and_si256(x, o), zero), allSet);
+        __m256i invalid = _mm256_or_si256(_mm256_and_si256(xWon, oWon), overlap);
+        
+        __m256i result = _mm256_or_si256(_mm256_and_si256(xWon, xWonCode), _mm256_and_si256(oWon, oWonCode));
+        result = _mm256_or_si256(result, _mm256_andnot_si256(_mm256_or_si256(xWon, oWon), _mm256_and_si256(filled, tieCode)));
+        result = _mm256_or_si256(_mm256_andnot_si256(invalid, result), _mm256_and_si256(invalid, invalidCode));
+        
+        //packus works within each 128-bit half, so pack the two halves explicitly
+        __m128i packed = _mm_packus_epi16(_mm256_castsi256_si128(result), _mm256_extracti128_si256(result, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(status + i), packed);
+    }
+    return i;
+}
+
+#endif
+
+}
+
+/*
+ *Description: Writes the Status of each position, using the best level the processor supports
+ *Precondition: The three arrays hold at least count entries; masks use only the low 9 bits
+ *Postcondition: status[i] holds the Status of position i
+ */
+void BatchEvaluator::evaluate(const uint16_t* xMasks, const uint16_t* oMasks, unsigned char* status, size_t count)
+{
+    evaluate(xMasks, oMasks, status, count, getBestLevel());
+}
+
+/*
+ *Description: Same as above using the supplied level, or the best supported one below it
+ *Precondition: Same as above
+ *Postcondition: Same as above
+ */
+void BatchEvaluator::evaluate(const uint16_t* xMasks, const uint16_t* oMasks, unsigned char* status,
+                              size_t count, Level level)
+{
+    if(level > getBestLevel())
+        level = getBestLevel();
+    
+    size_t done = 0;
+#ifdef BATCH_EVALUATOR_X86
+    if(level == AVX2)
+        done = evaluateAVX2(xMasks, oMasks, status, count);
+#endif
+#if defined(BATCH_EVALUATOR_X86) && defined(__SSE2__)
+    if(level >= SSE2)
+        done += evaluateSSE2(xMasks + done, oMasks + done, status + done, count - done);
+#endif
+    evaluateScalar(xMasks, oMasks, status, done, count);
+}
+
+/*
+ *Description: Writes the Status of every position of the batch
+ *Precondition: The batch's mask arrays have the same size
+ *Postcondition: The vector is resized to the batch size and holds the Status of each position
+ */
+void BatchEvaluator::evaluate(const PositionBatch& batch, vector<unsigned char>& status)
+{
+    status.resize(batch.size());
+    evaluate(batch.xMasks.data(), batch.oMasks.data(), status.data(), batch.size());
+}
+
+/*
+ *Description: Returns the widest instruction set the processor supports
+ *Precondition: N/A
+ *Postcondition: A Level is returned
+ */
+BatchEvaluator::Level BatchEvaluator::getBestLevel()
+{
+    Level best = SCALAR;
+#if defined(BATCH_EVALUATOR_X86) && defined(__SSE2__)
+    best = SSE2;
+#endif
+#ifdef BATCH_EVALUATOR_X86
+    if(__builtin_cpu_supports("avx2"))
+        best = AVX2;
+#endif
+    return best;
+}
+
+/*
+ *Description: Returns "scalar", "sse2" or "avx2"
+ *Precondition: N/A
+ *Postcondition: A string is returned
+ */
+string BatchEvaluator::getLevelName(Level level)
+{
+    switch(level)
+    {
+        case AVX2:
+            return "avx2";
+        case SSE2:
+            return "sse2";
+        default:
+            return "scalar";
+    }
+}
+
+/*
+ *Description: Returns the Status of a single position
+ *Precondition: The masks use only the low 9 bits
+ *Postcondition: A Status is returned
+ */
+BatchEvaluator::Status BatchEvaluator::classify(uint16_t x, uint16_t o)
+{
+    bool xWon = GameBoard::hasLine(x);
+    bool oWon = GameBoard::hasLine(o);
+    
+    if((x & o) || (xWon && oWon))
+        return INVALID;
+    if(xWon)
+        return X_WON;
+    if(oWon)
+        return O_WON;
+    if((x | o) == GameBoard::FULL_MASK)
+        return TIE;
+    return IN_PROGRESS;
+}
@@ -0,0 +1,109 @@
+/************************************************************************************
+ Title:         BatchEvaluator.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   Classifies many 3x3 positions at once. Positions are stored as two arrays
+                of 9-bit occupancy masks(structure of arrays) and each one is reported as
+                in progress, won by 'X', won by 'O', tied or invalid.
+ 
+ Purpose:       The batched equivalent of GameBoard::updateGameStatus for analytics jobs
+                that classify large position sets. The 8 winning lines are tested against
+                16 positions per AVX2 instruction, 8 per SSE2 instruction, or one position
+                at a time on other processors.
+ 
+ Usage:         PositionBatch batch; batch.add(board); ...
+                vector<unsigned char> status;
+                BatchEvaluator::evaluate(batch, status);
+                The instruction set is chosen once at run time; evaluate can also be asked
+                for a specific level to compare them.
+ 
+ Build with:    Compile with main.cpp. AVX2 code is compiled with a target attribute, so no
+                extra compiler flags are needed.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#ifndef TicTacToe_BatchEvaluator_h
+#define TicTacToe_BatchEvaluator_h
+
+#include "GameBoard.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+//Positions of the classic board as two parallel arrays of occupancy masks
+struct PositionBatch {
+    vector<uint16_t> xMasks; //Bit (3 * x + y) is set when 'X' holds Location (x,y)
+    vector<uint16_t> oMasks; //Bit (3 * x + y) is set when 'O' holds Location (x,y)
+    
+    void add(uint16_t x, uint16_t o) { xMasks.push_back(x); oMasks.push_back(o); }
+    void add(const GameBoard& board)
+    {
+        add(static_cast<uint16_t>(board.getMask(0).word(0)), static_cast<uint16_t>(board.getMask(1).word(0)));
+    }
+    size_t size() const { return xMasks.size(); }
+    void clear() { xMasks.clear(); oMasks.clear(); }
+};
+
+class BatchEvaluator {
+    
+public:
+    enum Status {
+        IN_PROGRESS = 0, //No line and at least one vacant Location
+        X_WON = 1, //'X' holds a winning line
+        O_WON = 2, //'O' holds a winning line
+        INVALID = 3, //Both sides hold a line, or the masks overlap
+        TIE = 4 //Every Location is used and neither side holds a line
+    };
+    
+    enum Level { SCALAR, SSE2, AVX2 };
+    
+    static void evaluate(const uint16_t*, const uint16_t*, unsigned char*, size_t);
+    /*
+     *Description: Writes the Status of each position, using the best level the processor supports.
+     *             Position i is (xMasks[i], oMasks[i]).
+     *Precondition: The three arrays hold at least count entries; masks use only the low 9 bits
+     *Postcondition: status[i] holds the Status of position i
+     */
+    
+    static void evaluate(const uint16_t*, const uint16_t*, unsigned char*, size_t, Level);
+    /*
+     *Description: Same as above using the supplied level. A level the processor does not
+     *             support falls back to the best one it does.
+     *Precondition: Same as above
+     *Postcondition: Same as above
+     */
+    
+    static void evaluate(const PositionBatch&, vector<unsigned char>&);
+    /*
+     *Description: Writes the Status of every position of the batch
+     *Precondition: The batch's mask arrays have the same size
+     *Postcondition: The vector is resized to the batch size and holds the Status of each position
+     */
+    
+    static Level getBestLevel();
+    /*
+     *Description: Returns the widest instruction set the processor supports
+     *Precondition: N/A
+     *Postcondition: A Level is returned
+     */
+    
+    static string getLevelName(Level);
+    /*
+     *Description: Returns "scalar", "sse2" or "avx2"
+     *Precondition: N/A
+     *Postcondition: A string is returned
+     */
+    
+    static Status classify(uint16_t, uint16_t);
+    /*
+     *Description: Returns the Status of a single position
+     *Precondition: The masks use only the low 9 bits
+     *Postcondition: A Status is returned
+     */
+};
+#endif
@@ -0,0 +1,81 @@
+/************************************************************************************
+ Title:         Benchmark.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of Benchmark.h. Formatting of results and access to
+                the private steps being measured.
+ 
+ Purpose:       Provides before/after numbers for changes to the hot paths.
+ 
+ Usage:         See Benchmark.h
+ 
+ Build with:    Compile with bench.cpp and link AllocationCounter.cpp.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#include "Benchmark.h"
+#include <cstdio>
+using namespace std;
+
+/*
+ *Description: Constructor that sets the minimum wall time, in seconds, of each measurement
+ *Precondition: The time is positive
+ *Postcondition: The Benchmark is ready to measure
+ */
+Benchmark::Benchmark(double seconds) : minSeconds(seconds)
+{
+}
+
+/*
+ *Description: Formats a result as a single-line JSON object
+ *Precondition: N/A
+ *Postcondition: A string is returned
+ */
+string Benchmark::toJson(const BenchmarkResult& result)
+{
+    char buffer[512];
+    snprintf(buffer, sizeof(buffer),
+             "{\"name\":\"%s\",\"board\":\"%s\",\"operations\":%ld,\"ns_per_op\":%.2f,"
+             "\"allocs_per_op\":%.3f,\"ops_per_sec\":%.0f}",
+             result.name.c_str(), result.board.c_str(), result.operations, result.nanosPerOp,
+             result.allocationsPerOp, result.getOpsPerSecond());
+    return buffer;
+}
+
+/*
+ *Description: Formats a result as one aligned line of text
+ *Precondition: N/A
+ *Postcondition: A string is returned
+ */
+string Benchmark::toText(const BenchmarkResult& result)
+{
+    char buffer[512];
+    snprintf(buffer, sizeof(buffer), "%-40s %-8s %12.1f ns/op %10.3f allocs/op %14.0f ops/s",
+             result.name.c_str(), result.board.c_str(), result.nanosPerOp,
+             result.allocationsPerOp, result.getOpsPerSecond());
+    return buffer;
+}
+
+/*
+ *Description: Calls the private GameBoard::updateGameStatus
+ *Precondition: Same as GameBoard::updateGameStatus
+ *Postcondition: Same as GameBoard::updateGameStatus
+ */
+void Benchmark::updateGameStatus(GameBoard& board, int cell, int side)
+{
+    board.updateGameStatus(cell, side);
+}
+
+/*
+ *Description: Calls the private Computer::updateCombinations
+ *Precondition: Same as Computer::updateCombinations
+ *Postcondition: Same as Computer::updateCombinations
+ */
+void Benchmark::updateCombinations(Computer& computer, const GameBoard& board, string ownID, string opponentID)
+{
+    computer.updateCombinations(board, ownID, opponentID);
+}
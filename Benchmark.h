@@ -0,0 +1,121 @@
+/************************************************************************************
+ Title:         Benchmark.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   A small timing harness for the engine's hot paths. A benchmark body is
+                called repeatedly until a minimum wall time has passed, and the time and
+                heap allocations per operation are reported.
+ 
+ Purpose:       Provides before/after numbers for changes to the hot paths. Benchmark is a
+                friend of GameBoard and Computer so private steps such as
+                GameBoard::updateGameStatus can be measured in isolation.
+ 
+ Usage:         Benchmark bench(0.2);
+                BenchmarkResult result = bench.measure("name", "3x3k3", opsPerCall, body);
+                cout << Benchmark::toJson(result) << endl;
+ 
+ Build with:    Compile with bench.cpp and link AllocationCounter.cpp.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#ifndef TicTacToe_Benchmark_h
+#define TicTacToe_Benchmark_h
+
+#include "AllocationCounter.h"
+#include "Computer.h"
+#include "GameBoard.h"
+#include <chrono>
+#include <string>
+using namespace std;
+
+struct BenchmarkResult {
+    string name; //What was measured
+    string board; //Board the corpus was drawn from, for instance "3x3k3"
+    long operations; //Number of operations timed
+    double nanosPerOp; //Wall time per operation
+    double allocationsPerOp; //Heap allocations per operation
+    
+    double getOpsPerSecond() const { return nanosPerOp > 0 ? 1e9 / nanosPerOp : 0; }
+};
+
+class Benchmark {
+    
+public:
+    Benchmark(double);
+    /*
+     *Description: Constructor that sets the minimum wall time, in seconds, of each measurement
+     *Precondition: The time is positive
+     *Postcondition: The Benchmark is ready to measure
+     */
+    
+    template <class Body>
+    BenchmarkResult measure(const string& name, const string& board, long opsPerCall, Body body)
+    /*
+     *Description: Calls 'body' once to warm up, then in doubling batches until the minimum time has
+     *             passed. Each call of 'body' must perform 'opsPerCall' operations.
+     *Precondition: opsPerCall > 0
+     *Postcondition: The time and allocations per operation of the final batch are returned
+     */
+    {
+        body();
+        
+        long calls = 1;
+        for(;;)
+        {
+            long allocationsBefore = AllocationCounter::getCount();
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            for(long i = 0; i < calls; i++)
+                body();
+            double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            long allocations = AllocationCounter::getCount() - allocationsBefore;
+            
+            if(seconds >= minSeconds || calls >= (1L << 40))
+            {
+                BenchmarkResult result;
+                result.name = name;
+                result.board = board;
+                result.operations = calls * opsPerCall;
+                result.nanosPerOp = seconds * 1e9 / result.operations;
+                result.allocationsPerOp = static_cast<double>(allocations) / result.operations;
+                return result;
+            }
+            calls *= 2;
+        }
+    }
+    
+    static string toJson(const BenchmarkResult&);
+    /*
+     *Description: Formats a result as a single-line JSON object
+     *Precondition: N/A
+     *Postcondition: A string is returned
+     */
+    
+    static string toText(const BenchmarkResult&);
+    /*
+     *Description: Formats a result as one aligned line of text
+     *Precondition: N/A
+     *Postcondition: A string is returned
+     */
+    
+    static void updateGameStatus(GameBoard&, int, int);
+    /*
+     *Description: Calls the private GameBoard::updateGameStatus
+     *Precondition: Same as GameBoard::updateGameStatus
+     *Postcondition: Same as GameBoard::updateGameStatus
+     */
+    
+    static void updateCombinations(Computer&, const GameBoard&, string, string);
+    /*
+     *Description: Calls the private Computer::updateCombinations
+     *Precondition: Same as Computer::updateCombinations
+     *Postcondition: Same as Computer::updateCombinations
+     */
+    
+private:
+    double minSeconds; //Minimum wall time of each measurement
+};
+#endif
@@ -0,0 +1,325 @@
+/************************************************************************************
+ Title:         BoardGeometry.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of BoardGeometry.h. Generates the winning lines of an
+                m,n,k board, flat or layered, and the lines passing through each cell.
+ 
+ Purpose:       Provides the winning lines of boards of any supported size so that none
+                of the other classes hard-code the 3x3 board.
+ 
+ Usage:         BoardGeometry::classic() or BoardGeometry::get(width, height, winLength)
+ 
+ Build with:    Compile with main.cpp.
+ 
+ Modifications: Added the symmetries of the board as cell permutations.
+                Added layers: winning lines in three dimensions for cubes.
+ ***********************************************************************************/
+
+#include "BoardGeometry.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+using namespace std;
+
+/*
+ *Description: Constructor that generates every horizontal, vertical and diagonal run of
+ *             winLength cells on a board of the supplied width, height and number of layers.
+ *Precondition: 1 <= width, height, layers <= MAX_SIDE, the board has at most CellMask::CAPACITY
+ *              cells and 1 <= winLength <= max(width, height, layers)
+ *Error Checking: invalid_argument is thrown for unsupported sizes.
+ *Postcondition: The winning lines and the cell-to-line incidence are generated.
+ */
+BoardGeometry::BoardGeometry(int boardWidth, int boardHeight, int length, int layerCount)
+    : width(boardWidth), height(boardHeight), winLength(length), layers(layerCount)
+{
+    if(width < 1 || width > MAX_SIDE || height < 1 || height > MAX_SIDE || layers < 1 || layers > MAX_SIDE
+       || width * height * layers > CellMask::CAPACITY
+       || winLength < 1 || winLength > max(max(width, height), layers))
+        throw invalid_argument("BoardGeometry: unsupported board size");
+    
+    for(int cell = 0; cell < getCellCount(); cell++)
+        fullMask.set(cell);
+    
+    //Rows, then columns, then diagonals, then anti-diagonals; on the 3x3 board this
+    //matches the order of GameBoard::LINE_MASKS
+    addLines(0, 0, 1);
+    if(winLength > 1)
+    {
+        addLines(0, 1, 0);
+        addLines(0, 1, 1);
+        addLines(0, 1, -1);
+        
+        //Then the nine directions that step through the layers(76 lines in all on the 4x4x4 cube)
+        if(layers > 1)
+            for(int dx = -1; dx <= 1; dx++)
+                for(int dy = -1; dy <= 1; dy++)
+                    addLines(1, dx, dy);
+    }
+    
+    //Count the lines through each cell, then fill them in
+    cellLineStart.assign(getCellCount() + 1, 0);
+    for(size_t i = 0; i < lineCells.size(); i++)
+        cellLineStart[lineCells[i] + 1]++;
+    for(int cell = 0; cell < getCellCount(); cell++)
+        cellLineStart[cell + 1] += cellLineStart[cell];
+    
+    cellLines.resize(lineCells.size());
+    vector<int> next(cellLineStart.begin(), cellLineStart.end() - 1);
+    for(int line = 0; line < getLineCount(); line++)
+        for(int i = 0; i < winLength; i++)
+            cellLines[next[lineCells[line * winLength + i]]++] = line;
+    
+    addSymmetries();
+}
+
+/*
+ *Description: Returns the shared geometry of the standard 3x3 board with k = 3
+ *Precondition: N/A
+ *Postcondition: A reference valid for the rest of the program is returned
+ */
+const BoardGeometry& BoardGeometry::classic()
+{
+    static const BoardGeometry& geometry = get(3, 3, 3);
+    return geometry;
+}
+
+/*
+ *Description: Returns the shared geometry of the supplied width, height and winLength,
+ *             generating it on first use. Safe to call from several threads.
+ *Precondition: Same as the constructor.
+ *Postcondition: A reference valid for the rest of the program is returned
+ */
+const BoardGeometry& BoardGeometry::get(int width, int height, int winLength, int layers)
+{
+    static mutex registryLock;
+    static map<tuple<int, int, int, int>, unique_ptr<BoardGeometry> > registry;
+    
+    lock_guard<mutex> guard(registryLock);
+    unique_ptr<BoardGeometry>& geometry = registry[make_tuple(width, height, winLength, layers)];
+    if(!geometry)
+        geometry.reset(new BoardGeometry(width, height, winLength, layers));
+    return *geometry;
+}
+
+/*
+ *Description: Accessor functions for the board dimensions, the number of rows of all layers
+ *             together and the number of winning lines
+ *Precondition: N/A
+ *Postcondition: The requested value is returned
+ */
+int BoardGeometry::getWidth() const
+{
+    return width;
+}
+
+int BoardGeometry::getHeight() const
+{
+    return height;
+}
+
+int BoardGeometry::getWinLength() const
+{
+    return winLength;
+}
+
+int BoardGeometry::getLayerCount() const
+{
+    return layers;
+}
+
+int BoardGeometry::getRowCount() const
+{
+    return height * layers;
+}
+
+int BoardGeometry::getCellCount() const
+{
+    return width * height * layers;
+}
+
+int BoardGeometry::getLineCount() const
+{
+    return static_cast<int>(lines.size());
+}
+
+/*
+ *Description: Returns true for the standard 3x3 board with k = 3
+ *Precondition: N/A
+ *Postcondition: A boolean value is returned
+ */
+bool BoardGeometry::isClassic() const
+{
+    return width == 3 && height == 3 && winLength == 3 && layers == 1;
+}
+
+/*
+ *Description: Returns true if every cell fits in the first word of a CellMask
+ *Precondition: N/A
+ *Postcondition: A boolean value is returned
+ */
+bool BoardGeometry::isSmall() const
+{
+    return getCellCount() <= 64;
+}
+
+/*
+ *Description: Returns true if (x,y) lies on the board, where x counts the rows of all layers
+ *Precondition: N/A
+ *Postcondition: A boolean value is returned
+ */
+bool BoardGeometry::contains(int x, int y) const
+{
+    return x >= 0 && x < getRowCount() && y >= 0 && y < width;
+}
+
+/*
+ *Description: Returns the cell index of (x,y)
+ *Precondition: contains(x, y) is true
+ *Postcondition: An integer between 0 and getCellCount() - 1 is returned
+ */
+int BoardGeometry::getCell(int x, int y) const
+{
+    return x * width + y;
+}
+
+/*
+ *Description: Returns the Location of the supplied cell index
+ *Precondition: 0 <= cell < getCellCount()
+ *Postcondition: A vacant Location with the cell's coordinates is returned
+ */
+Location BoardGeometry::getLocation(int cell) const
+{
+    return Location(cell / width, cell % width);
+}
+
+/*
+ *Description: Returns the mask with every cell of the board set
+ *Precondition: N/A
+ *Postcondition: A CellMask is returned
+ */
+const CellMask& BoardGeometry::getFullMask() const
+{
+    return fullMask;
+}
+
+/*
+ *Description: Returns the mask of the supplied winning line
+ *Precondition: 0 <= line < getLineCount()
+ *Postcondition: A CellMask with winLength cells set is returned
+ */
+const CellMask& BoardGeometry::getLine(int line) const
+{
+    return lines[line];
+}
+
+/*
+ *Description: Returns the winLength cells of the supplied winning line in board order
+ *Precondition: 0 <= line < getLineCount()
+ *Postcondition: A pointer to winLength cell indices is returned
+ */
+const int* BoardGeometry::getLineCells(int line) const
+{
+    return &lineCells[line * winLength];
+}
+
+/*
+ *Description: Returns the winning lines passing through the supplied cell
+ *Precondition: 0 <= cell < getCellCount()
+ *Postcondition: A pointer to the line indices is returned and the int parameter holds
+ *               how many there are
+ */
+const int* BoardGeometry::getCellLines(int cell, int& count) const
+{
+    count = cellLineStart[cell + 1] - cellLineStart[cell];
+    return cellLines.data() + cellLineStart[cell];
+}
+
+/*
+ *Description: Returns the number of symmetries of the board
+ *Precondition: N/A
+ *Postcondition: 4 or 8 is returned
+ */
+int BoardGeometry::getSymmetryCount() const
+{
+    return static_cast<int>(symmetries.size()) / getCellCount();
+}
+
+/*
+ *Description: Returns the cell permutation of the supplied symmetry
+ *Precondition: 0 <= symmetry < getSymmetryCount()
+ *Postcondition: A pointer to getCellCount() cell indices is returned
+ */
+const int* BoardGeometry::getSymmetry(int symmetry) const
+{
+    return &symmetries[symmetry * getCellCount()];
+}
+
+/*
+ *Description: Adds every run of winLength cells that steps by (dz,dx,dy) and fits on the board
+ *Precondition: N/A
+ *Postcondition: The lines are appended to 'lines' and 'lineCells'
+ */
+void BoardGeometry::addLines(int dz, int dx, int dy)
+{
+    for(int z = 0; z < layers; z++)
+        for(int x = 0; x < height; x++)
+            for(int y = 0; y < width; y++)
+            {
+                //x and y stay within the layer; the layer only changes by dz
+                int endZ = z + dz * (winLength - 1);
+                int endX = x + dx * (winLength - 1);
+                int endY = y + dy * (winLength - 1);
+                if(endZ >= layers || endX < 0 || endX >= height || endY < 0 || endY >= width)
+                    continue;
+                
+                CellMask line;
+                for(int i = 0; i < winLength; i++)
+                {
+                    int cell = getCell((z + dz * i) * height + x + dx * i, y + dy * i);
+                    line.set(cell);
+                    lineCells.push_back(cell);
+                }
+                lines.push_back(line);
+            }
+}
+
+/*
+ *Description: Generates the cell permutation of each symmetry of the board
+ *Precondition: N/A
+ *Postcondition: 'symmetries' holds getSymmetryCount() permutations
+ */
+void BoardGeometry::addSymmetries()
+{
+    int count = (width == height) ? 8 : 4;
+    int lastX = height - 1;
+    int lastY = width - 1;
+    symmetries.resize(count * getCellCount());
+    
+    //Every layer is turned alike, which keeps the lines through the layers intact
+    for(int symmetry = 0; symmetry < count; symmetry++)
+        for(int z = 0; z < layers; z++)
+            for(int x = 0; x < height; x++)
+                for(int y = 0; y < width; y++)
+                {
+                    int toX = x, toY = y;
+                    switch(symmetry)
+                    {
+                        case 1: toX = lastX - x; break;                   //Mirror top to bottom
+                        case 2: toY = lastY - y; break;                   //Mirror left to right
+                        case 3: toX = lastX - x; toY = lastY - y; break;  //Half turn
+                        case 4: toX = y; toY = x; break;                  //Main diagonal
+                        case 5: toX = y; toY = lastX - x; break;          //Quarter turn
+                        case 6: toX = lastY - y; toY = x; break;          //Three quarter turn
+                        case 7: toX = lastY - y; toY = lastX - x; break;  //Anti-diagonal
+                    }
+                    int layerStart = z * height;
+                    symmetries[symmetry * getCellCount() + getCell(layerStart + x, y)] = getCell(layerStart + toX, toY);
+                }
+}
@@ -0,0 +1,196 @@
+/************************************************************************************
+ Title:         BoardGeometry.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   Describes the shape of an m,n,k game board: its width, its height and the
+                number of stones in a row(k) needed to win. The set of winning lines is
+                generated from these three numbers rather than listed by hand. A board may
+                also have several layers stacked into a cube, such as the 4x4x4 board of
+                Qubic, whose winning lines run through the layers as well.
+ 
+ Purpose:       Provides the winning lines(as cell lists and as CellMasks) and, for every
+                cell, the lines passing through it, so that a move only needs to look at
+                the lines it can complete. Cell (x,y) has index x * width + y. The layers
+                are stacked row after row, so row x of layer z is row z * height + x of the
+                board and every class that works with Locations plays on cubes unchanged.
+ 
+ Usage:         BoardGeometry::classic() is the standard 3x3 board with k = 3.
+                BoardGeometry::get(width, height, winLength) returns a shared geometry
+                that lives for the rest of the program; boards of up to 256 cells with
+                sides of at most 16 are supported. BoardGeometry::get(4, 4, 4, 4) is the
+                Qubic cube with its 76 winning lines.
+ 
+ Build with:    Compile with main.cpp.
+ 
+ Modifications: Added the symmetries of the board(rotations and reflections) as cell
+                permutations for symmetry-folded hashing.
+                Added layers: winning lines in three dimensions for cubes.
+ ***********************************************************************************/
+
+#ifndef TicTacToe_BoardGeometry_h
+#define TicTacToe_BoardGeometry_h
+
+#include "CellMask.h"
+#include "Location.h"
+#include <vector>
+using namespace std;
+
+class BoardGeometry {
+
+public:
+    BoardGeometry(int, int, int, int = 1);
+    /*
+     *Description: Constructor that generates every horizontal, vertical and diagonal run of
+     *             winLength cells on a board of the supplied width, height and number of layers.
+     *             With more than one layer the runs through the layers are generated as well.
+     *Precondition: 1 <= width, height, layers <= MAX_SIDE, the board has at most CellMask::CAPACITY
+     *              cells and 1 <= winLength <= max(width, height, layers)
+     *Error Checking: invalid_argument is thrown for unsupported sizes.
+     *Postcondition: The winning lines and the cell-to-line incidence are generated.
+     */
+    
+    static const BoardGeometry& classic();
+    /*
+     *Description: Returns the shared geometry of the standard 3x3 board with k = 3
+     *Precondition: N/A
+     *Postcondition: A reference valid for the rest of the program is returned
+     */
+    
+    static const BoardGeometry& get(int, int, int, int = 1);
+    /*
+     *Description: Returns the shared geometry of the supplied width, height, winLength and number
+     *             of layers, generating it on first use. Safe to call from several threads.
+     *Precondition: Same as the constructor.
+     *Postcondition: A reference valid for the rest of the program is returned
+     */
+    
+    int getWidth() const;
+    int getHeight() const;
+    int getWinLength() const;
+    int getLayerCount() const;
+    int getRowCount() const;
+    int getCellCount() const;
+    int getLineCount() const;
+    /*
+     *Description: Accessor functions for the board dimensions, the number of rows of all layers
+     *             together and the number of winning lines
+     *Precondition: N/A
+     *Postcondition: The requested value is returned
+     */
+    
+    bool isClassic() const;
+    /*
+     *Description: Returns true for the standard 3x3 board with k = 3, whose cells match the
+     *             9-bit masks of GameBoard::LINE_MASKS.
+     *Precondition: N/A
+     *Postcondition: A boolean value is returned
+     */
+    
+    bool isSmall() const;
+    /*
+     *Description: Returns true if every cell fits in the first word of a CellMask(64 cells or
+     *             fewer), which lets callers compare single words instead of whole masks.
+     *Precondition: N/A
+     *Postcondition: A boolean value is returned
+     */
+    
+    bool contains(int, int) const;
+    /*
+     *Description: Returns true if (x,y) lies on the board, where x counts the rows of all layers
+     *Precondition: N/A
+     *Postcondition: A boolean value is returned
+     */
+    
+    int getCell(int, int) const;
+    /*
+     *Description: Returns the cell index of (x,y)
+     *Precondition: contains(x, y) is true
+     *Postcondition: An integer between 0 and getCellCount() - 1 is returned
+     */
+    
+    Location getLocation(int) const;
+    /*
+     *Description: Returns the Location of the supplied cell index
+     *Precondition: 0 <= cell < getCellCount()
+     *Postcondition: A vacant Location with the cell's coordinates is returned
+     */
+    
+    const CellMask& getFullMask() const;
+    /*
+     *Description: Returns the mask with every cell of the board set
+     *Precondition: N/A
+     *Postcondition: A CellMask is returned
+     */
+    
+    const CellMask& getLine(int) const;
+    /*
+     *Description: Returns the mask of the supplied winning line
+     *Precondition: 0 <= line < getLineCount()
+     *Postcondition: A CellMask with winLength cells set is returned
+     */
+    
+    const int* getLineCells(int) const;
+    /*
+     *Description: Returns the winLength cells of the supplied winning line in board order
+     *Precondition: 0 <= line < getLineCount()
+     *Postcondition: A pointer to winLength cell indices is returned
+     */
+    
+    const int* getCellLines(int, int&) const;
+    /*
+     *Description: Returns the winning lines passing through the supplied cell
+     *Precondition: 0 <= cell < getCellCount()
+     *Postcondition: A pointer to the line indices is returned and the int parameter holds
+     *               how many there are
+     */
+    
+    int getSymmetryCount() const;
+    /*
+     *Description: Returns the number of symmetries of the board: 8 rotations and reflections
+     *             for a square board, 4 otherwise. Symmetry 0 is the identity. The symmetries of
+     *             a layered board turn every layer alike.
+     *Precondition: N/A
+     *Postcondition: 4 or 8 is returned
+     */
+    
+    const int* getSymmetry(int) const;
+    /*
+     *Description: Returns the cell permutation of the supplied symmetry; entry c is the cell
+     *             that cell c is mapped to. Every symmetry maps winning lines onto winning lines.
+     *Precondition: 0 <= symmetry < getSymmetryCount()
+     *Postcondition: A pointer to getCellCount() cell indices is returned
+     */
+    
+    static const int MAX_SIDE = 16; //Largest supported width or height
+
+private:
+    void addLines(int, int, int);
+    /*
+     *Description: Adds every run of winLength cells that steps by (dz,dx,dy) and fits on the board,
+     *             where dz steps through the layers
+     *Precondition: N/A
+     *Postcondition: The lines are appended to 'lines' and 'lineCells'
+     */
+    
+    void addSymmetries();
+    /*
+     *Description: Generates the cell permutation of each symmetry of the board
+     *Precondition: N/A
+     *Postcondition: 'symmetries' holds getSymmetryCount() permutations
+     */
+    
+    int width; //Number of columns
+    int height; //Number of rows
+    int winLength; //Stones in a row needed to win
+    int layers; //Number of layers stacked into a cube, 1 for a flat board
+    CellMask fullMask; //Every cell of the board
+    vector<CellMask> lines; //Mask of each winning line
+    vector<int> lineCells; //winLength cells per line, line after line
+    vector<int> cellLineStart; //Offset of each cell's first entry in 'cellLines'; one extra entry at the end
+    vector<int> cellLines; //Lines through each cell, cell after cell
+    vector<int> symmetries; //Cell permutation of each symmetry, symmetry after symmetry
+};
+#endif
@@ -0,0 +1,284 @@
+/************************************************************************************
+ Title:         CellMask.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   Auxiliary Structure that holds one bit per cell of a game board of up to
+                256 cells(for instance 16x16). Bit 'cell' of a CellMask is set when that
+                cell belongs to the mask.
+ 
+ Purpose:       Represents occupancy masks and winning lines of boards of any supported
+                size. All operations are branch-free word operations; boards of up to 64
+                cells only ever use the first word.
+ 
+ Usage:         CellMask mask; mask.set(cell); if(line.isSubsetOf(mask)) ...
+ 
+ Build with:    Header only. Compile with main.cpp.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+#ifndef TicTacToe_CellMask_h
+#define TicTacToe_CellMask_h
+
+#include <cstdint>
+using namespace std;
+
+struct CellMask {
+    
+    static const int WORDS = 4; //Number of 64-bit words
+    static const int CAPACITY = WORDS * 64; //Largest number of cells a mask can hold
+    
+    CellMask();
+    /*
+     *Description: Constructor that initializes an empty CellMask
+     *Precondition: N/A
+     *Postcondition: No cell is set
+     */
+    
+    explicit CellMask(uint64_t);
+    /*
+     *Description: Constructor that initializes a CellMask whose first word is the supplied bits
+     *Precondition: N/A
+     *Postcondition: Cells 0 to 63 are set according to the bits; the other cells are clear
+     */
+    
+    bool test(int) const;
+    /*
+     *Description: Returns whether the supplied cell is set
+     *Precondition: 0 <= cell < CAPACITY
+     *Postcondition: A boolean value is returned
+     */
+    
+    void set(int);
+    void clear(int);
+    /*
+     *Description: Mutator functions that set or clear the supplied cell
+     *Precondition: 0 <= cell < CAPACITY
+     *Postcondition: The cell is set or clear; no other cell changes
+     */
+    
+    uint64_t word(int) const;
+    /*
+     *Description: Accessor function for the supplied 64-bit word; word(0) holds cells 0 to 63
+     *Precondition: 0 <= index < WORDS
+     *Postcondition: The word is returned
+     */
+    
+    bool none() const;
+    bool any() const;
+    /*
+     *Description: Return whether no cell / any cell is set
+     *Precondition: N/A
+     *Postcondition: A boolean value is returned
+     */
+    
+    int count() const;
+    /*
+     *Description: Returns the number of set cells
+     *Precondition: N/A
+     *Postcondition: An integer between 0 and CAPACITY is returned
+     */
+    
+    int lowest() const;
+    int popLowest();
+    /*
+     *Description: Return the lowest set cell; popLowest also clears it
+     *Precondition: any() is true
+     *Postcondition: The cell is returned(-1 if no cell was set)
+     */
+    
+    int nth(int) const;
+    /*
+     *Description: Returns the n-th lowest set cell(n = 0 is the lowest)
+     *Precondition: 0 <= n < count()
+     *Postcondition: The cell is returned(-1 if there are not that many)
+     */
+    
+    bool isSubsetOf(const CellMask&) const;
+    bool intersects(const CellMask&) const;
+    /*
+     *Description: Return whether every cell of this mask is also set in the supplied mask / whether the
+     *             two masks share any cell
+     *Precondition: N/A
+     *Postcondition: A boolean value is returned
+     */
+    
+    CellMask without(const CellMask&) const;
+    /*
+     *Description: Returns the cells of this mask that are not in the supplied mask
+     *Precondition: N/A
+     *Postcondition: A CellMask is returned
+     */
+    
+    CellMask& operator|=(const CellMask&);
+    CellMask& operator&=(const CellMask&);
+    CellMask& operator^=(const CellMask&);
+    CellMask operator|(const CellMask&) const;
+    CellMask operator&(const CellMask&) const;
+    CellMask operator^(const CellMask&) const;
+    bool operator==(const CellMask&) const;
+    bool operator!=(const CellMask&) const;
+    /*
+     *Description: Union, intersection, symmetric difference and comparison of two masks, cell by cell
+     *Precondition: N/A
+     *Postcondition: The compound forms update and return this mask; the others leave both unchanged
+     */
+
+private:
+    uint64_t words[WORDS]; //Bit (cell % 64) of words[cell / 64] represents 'cell'
+};
+
+//Masks are tested and combined in the inner loops of every search, so their functions are defined here
+inline CellMask::CellMask() : words{0, 0, 0, 0}
+{
+}
+
+inline CellMask::CellMask(uint64_t low) : words{low, 0, 0, 0}
+{
+}
+
+inline bool CellMask::test(int cell) const
+{
+    return (words[cell >> 6] >> (cell & 63)) & 1;
+}
+
+inline void CellMask::set(int cell)
+{
+    words[cell >> 6] |= uint64_t(1) << (cell & 63);
+}
+
+inline void CellMask::clear(int cell)
+{
+    words[cell >> 6] &= ~(uint64_t(1) << (cell & 63));
+}
+
+inline uint64_t CellMask::word(int index) const
+{
+    return words[index];
+}
+
+inline bool CellMask::none() const
+{
+    return (words[0] | words[1] | words[2] | words[3]) == 0;
+}
+
+inline bool CellMask::any() const
+{
+    return !none();
+}
+
+inline int CellMask::count() const
+{
+    return __builtin_popcountll(words[0]) + __builtin_popcountll(words[1])
+         + __builtin_popcountll(words[2]) + __builtin_popcountll(words[3]);
+}
+
+inline int CellMask::lowest() const
+{
+    for(int i = 0; i < WORDS; i++)
+        if(words[i])
+            return i * 64 + __builtin_ctzll(words[i]);
+    return -1;
+}
+
+inline int CellMask::popLowest()
+{
+    for(int i = 0; i < WORDS; i++)
+        if(words[i])
+        {
+            int cell = i * 64 + __builtin_ctzll(words[i]);
+            words[i] &= words[i] - 1;
+            return cell;
+        }
+    return -1;
+}
+
+inline int CellMask::nth(int n) const
+{
+    for(int i = 0; i < WORDS; i++)
+    {
+        int bits = __builtin_popcountll(words[i]);
+        if(n < bits)
+        {
+            uint64_t w = words[i];
+            for(; n > 0; n--)
+                w &= w - 1;
+            return i * 64 + __builtin_ctzll(w);
+        }
+        n -= bits;
+    }
+    return -1;
+}
+
+inline bool CellMask::isSubsetOf(const CellMask& other) const
+{
+    return ((words[0] & ~other.words[0]) | (words[1] & ~other.words[1])
+          | (words[2] & ~other.words[2]) | (words[3] & ~other.words[3])) == 0;
+}
+
+inline bool CellMask::intersects(const CellMask& other) const
+{
+    return ((words[0] & other.words[0]) | (words[1] & other.words[1])
+          | (words[2] & other.words[2]) | (words[3] & other.words[3])) != 0;
+}
+
+inline CellMask CellMask::without(const CellMask& other) const
+{
+    CellMask result;
+    for(int i = 0; i < WORDS; i++)
+        result.words[i] = words[i] & ~other.words[i];
+    return result;
+}
+
+inline CellMask& CellMask::operator|=(const CellMask& other)
+{
+    for(int i = 0; i < WORDS; i++)
+        words[i] |= other.words[i];
+    return *this;
+}
+
+inline CellMask& CellMask::operator&=(const CellMask& other)
+{
+    for(int i = 0; i < WORDS; i++)
+        words[i] &= other.words[i];
+    return *this;
+}
+
+inline CellMask& CellMask::operator^=(const CellMask& other)
+{
+    for(int i = 0; i < WORDS; i++)
+        words[i] ^= other.words[i];
+    return *this;
+}
+
+inline CellMask CellMask::operator|(const CellMask& other) const
+{
+    CellMask result = *this;
+    return result |= other;
+}
+
+inline CellMask CellMask::operator&(const CellMask& other) const
+{
+    CellMask result = *this;
+    return result &= other;
+}
+
+inline CellMask CellMask::operator^(const CellMask& other) const
+{
+    CellMask result = *this;
+    return result ^= other;
+}
+
+inline bool CellMask::operator==(const CellMask& other) const
+{
+    return ((words[0] ^ other.words[0]) | (words[1] ^ other.words[1])
+          | (words[2] ^ other.words[2]) | (words[3] ^ other.words[3])) == 0;
+}
+
+inline bool CellMask::operator!=(const CellMask& other) const
+{
+    return !(*this == other);
+}
+#endif
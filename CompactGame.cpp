@@ -0,0 +1,91 @@
+/************************************************************************************
+ Title:         CompactGame.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of CompactGame.h. The state of a classic GameSession
+                in six bytes.
+ 
+ Purpose:       Lets the GameServer keep millions of idle games in memory.
+ 
+ Usage:         CompactGame stored(session); GameSession session = stored.expand(seed);
+ 
+ Build with:    Compile with server.cpp.
+ 
+ Modifications: Games can be compared, so the server can tell whether one changed.
+ ***********************************************************************************/
+
+#include "CompactGame.h"
+#include "CellMask.h"
+using namespace std;
+
+/*
+ *Description: Constructor of an empty game
+ *Precondition: N/A
+ *Postcondition: The game has no moves
+ */
+CompactGame::CompactGame() : xMask(0), oMask(0), lastMove(NO_MOVE), flags(0)
+{
+}
+
+/*
+ *Description: Constructor that packs the state of the supplied session
+ *Precondition: The session is played on the classic board
+ *Postcondition: expand() rebuilds an equivalent session
+ */
+CompactGame::CompactGame(const GameSession& session)
+{
+    const GameBoard& board = session.getBoard();
+    xMask = static_cast<uint16_t>(board.getMask(0).word(0));
+    oMask = static_cast<uint16_t>(board.getMask(1).word(0));
+    
+    int cell = session.getLastComputerCell();
+    lastMove = cell < 0 ? NO_MOVE : static_cast<uint8_t>(cell);
+    
+    flags = static_cast<uint8_t>(session.getStrategy() << STRATEGY_SHIFT);
+    if(board.getPlayerID() == "O")
+        flags |= PLAYER_IS_O;
+    if(session.isResigned())
+        flags |= RESIGNED;
+}
+
+/*
+ *Description: Rebuilds the GameSession with the supplied seed
+ *Precondition: The seed is the one the session was created with
+ *Postcondition: The session continues the stored game
+ */
+GameSession CompactGame::expand(uint64_t seed) const
+{
+    Computer::Strategy strategy = static_cast<Computer::Strategy>(flags >> STRATEGY_SHIFT);
+    GameSession session(BoardGeometry::classic(), (flags & PLAYER_IS_O) ? "O" : "X", strategy, seed);
+    session.restore(CellMask(xMask), CellMask(oMask), (flags & RESIGNED) != 0,
+                    lastMove == NO_MOVE ? -1 : lastMove);
+    return session;
+}
+
+/*
+ *Description: Compare every stored field of two games
+ *Precondition: N/A
+ *Postcondition: A boolean value is returned
+ */
+bool CompactGame::operator==(const CompactGame& other) const
+{
+    return xMask == other.xMask && oMask == other.oMask && lastMove == other.lastMove && flags == other.flags;
+}
+
+bool CompactGame::operator!=(const CompactGame& other) const
+{
+    return !(*this == other);
+}
+
+/*
+ *Description: Returns true if games of the supplied geometry can be packed
+ *Precondition: N/A
+ *Postcondition: A boolean value is returned
+ */
+bool CompactGame::fits(const BoardGeometry& geometry)
+{
+    return geometry.isClassic();
+}
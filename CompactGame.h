@@ -0,0 +1,87 @@
+/************************************************************************************
+ Title:         CompactGame.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The state of a classic(3x3) GameSession packed into six bytes: the 'X' and
+                'O' stones as two 9-bit masks, the Computer's latest move, the player's
+                ID, whether the player resigned and the Computer's Strategy.
+ 
+ Purpose:       Lets the GameServer keep millions of idle games in memory. A full
+                GameSession is only rebuilt while a command is being carried out; the
+                game's seed is not stored because the server derives it from the id.
+ 
+ Usage:         CompactGame stored(session); //after each command
+                GameSession session = stored.expand(seed); //before the next one
+ 
+ Build with:    Compile with server.cpp.
+ 
+ Modifications: Games can be compared, so the server can tell whether one changed.
+ ***********************************************************************************/
+
+#ifndef TicTacToe_CompactGame_h
+#define TicTacToe_CompactGame_h
+
+#include "BoardGeometry.h"
+#include "Computer.h"
+#include "GameSession.h"
+#include <cstdint>
+using namespace std;
+
+class CompactGame {
+
+public:
+    CompactGame();
+    /*
+     *Description: Constructor of an empty game in which the player is 'X' and the Computer uses the
+     *             HEURISTIC Strategy
+     *Precondition: N/A
+     *Postcondition: The game has no moves
+     */
+    
+    explicit CompactGame(const GameSession&);
+    /*
+     *Description: Constructor that packs the state of the supplied session
+     *Precondition: The session is played on the classic board(see fits())
+     *Postcondition: expand() rebuilds an equivalent session
+     */
+    
+    GameSession expand(uint64_t) const;
+    /*
+     *Description: Rebuilds the GameSession with the supplied seed
+     *Precondition: The seed is the one the session was created with
+     *Postcondition: The session continues the stored game
+     */
+    
+    bool operator==(const CompactGame&) const;
+    bool operator!=(const CompactGame&) const;
+    /*
+     *Description: Compare every stored field of two games
+     *Precondition: N/A
+     *Postcondition: A boolean value is returned
+     */
+    
+    static bool fits(const BoardGeometry&);
+    /*
+     *Description: Returns true if games of the supplied geometry can be packed(the classic board only)
+     *Precondition: N/A
+     *Postcondition: A boolean value is returned
+     */
+
+private:
+    static const uint8_t NO_MOVE = 0xFF; //'lastMove' before the Computer has moved
+    static const uint8_t PLAYER_IS_O = 1; //Bit of 'flags' set when the player uses 'O'
+    static const uint8_t RESIGNED = 2; //Bit of 'flags' set when the player resigned
+    static const int STRATEGY_SHIFT = 2; //Position of the Strategy in 'flags'
+    
+    uint16_t xMask; //Cells holding 'X'(bit 3x+y)
+    uint16_t oMask; //Cells holding 'O'
+    uint8_t lastMove; //Cell of the Computer's latest move, or NO_MOVE
+    uint8_t flags; //PLAYER_IS_O, RESIGNED and the Strategy above STRATEGY_SHIFT
+};
+
+static_assert(sizeof(CompactGame) == 6, "CompactGame should pack into six bytes");
+static_assert(Computer::STRATEGY_COUNT <= 64, "CompactGame keeps the Strategy in six bits");
+#endif
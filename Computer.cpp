@@ -16,61 +16,155 @@
  
  Build with:    Compile with main.cpp. Written with Xcode on OS X 10.8.5.
  
- Modifications: N/A
+ Modifications: Vacant positions are now located with the GameBoard empty mask.
+                Added a selectable Strategy; NEGAMAX plays perfectly via NegamaxSearch.
+                TABLE plays perfectly from the compile-time SolvedTable.
+                WinningCombinations are generated from the board's BoardGeometry.
+                Line state is updated incrementally from the moves made since the last decision.
+                Random choices come from a per-Computer seedable Random instead of rand().
+                A Computer can choose moves for either ID.
+                An OpeningBook, when set, is consulted before any Strategy.
+                Added the ALPHA_BETA Strategy for boards of up to 64 cells.
+                Added the anytime mode with a deadline or a move time.
+                ALPHA_BETA plays a forced win found by the ThreatSearch on large boards.
+                Decisions can be recorded in an EngineStats.
+                The HEURISTIC Strategy reads the rank buckets and the combinations in place
+                instead of copying them, so it makes no heap allocations.
+                Added setNetwork for ALPHA_BETA's n-tuple network evaluation.
+                setStrategy and setMoveTime reserve the search they select.
+                The OpeningBook is skipped where NEGAMAX or TABLE already play perfectly.
+                setNetwork reserves the search as well.
+                Added newGame.
  ***********************************************************************************/
 
 #include "Computer.h"
-#include <cstdlib>
+#include "SolvedTable.h"
 using namespace std;
 
 /*
- *Description: Constructor that initializes the member arrays with all the possible WinningCombinations.
- *              The Computer will use these two arrays to keep track of all the possible ways it or the player
- *              can win.
+ *Description:  Constructor of a Computer using the HEURISTIC Strategy. The WinningCombinations are
+ *              generated from the board's geometry the first time the HEURISTIC Strategy analyzes a board.
  *Precondition: N/A
- *Postcondition: The computer has access to two arrays consisting of same set of all possible WinningCombinations
+ *Postcondition: The computer is ready; no memory has been allocated
  */
 Computer::Computer()
+    : lineGeometry(0), strategy(HEURISTIC), openingBook(0), moveTime(0), stats(0), lastPath(EngineStats::HEURISTIC),
+      heuristicLines(0)
 {
-    computerWin[0] = WinningCombination(Location(0,0), Location(0,1), Location(0,2));
-    computerWin[1] = WinningCombination(Location(1,0), Location(1,1), Location(1,2));
-    computerWin[2] = WinningCombination(Location(2,0), Location(2,1), Location(2,2));
-    computerWin[3] = WinningCombination(Location(0,0), Location(1,0), Location(2,0));
-    computerWin[4] = WinningCombination(Location(0,1), Location(1,1), Location(2,1));
-    computerWin[5] = WinningCombination(Location(0,2), Location(1,2), Location(2,2));
-    computerWin[6] = WinningCombination(Location(0,0), Location(1,1), Location(2,2));
-    computerWin[7] = WinningCombination(Location(0,2), Location(1,1), Location(2,0));
+}
+
+/*
+ *Description: Rebuilds both arrays of WinningCombinations from the winning lines of the supplied geometry
+ *Precondition: N/A
+ *Postcondition: computerWin and playerWin hold one WinningCombination per winning line, all valid with rank 0
+ */
+void Computer::buildCombinations(const BoardGeometry& geometry)
+{
+    computerWin.clear();
+    playerWin.clear();
     
-    playerWin[0] = WinningCombination(Location(0,0), Location(0,1), Location(0,2));
-    playerWin[1] = WinningCombination(Location(1,0), Location(1,1), Location(1,2));
-    playerWin[2] = WinningCombination(Location(2,0), Location(2,1), Location(2,2));
-    playerWin[3] = WinningCombination(Location(0,0), Location(1,0), Location(2,0));
-    playerWin[4] = WinningCombination(Location(0,1), Location(1,1), Location(2,1));
-    playerWin[5] = WinningCombination(Location(0,2), Location(1,2), Location(2,2));
-    playerWin[6] = WinningCombination(Location(0,0), Location(1,1), Location(2,2));
-    playerWin[7] = WinningCombination(Location(0,2), Location(1,1), Location(2,0));
+    vector<Location> locations(geometry.getWinLength());
+    for(int line = 0; line < geometry.getLineCount(); line++)
+    {
+        const int* cells = geometry.getLineCells(line);
+        for(int i = 0; i < geometry.getWinLength(); i++)
+            locations[i] = geometry.getLocation(cells[i]);
+        
+        computerWin.push_back(WinningCombination(locations));
+        playerWin.push_back(WinningCombination(locations));
+    }
+    lineGeometry = &geometry;
+    resetCombinations();
 }
+
 /*
- *Description: Updates the validity of all the WinningCombination by calling each WinningCombination's 
- *             checkValidity(see WinningCombination.h) function.
+ *Description: Returns every WinningCombination to its empty-board state
+ *Precondition: computerWin and playerWin match lineGeometry
+ *Postcondition: All WinningCombinations are valid with rank 0 and no move has been recorded
+ */
+void Computer::resetCombinations()
+{
+    for(size_t i = 0; i < computerWin.size(); i++)
+    {
+        computerWin[i].reset();
+        playerWin[i].reset();
+    }
+    computerRanks.reset(lineGeometry->getLineCount(), lineGeometry->getWinLength());
+    playerRanks.reset(lineGeometry->getLineCount(), lineGeometry->getWinLength());
+    knownComputerMask = CellMask();
+    knownPlayerMask = CellMask();
+}
+
+/*
+ *Description: Brings the WinningCombinations up to date with the board, where the first string is the
+ *             Computer's ID and the second its opponent's. Only the moves made since the previous call
+ *             are applied, and each one only touches the lines through its cell. The state is rebuilt
+ *             from scratch when the board is of another size, belongs to a new game or the IDs have changed.
  *Precondition: N/A
  *Postcondition: All the WinningCombinations are appropriately marked as valid or invalid. Consquently,
  *                computer 'knows' which WinningCombinations to consider when attempting to win or defend.
  */
-void Computer::updateCombinations(const GameBoard& board)
+void Computer::updateCombinations(const GameBoard& board, string ownID, string opponentID)
+{
+    //A board of another size needs its own WinningCombinations
+    if(lineGeometry != &board.getGeometry())
+        buildCombinations(board.getGeometry());
+    
+    const CellMask& computerMask = board.getMask(ownID);
+    const CellMask& playerMask = board.getMask(opponentID);
+    
+    //Moves only ever get added during a game; anything else means the state is stale
+    if(ownID != knownComputerID || !knownComputerMask.isSubsetOf(computerMask)
+       || !knownPlayerMask.isSubsetOf(playerMask))
+    {
+        resetCombinations();
+        knownComputerID = ownID;
+    }
+    
+    CellMask newMoves = computerMask.without(knownComputerMask);
+    while(newMoves.any())
+        applyMove(newMoves.popLowest(), ownID, true);
+    
+    newMoves = playerMask.without(knownPlayerMask);
+    while(newMoves.any())
+        applyMove(newMoves.popLowest(), opponentID, false);
+    
+    knownComputerMask = computerMask;
+    knownPlayerMask = playerMask;
+}
+
+/*
+ *Description: Records one move in the WinningCombinations of the lines that pass through its cell
+ *Precondition: The cell lies on the board of lineGeometry
+ *Postcondition: The mover's lines advance in rank and the other side's lines become invalid
+ */
+void Computer::applyMove(int cell, string id, bool byComputer)
 {
-    for(int i = 0; i < 8; i++)
+    Location loc = lineGeometry->getLocation(cell);
+    loc.isUsed = true;
+    loc.locationId = id;
+    
+    vector<WinningCombination>& moverWin = byComputer ? computerWin : playerWin;
+    vector<WinningCombination>& otherWin = byComputer ? playerWin : computerWin;
+    RankedLines& moverRanks = byComputer ? computerRanks : playerRanks;
+    RankedLines& otherRanks = byComputer ? playerRanks : computerRanks;
+    
+    int count;
+    const int* lines = lineGeometry->getCellLines(cell, count);
+    heuristicLines += count;
+    for(int i = 0; i < count; i++)
     {
-        //Validates all the WinningCombinations
-        //The function resetRank ensures that the rank is not updated over the max value of 2
-        playerWin[i].resetRank();
-        playerWin[i].checkValidity(board, board.getPlayerID());
+        int line = lines[i];
         
-        computerWin[i].resetRank();
-        computerWin[i].checkValidity(board, board.getComputerID());
+        moverWin[line].addStone(loc, true);
+        if(moverRanks.contains(line))
+            moverRanks.setRank(line, moverWin[line].getRank());
         
+        otherWin[line].addStone(loc, false);
+        otherRanks.remove(line);
     }
 }
+
 /*
  *Description: Finds and return a vacant position randomly
  *Precondition: N/A
@@ -78,39 +172,419 @@ void Computer::updateCombinations(const GameBoard& board)
  */
 Location Computer::getRandomLocation(const GameBoard& board)
 {
-    vector<Location> randomLocations;
-    //Cycle through all the positions of the game board and add all unused locations
-    //to the vector 'randomLocations'
-    for(int i = 0; i < 3; i++)
-        for(int j = 0; j < 3; j++)
-            if(board.gameBoard[i][j].isUsed == false)
-            {
-                randomLocations.push_back(Location(i,j));
-            }
-    //Return a random Location from the vector
-    return randomLocations[rand() % static_cast<int>(randomLocations.size())];
+    //Pick the n-th vacant position, where n is drawn from the number of vacant positions
+    CellMask emptyMask = board.getEmptyMask();
+    int cell = emptyMask.nth(random.nextInt(emptyMask.count()));
+    return board.getGeometry().getLocation(cell);
 }
 
 /*
- *Description: Returns the Computer's next move Location after analyzing the Board.
+ *Description: Returns the Computer's next move Location after analyzing the Board with the
+ *             current Strategy.
  *Precondition: N/A
  *Postcondition: Computer's next Location is returned.
  */
 Location Computer::chooseNextMove(const GameBoard& board)
+{
+    return chooseNextMove(board, board.getComputerID());
+}
+
+/*
+ *Description: Returns the next move Location for the supplied ID('X' or 'O') after analyzing the Board
+ *             with the current Strategy. The opponent is the other ID.
+ *Precondition: N/A
+ *Postcondition: The next Location for the supplied ID is returned.
+ */
+Location Computer::chooseNextMove(const GameBoard& board, string ownID)
+{
+    if(!stats)
+        return decide(board, ownID);
+    
+    //Only a Computer with statistics looks at the clock and the allocation count
+    long allocations = EngineStats::countAllocations();
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    Location move = decide(board, ownID);
+    recordDecision(board, start, allocations);
+    return move;
+}
+
+/*
+ *Description: The anytime mode: returns the next move Location for the supplied ID by the supplied deadline
+ *Precondition: The game is not over
+ *Postcondition: The next Location for the supplied ID is returned shortly after the deadline at the latest
+ */
+Location Computer::chooseNextMove(const GameBoard& board, string ownID, chrono::steady_clock::time_point deadline)
+{
+    if(!stats)
+        return decide(board, ownID, deadline);
+    
+    long allocations = EngineStats::countAllocations();
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    Location move = decide(board, ownID, deadline);
+    recordDecision(board, start, allocations);
+    return move;
+}
+
+/*
+ *Description: Returns the next move for the supplied ID without recording the decision
+ *Precondition: N/A
+ *Postcondition: The next Location for the supplied ID is returned; 'lastPath' is set
+ */
+Location Computer::decide(const GameBoard& board, string ownID)
+{
+    if(moveTime > 0)
+        return decide(board, ownID, chrono::steady_clock::now()
+            + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double, milli>(moveTime)));
+    
+    Location bookMove;
+    if(openingBook && !playsPerfectly(board) && openingBook->chooseMove(board, random, bookMove))
+    {
+        lastPath = EngineStats::BOOK;
+        return bookMove;
+    }
+    return chooseStrategyMove(board, ownID);
+}
+
+/*
+ *Description: Returns the next move for the supplied ID by the supplied deadline without recording the decision
+ *Precondition: The game is not over
+ *Postcondition: The next Location for the supplied ID is returned; 'lastPath' is set
+ */
+Location Computer::decide(const GameBoard& board, string ownID, chrono::steady_clock::time_point deadline)
+{
+    Location bookMove;
+    if(openingBook && !playsPerfectly(board) && openingBook->chooseMove(board, random, bookMove))
+    {
+        lastPath = EngineStats::BOOK;
+        return bookMove;
+    }
+    
+    if(strategy == MONTE_CARLO)
+    {
+        lastPath = EngineStats::MONTE_CARLO;
+        return monteCarlo.chooseMove(board, ownID, random.next(), deadline);
+    }
+    if(playsPerfectly(board))
+        return chooseStrategyMove(board, ownID);
+    
+    //A forced win is looked for in the first half of the time
+    Location winningMove;
+    if(board.getGeometry().getCellCount() > ThreatSearch::LARGE_BOARD_CELLS
+       && threatSearch.findWin(board, ownID, winningMove,
+                               chrono::steady_clock::now() + (deadline - chrono::steady_clock::now()) / 2))
+    {
+        lastPath = EngineStats::THREAT;
+        return winningMove;
+    }
+    lastPath = EngineStats::ALPHA_BETA;
+    return alphaBeta.chooseMove(board, ownID, deadline);
+}
+
+/*
+ *Description: Records the decision just made on the supplied board in 'stats'
+ *Precondition: 'stats' is set and the decision was made by decide
+ *Postcondition: The decision is recorded
+ */
+void Computer::recordDecision(const GameBoard& board, chrono::steady_clock::time_point start, long allocations)
+{
+    EngineStats::Decision decision;
+    decision.nanoseconds = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+    decision.allocations = allocations < 0 ? -1 : EngineStats::countAllocations() - allocations;
+    decision.path = lastPath;
+    decision.nodes = 0;
+    decision.linesEvaluated = 0;
+    decision.cacheHits = 0;
+    decision.cacheMisses = 0;
+    
+    //The counts of the searches are those of their latest run, which was this decision's
+    if((lastPath == EngineStats::THREAT || lastPath == EngineStats::ALPHA_BETA)
+       && board.getGeometry().getCellCount() > ThreatSearch::LARGE_BOARD_CELLS)
+    {
+        decision.nodes = threatSearch.getNodeCount();
+        decision.linesEvaluated = threatSearch.getLinesEvaluated();
+    }
+    if(lastPath == EngineStats::ALPHA_BETA)
+    {
+        decision.nodes += alphaBeta.getNodeCount();
+        decision.linesEvaluated += alphaBeta.getLinesEvaluated();
+        decision.cacheHits = alphaBeta.getTableHits();
+        decision.cacheMisses = alphaBeta.getTableMisses();
+    }
+    else if(lastPath == EngineStats::NEGAMAX)
+        decision.nodes = negamax.getNodeCount();
+    else if(lastPath == EngineStats::MONTE_CARLO)
+        decision.nodes = monteCarlo.getPlayoutCount();
+    else if(lastPath == EngineStats::HEURISTIC)
+        decision.linesEvaluated = heuristicLines;
+    stats->record(decision, board);
+}
+
+/*
+ *Description: Makes the forms of chooseNextMove without a deadline use the anytime mode
+ *Precondition: The time is non-negative
+ *Postcondition: The move time is updated and the search it selects is reserved
+ */
+void Computer::setMoveTime(double milliseconds)
+{
+    moveTime = milliseconds;
+    reserve();
+}
+
+/*
+ *Description: Accessor function that returns the move time in milliseconds
+ *Precondition: N/A
+ *Postcondition: The move time is returned
+ */
+double Computer::getMoveTime() const
+{
+    return moveTime;
+}
+
+/*
+ *Description: Makes every chooseNextMove record what it did in the supplied statistics; 0 turns recording off
+ *Precondition: The statistics outlive the Computer or are replaced first
+ *Postcondition: Later decisions are recorded
+ */
+void Computer::setStats(EngineStats* newStats)
+{
+    stats = newStats;
+}
+
+/*
+ *Description: Accessor function that returns the statistics decisions are recorded in, or 0
+ *Precondition: N/A
+ *Postcondition: A pointer is returned
+ */
+EngineStats* Computer::getStats() const
+{
+    return stats;
+}
+
+/*
+ *Description: Returns true if the Strategy plays perfectly on the supplied board by itself
+ *Precondition: N/A
+ *Postcondition: A boolean value is returned
+ */
+bool Computer::playsPerfectly(const GameBoard& board) const
+{
+    return board.getGeometry().isClassic() && (strategy == NEGAMAX || strategy == TABLE);
+}
+
+/*
+ *Description: Returns the next move for the supplied ID chosen by the current Strategy without a deadline
+ *Precondition: N/A
+ *Postcondition: The next Location for the supplied ID is returned.
+ */
+Location Computer::chooseStrategyMove(const GameBoard& board, string ownID)
+{
+    string opponentID = GameBoard::getOtherID(ownID);
+    
+    //Each search draws its random streams from the Computer's own sequence
+    if(strategy == MONTE_CARLO)
+    {
+        lastPath = EngineStats::MONTE_CARLO;
+        return monteCarlo.chooseMove(board, ownID, random.next());
+    }
+    if(strategy == ALPHA_BETA)
+    {
+        Location winningMove;
+        if(board.getGeometry().getCellCount() > ThreatSearch::LARGE_BOARD_CELLS
+           && threatSearch.findWin(board, ownID, winningMove))
+        {
+            lastPath = EngineStats::THREAT;
+            return winningMove;
+        }
+        lastPath = EngineStats::ALPHA_BETA;
+        return alphaBeta.chooseMove(board, ownID);
+    }
+    
+    //The search and the table cover the classic board only; other sizes use the heuristic
+    if(board.getGeometry().isClassic())
+    {
+        unsigned short own = static_cast<unsigned short>(board.getMask(ownID).word(0));
+        unsigned short opponent = static_cast<unsigned short>(board.getMask(opponentID).word(0));
+        
+        if(strategy == NEGAMAX)
+        {
+            lastPath = EngineStats::NEGAMAX;
+            return negamax.chooseMove(own, opponent);
+        }
+        if(strategy == TABLE)
+        {
+            lastPath = EngineStats::TABLE;
+            return SolvedTable::chooseMove(own, opponent);
+        }
+    }
+    
+    lastPath = EngineStats::HEURISTIC;
+    return chooseHeuristicMove(board, ownID, opponentID);
+}
+
+/*
+ *Description: Restarts the Computer's random choices from the supplied seed
+ *Precondition: N/A
+ *Postcondition: After newGame, the same seed and the same positions produce the same moves without a deadline
+ */
+void Computer::setSeed(uint64_t seed)
+{
+    random.setSeed(seed);
+}
+
+/*
+ *Description: Forgets what the searches kept from earlier games
+ *Precondition: No decision is being made
+ *Postcondition: The next decisions depend only on the seed, the settings and the positions
+ */
+void Computer::newGame()
+{
+    alphaBeta.newGame();
+}
+
+/*
+ *Description: Mutator function that selects how chooseNextMove picks its moves
+ *Precondition: N/A
+ *Postcondition: The 'strategy' is updated and its search reserved.
+ */
+void Computer::setStrategy(Strategy newStrategy)
+{
+    strategy = newStrategy;
+    reserve();
+}
+
+/*
+ *Description: Allocates the search the next decision will use
+ *Precondition: N/A
+ *Postcondition: The search is allocated; nothing is done for Strategies that search neither way
+ */
+void Computer::reserve()
+{
+    //With a move time every Strategy but MONTE_CARLO may fall back on the AlphaBetaSearch
+    if(strategy == MONTE_CARLO)
+        monteCarlo.reserve();
+    else if(strategy == ALPHA_BETA || moveTime > 0)
+        alphaBeta.reserve();
+}
+
+/*
+ *Description: Accessor function that returns the current Strategy
+ *Precondition: N/A
+ *Postcondition: The current Strategy is returned
+ */
+Computer::Strategy Computer::getStrategy() const
+{
+    return strategy;
+}
+
+/*
+ *Description: Converts a lower-case Strategy name("heuristic", "negamax", "table", "mcts", "alphabeta")
+ *             to a Strategy
+ *Precondition: N/A
+ *Postcondition: Returns false and leaves the Strategy unchanged if the name is unknown
+ */
+bool Computer::parseStrategy(string name, Strategy& result)
+{
+    for(int i = 0; i < STRATEGY_COUNT; i++)
+        if(name == getStrategyName(static_cast<Strategy>(i)))
+        {
+            result = static_cast<Strategy>(i);
+            return true;
+        }
+    return false;
+}
+
+/*
+ *Description: Returns the lower-case name of a Strategy, as accepted by parseStrategy
+ *Precondition: N/A
+ *Postcondition: A string is returned
+ */
+string Computer::getStrategyName(Strategy value)
+{
+    switch(value)
+    {
+        case NEGAMAX: return "negamax";
+        case TABLE: return "table";
+        case MONTE_CARLO: return "mcts";
+        case ALPHA_BETA: return "alphabeta";
+        default: return "heuristic";
+    }
+}
+
+/*
+ *Description: Makes chooseNextMove play the book's moves while the position is in the book
+ *Precondition: The book outlives its use by the Computer
+ *Postcondition: The book is consulted from the next move on
+ */
+void Computer::setOpeningBook(const OpeningBook* book)
+{
+    openingBook = book;
+}
+
+/*
+ *Description: Makes shallow ALPHA_BETA searches of boards of the network's size evaluate with the network
+ *Precondition: The network outlives its use by the Computer
+ *Postcondition: The network evaluates from the next move on; the search is reserved like setStrategy does
+ */
+void Computer::setNetwork(const NTupleNetwork* network)
+{
+    alphaBeta.setNetwork(network);
+    reserve();
+}
+
+/*
+ *Description: Accessor function to the search used by the MONTE_CARLO Strategy
+ *Precondition: N/A
+ *Postcondition: The Computer's MonteCarloSearch is returned
+ */
+MonteCarloSearch& Computer::getMonteCarloSearch()
+{
+    return monteCarlo;
+}
+
+/*
+ *Description: Accessor function to the search used by the ALPHA_BETA Strategy
+ *Precondition: N/A
+ *Postcondition: The Computer's AlphaBetaSearch is returned
+ */
+AlphaBetaSearch& Computer::getAlphaBetaSearch()
+{
+    return alphaBeta;
+}
+
+/*
+ *Description: Accessor function to the forced-win search the ALPHA_BETA Strategy runs first on large boards
+ *Precondition: N/A
+ *Postcondition: The Computer's ThreatSearch is returned
+ */
+ThreatSearch& Computer::getThreatSearch()
+{
+    return threatSearch;
+}
+
+/*
+ *Description: Returns the next move chosen by the rank-based rules over the WinningCombinations, where
+ *             the first string is the Computer's ID and the second its opponent's
+ *Precondition: N/A
+ *Postcondition: Computer's next Location is returned.
+ */
+Location Computer::chooseHeuristicMove(const GameBoard& board, string ownID, string opponentID)
 {
     
     //This function maintains which combinations are valid for use
-    //It calls 'checkValidity' function that decides whether a particular
-    //combination is valid.
-    updateCombinations(board);
+    //It records each new move in the combinations whose lines pass through it
+    heuristicLines = 0;
+    updateCombinations(board, ownID, opponentID);
+    
+    //'getHighestRankedLines' function returns the lines of the highest ranking winning combinations,
+    //which are read in place
+    const vector<int>& computerLines = getHighestRankedLines(computerRanks);
+    const vector<int>& playerLines = getHighestRankedLines(playerRanks);
     
-    //'getHighestRankedMoves' function returns the highest ranking winning combinations
-    //as vectors by accepting any set of winning moves
-    vector<WinningCombination> computerMoves = getHighestRankedMoves(computerWin);
-    vector<WinningCombination> playerMoves = getHighestRankedMoves(playerWin);
+    int computerSize = computerLines.size();
+    int playerSize = playerLines.size();
+    heuristicLines += computerSize + playerSize;
     
-    int computerSize = computerMoves.size();
-    int playerSize = playerMoves.size();
+    //A combination of rank 'threat' needs one more move to win(rank 2 on the classic board)
+    int threat = board.getGeometry().getWinLength() - 1;
     
     if(playerSize == 0) //The Player does not have any valid WinningCombinations(i.e. Player can NOT win the game)
     {
@@ -123,72 +597,63 @@ Location Computer::chooseNextMove(const GameBoard& board)
             //if player is out of moves, but computer
             //is not, then let computer randomly pick one of its highest ranking WinningCombinations
             //and advance it
-            return getNextLocation(computerMoves[rand() % computerSize]);
+            return getNextLocation(computerWin[computerLines[random.nextInt(computerSize)]]);
     }
     else //Player still has valid WinningCombinations(i.e. Player can still win the game)
     {
-        if(playerMoves[0].getRank() == 2)
+        if(playerWin[playerLines[0]].getRank() == threat)
         {
             //If player does have rank 2 WinningCombination
             //but computer has no moves left, then let computer just block that move
             if(computerSize == 0)
-                return getNextLocation(playerMoves[0]);
-            
+                return getNextLocation(playerWin[playerLines[0]]);
+           
            //If computer does have moves left, check to see if they rank 2 WinningCombination, and
            //play any WinningCombination for the win
-            if(computerMoves[0].getRank() == 2)
-                return getNextLocation(computerMoves[rand() % computerSize]);
+            if(computerWin[computerLines[0]].getRank() == threat)
+                return getNextLocation(computerWin[computerLines[random.nextInt(computerSize)]]);
             
             //If the computer's higest ranked moves are 1, then
             //play to block
-            if(computerMoves[0].getRank() == 1)
-                return getNextLocation(playerMoves[0]);
+            if(computerWin[computerLines[0]].getRank() >= 1)
+                return getNextLocation(playerWin[playerLines[0]]);
         }
-        if(playerMoves[0].getRank() == 1)
+        else if(playerWin[playerLines[0]].getRank() >= 1)
         {
             //If player does have high ranking moves and
             //but computer has no moves left, then let computer just block that move
             if(computerSize == 0)
-                return getNextLocation(playerMoves[0]);
+                return getNextLocation(playerWin[playerLines[0]]);
             
             //If computer does have moves left, check to see if they rank 2, and
             //return a rank 2 if possible
-            if(computerMoves[0].getRank() == 2)
-                return getNextLocation(computerMoves[rand() % computerSize]);
+            if(computerWin[computerLines[0]].getRank() == threat)
+                return getNextLocation(computerWin[computerLines[random.nextInt(computerSize)]]);
             
             //If the computer's higest ranked moves are 1, then
             //advance any random combination
-            if(computerMoves[0].getRank() == 1)
-                return getNextLocation(computerMoves[rand() % computerSize]);
+            if(computerWin[computerLines[0]].getRank() >= 1)
+                return getNextLocation(computerWin[computerLines[random.nextInt(computerSize)]]);
         }
     }
     return getRandomLocation(board);
-    
+
 }
 
 /*
- *Description: Returns a list of highest ranked WinningCombinations (see WinningCombination.h)
+ *Description: Returns the lines of the highest ranked valid WinningCombinations (see WinningCombination.h),
+ *             read from the maintained rank buckets without copying them
  *Precondition: N/A
- *Postcondition: Returned vector contains highest ranked WinningCombinations
+ *Postcondition: The returned list holds the indices of the highest ranked WinningCombinations; it is
+ *               empty if none is valid and only lasts until the RankedLines change
  */
-vector<WinningCombination> Computer:: getHighestRankedMoves(WinningCombination winningCombos[])
+const vector<int>& Computer::getHighestRankedLines(const RankedLines& ranks)
 {
-    int highestRank = winningCombos[0].getRank();
-    
-    //Find the highest rank
-    for(int i = 0; i < 8; i++)
-        if(winningCombos[i].getRank() > highestRank)
-            highestRank = winningCombos[i].getRank();
-    
-    vector<WinningCombination> combinations;
-    
-    //Add only the WinningCombinations with the highest rank
-    for(int i = 0; i < 8; i++)
-        if(winningCombos[i].getRank() == highestRank && winningCombos[i].getValidity())
-            combinations.push_back(winningCombos[i]);
-    
-    return combinations;
+    static const vector<int> noLines;
     
+    //Only valid WinningCombinations are ranked, so the top bucket is the answer
+    int highestRank = ranks.getHighestRank();
+    return highestRank < 0 ? noLines : ranks.getLines(highestRank);
 }
 
 /*
@@ -196,15 +661,14 @@ vector<WinningCombination> Computer:: getHighestRankedMoves(WinningCombination w
  *Precondition: The WinningCombination parameter must be an initialized WinningCombination
  *Postcondition: Location is returned of the next unoccupied position of WinningCombination
  */
-Location Computer:: getNextLocation( WinningCombination& winningCombo)
+Location Computer:: getNextLocation(const WinningCombination& winningCombo)
 {
-    Location temp;
-    //Access each of the passed WinningCombination's 3 locations and returned the first unused location
-    for(int i = 0; i < 3; i++)
+    //Access each of the passed WinningCombination's locations and returned the first unused location
+    const vector<Location>& locations = winningCombo.getLocationSet();
+    for(size_t i = 0; i < locations.size(); i++)
     {
-        temp =(winningCombo.getLocationSet())[i];
-        if(temp.isUsed == false )
-            return temp;
+        if(locations[i].isUsed == false )
+            return locations[i];
     }
     return Location(0,0);
 }
@@ -214,7 +678,7 @@ Location Computer:: getNextLocation( WinningCombination& winningCombo)
  *Precondition: N/A
  *Postcondition: A pointer to the array consisting of Computer's possible WinningCombinations are returned
  */
-WinningCombination* Computer::getWinningCombinations()
+vector<WinningCombination>& Computer::getWinningCombinations()
 {
     return computerWin;
 }
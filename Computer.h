@@ -14,58 +14,301 @@
  
  Build with:    Compile with main.cpp. Written with Xcode on OS X 10.8.5.
  
- Modifications: N/A
+ Modifications: Added a selectable Strategy; NEGAMAX plays perfectly via NegamaxSearch.
+                TABLE plays perfectly from the compile-time SolvedTable.
+                WinningCombinations are generated from the board's BoardGeometry.
+                Line state is updated incrementally from the moves made since the last decision.
+                Random choices come from a per-Computer seedable Random instead of rand().
+                A Computer can choose moves for either ID.
+                Added the MONTE_CARLO Strategy, a parallel Monte Carlo tree search with a
+                playout or time budget that works on every board size.
+                The WinningCombinations are only generated when the HEURISTIC Strategy first
+                needs them, so constructing a Computer allocates nothing.
+                An OpeningBook, when set, is consulted before any Strategy.
+                Added the ALPHA_BETA Strategy, a depth-limited search over 64-bit masks for
+                boards of up to 64 cells such as the 4x4x4 cube.
+                ALPHA_BETA plays on boards of any size.
+                Added an anytime mode: with a deadline, or a move time, chooseNextMove deepens
+                its search until the deadline and answers with the best move found by then.
+                On boards of more than 64 cells ALPHA_BETA first looks for a forced win of
+                threats with a ThreatSearch.
+                Decisions can be recorded in an EngineStats.
+                Once a Computer has played a game on a board, its decisions on that board make
+                no heap allocations.
+                ALPHA_BETA can evaluate with a trained NTupleNetwork.
+                The searches are allocated when selected, before any deadline is running.
+                The OpeningBook is not consulted where the Strategy already plays perfectly.
+                setNetwork reserves the search as well.
+                Added newGame, so a game's moves do not depend on the games before it.
  ***********************************************************************************/
 
 #ifndef TicTacToe_Computer_h
 #define TicTacToe_Computer_h
 
 #include "WinningCombination.h"
+#include "AlphaBetaSearch.h"
+#include "BoardGeometry.h"
+#include "EngineStats.h"
 #include "Location.h"
 #include "GameBoard.h"
+#include "MonteCarloSearch.h"
+#include "NegamaxSearch.h"
+#include "OpeningBook.h"
+#include "Random.h"
+#include "RankedLines.h"
+#include "ThreatSearch.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
 #include <vector>
 using namespace std;
 
 
 class Computer{
-    
+
 public:
+    enum Strategy {
+        HEURISTIC, //Rank-based rules over the WinningCombinations(the original behavior)
+        NEGAMAX,   //Full-depth negamax search with alpha-beta pruning; never loses(classic board only)
+        TABLE,     //Single lookup in the compile-time SolvedTable; never loses(classic board only)
+        MONTE_CARLO, //Monte Carlo tree search within the MonteCarloSearch budget(any board size)
+        ALPHA_BETA //Alpha-beta search to the AlphaBetaSearch depth(any board size), after a ThreatSearch on
+                   //boards of more than ThreatSearch::LARGE_BOARD_CELLS cells
+    };
+    static const int STRATEGY_COUNT = ALPHA_BETA + 1; //Number of Strategy values
+    
     Computer();
     /*
-     *Description:  Constructor that initializes the member arrays with all the possible WinningCombinations.
-     *              The Computer will use these two arrays to keep track of all the possible ways it or the player
-     *              can win.
+     *Description:  Constructor of a Computer using the HEURISTIC Strategy. The member arrays with all the
+     *              possible WinningCombinations are generated from the board's geometry the first time the
+     *              HEURISTIC Strategy analyzes a board, and regenerated whenever a board of another size is
+     *              analyzed. The Computer will use these two arrays to keep track of all the possible ways
+     *              it or the player can win.
      *Precondition: N/A
-     *Postcondition: The computer has access to two arrays consisting of same set of all possible   WinningCombinations
+     *Postcondition: The computer is ready; no memory has been allocated
      */
     Location chooseNextMove(const GameBoard&);
     /*
-     *Description: Returns the Computers next move Location after analyzing the Board. For further detail
-     *             check the implementation(Computer.cpp)
+     *Description: Returns the Computers next move Location after analyzing the Board with the
+     *             current Strategy. Boards other than the classic 3x3 use the HEURISTIC Strategy
+     *             unless MONTE_CARLO or ALPHA_BETA is selected. With a move time set(see setMoveTime)
+     *             the move is chosen as by the deadline form below, the deadline being that far off.
      *Precondition: N/A
      *Postcondition: Computer's next Location is returned.
      */
-    WinningCombination* getWinningCombinations();
+    Location chooseNextMove(const GameBoard&, string);
     /*
-     *Description: Accessor function to the list of Computer's WinningCombinations
+     *Description: Returns the next move Location for the supplied ID('X' or 'O') after analyzing the Board
+     *             with the current Strategy. The opponent is the other ID. Lets one Computer play either
+     *             side, for instance in self-play.
+     *Precondition: N/A
+     *Postcondition: The next Location for the supplied ID is returned.
+     */
+    Location chooseNextMove(const GameBoard&, string, chrono::steady_clock::time_point);
+    /*
+     *Description: The anytime mode: returns the next move Location for the supplied ID by the supplied
+     *             deadline. MONTE_CARLO searches until the deadline(or its own budget) runs out; the
+     *             perfect NEGAMAX and TABLE Strategies answer at once on the classic board; every other
+     *             case runs the AlphaBetaSearch one depth deeper at a time and returns the best move of
+     *             the deepest search, abandoning the one in progress when the deadline passes. On large
+     *             boards the ThreatSearch gets the first half of the time.
+     *Precondition: The game is not over
+     *Postcondition: The next Location for the supplied ID is returned, within about a hundred
+     *               microseconds of running time after the deadline on boards of up to 15x15
+     */
+    void setMoveTime(double);
+    /*
+     *Description: Makes the forms of chooseNextMove without a deadline answer within the supplied number of
+     *             milliseconds using the anytime mode; 0 turns the anytime mode off
+     *Precondition: The time is non-negative
+     *Postcondition: The move time is updated and the search it selects is reserved(see reserve)
+     */
+    double getMoveTime() const;
+    /*
+     *Description: Accessor function that returns the move time in milliseconds, 0 if none is set
      *Precondition: N/A
-     *Postcondition: A pointer to the array consisting of Computer's possible WinningCombinations are returned
+     *Postcondition: The move time is returned
+     */
+    void setStats(EngineStats*);
+    /*
+     *Description: Makes every chooseNextMove record what it did(see EngineStats.h) in the supplied
+     *             statistics, which several Computers may share; 0 turns recording off
+     *Precondition: The statistics outlive the Computer or are replaced first
+     *Postcondition: Later decisions are recorded
+     */
+    EngineStats* getStats() const;
+    /*
+     *Description: Accessor function that returns the statistics decisions are recorded in, or 0
+     *Precondition: N/A
+     *Postcondition: A pointer is returned
+     */
+    void setSeed(uint64_t);
+    /*
+     *Description: Restarts the Computer's random choices from the supplied seed
+     *Precondition: N/A
+     *Postcondition: After newGame, the same seed and the same positions produce the same moves without a
+     *               deadline; otherwise the ALPHA_BETA Strategy still depends on the games searched before
+     */
+    void newGame();
+    /*
+     *Description: Forgets what the searches kept from earlier games: the transposition table and move
+     *             history of the AlphaBetaSearch
+     *Precondition: No decision is being made
+     *Postcondition: The next decisions depend only on the seed, the settings and the positions
+     */
+    void setStrategy(Strategy);
+    /*
+     *Description: Mutator function that selects how chooseNextMove picks its moves
+     *Precondition: N/A
+     *Postcondition: The 'strategy' is updated and its search reserved(see reserve).
+     */
+    void reserve();
+    /*
+     *Description: Allocates the transposition table of the AlphaBetaSearch, or the trees of the MonteCarloSearch,
+     *             that the next decision will use, so that a decision with a deadline does not spend its time
+     *             on them. setStrategy and setMoveTime call it; call it again after changing the search's
+     *             thread count or budget.
+     *Precondition: N/A
+     *Postcondition: The search is allocated; nothing is done for Strategies that search neither way
+     */
+    Strategy getStrategy() const;
+    /*
+     *Description: Accessor function that returns the current Strategy
+     *Precondition: N/A
+     *Postcondition: The current Strategy is returned
+     */
+    static bool parseStrategy(string, Strategy&);
+    /*
+     *Description: Converts a lower-case Strategy name("heuristic", "negamax", "table", "mcts", "alphabeta")
+     *             to a Strategy
+     *Precondition: N/A
+     *Postcondition: Returns false and leaves the Strategy unchanged if the name is unknown
+     */
+    static string getStrategyName(Strategy);
+    /*
+     *Description: Returns the lower-case name of a Strategy, as accepted by parseStrategy
+     *Precondition: N/A
+     *Postcondition: A string is returned
+     */
+    void setOpeningBook(const OpeningBook*);
+    /*
+     *Description: Makes chooseNextMove play the book's moves while the position is in the book, unless the
+     *             Strategy already plays perfectly(see playsPerfectly); a null pointer turns the book off
+     *Precondition: The book outlives its use by the Computer; one book may be shared by many Computers
+     *Postcondition: The book is consulted from the next move on
+     */
+    
+    void setNetwork(const NTupleNetwork*);
+    /*
+     *Description: Makes the ALPHA_BETA Strategy evaluate the positions of boards of the network's size with
+     *             it instead of the fixed line weights when it searches no deeper than
+     *             AlphaBetaSearch::NETWORK_MAX_DEPTH without a deadline; a null pointer turns the network off
+     *Precondition: The network outlives its use by the Computer; one network may be shared by many Computers
+     *Postcondition: The network evaluates from the next move on; the search it selects is reserved
      */
     
+    MonteCarloSearch& getMonteCarloSearch();
+    /*
+     *Description: Accessor function to the search used by the MONTE_CARLO Strategy, for setting its
+     *             playout or time budget, thread count and mode
+     *Precondition: N/A
+     *Postcondition: The Computer's MonteCarloSearch is returned
+     */
+    
+    AlphaBetaSearch& getAlphaBetaSearch();
+    /*
+     *Description: Accessor function to the search used by the ALPHA_BETA Strategy, for setting its depth
+     *Precondition: N/A
+     *Postcondition: The Computer's AlphaBetaSearch is returned
+     */
+    
+    ThreatSearch& getThreatSearch();
+    /*
+     *Description: Accessor function to the forced-win search the ALPHA_BETA Strategy runs first on large
+     *             boards, for setting its node limit
+     *Precondition: N/A
+     *Postcondition: The Computer's ThreatSearch is returned
+     */
+    
+    vector<WinningCombination>& getWinningCombinations();
+    /*
+     *Description: Accessor function to the list of Computer's WinningCombinations
+     *Precondition: N/A(the list is empty until the HEURISTIC Strategy has analyzed a board)
+     *Postcondition: The array consisting of Computer's possible WinningCombinations is returned
+     */
+    
+    friend class Benchmark; //Measures private steps in isolation(see Benchmark.h)
+
 private:
-    void updateCombinations(const GameBoard& board);
+    Location decide(const GameBoard&, string);
+    Location decide(const GameBoard&, string, chrono::steady_clock::time_point);
+    /*
+     *Description: The two forms of chooseNextMove with a supplied ID, without recording the decision
+     *Precondition: Same as chooseNextMove
+     *Postcondition: Same as chooseNextMove; 'lastPath' names the part of the engine that chose the move
+     */
+    void recordDecision(const GameBoard&, chrono::steady_clock::time_point, long);
+    /*
+     *Description: Records the decision just made on the supplied board in 'stats', given the time it
+     *             started and the allocation count then
+     *Precondition: 'stats' is set and the decision was made by decide
+     *Postcondition: The decision is recorded
+     */
+    bool playsPerfectly(const GameBoard&) const;
+    /*
+     *Description: Returns true if the Strategy plays perfectly on the supplied board by itself, as NEGAMAX
+     *             and TABLE do on the classic board; no book can improve on it there
+     *Precondition: N/A
+     *Postcondition: A boolean value is returned
+     */
+    Location chooseStrategyMove(const GameBoard&, string);
+    /*
+     *Description: Returns the next move for the supplied ID chosen by the current Strategy without a deadline
+     *Precondition: N/A
+     *Postcondition: The next Location for the supplied ID is returned.
+     */
+    Location chooseHeuristicMove(const GameBoard&, string, string);
+    /*
+     *Description: Returns the next move chosen by the rank-based rules over the WinningCombinations, where
+     *             the first string is the Computer's ID and the second its opponent's
+     *Precondition: N/A
+     *Postcondition: Computer's next Location is returned.
+     */
+    void buildCombinations(const BoardGeometry&);
+    /*
+     *Description: Rebuilds both arrays of WinningCombinations from the winning lines of the supplied geometry
+     *Precondition: N/A
+     *Postcondition: computerWin and playerWin hold one WinningCombination per winning line, all valid with rank 0
+     */
+    void resetCombinations();
+    /*
+     *Description: Returns every WinningCombination to its empty-board state
+     *Precondition: computerWin and playerWin match lineGeometry
+     *Postcondition: All WinningCombinations are valid with rank 0 and no move has been recorded
+     */
+    void updateCombinations(const GameBoard& board, string, string);
     /*
-     *Description: Updates the validity of all the WinningCombination by calling each WinningCombination's
-     *             checkValidity(see WinningCombination.h) function.
+     *Description: Brings the WinningCombinations up to date with the board, where the first string is the
+     *             Computer's ID and the second its opponent's. Only the moves made since the previous call
+     *             are applied, and each one only touches the lines through its cell. The state is rebuilt
+     *             from scratch when the board is of another size, belongs to a new game or the IDs have changed.
      *Precondition: N/A
      *Postcondition: All the WinningCombinations are appropriately marked as valid or invalid. Consquently,
      *               computer 'knows' which of its or the Player's WinningCombinations to consider when attempting    to win or defend.
      */
-    vector<WinningCombination> getHighestRankedMoves(WinningCombination[]);
+    void applyMove(int, string, bool);
+    /*
+     *Description: Records one move in the WinningCombinations of the lines that pass through its cell
+     *Precondition: The cell lies on the board of lineGeometry
+     *Postcondition: The mover's lines advance in rank and the other side's lines become invalid
+     */
+    const vector<int>& getHighestRankedLines(const RankedLines&);
     /*
-     *Description: Returns a list of highest ranked WinningCombinations (see WinningCombination.h)
+     *Description: Returns the lines of the highest ranked valid WinningCombinations (see WinningCombination.h),
+     *             read from the maintained rank buckets without copying them
      *Precondition: N/A
-     *Postcondition: Returned vector contains highest ranked WinningCombinations
+     *Postcondition: The returned list holds the indices of the highest ranked WinningCombinations; it is
+     *               empty if none is valid and only lasts until the RankedLines change
      */
     Location getRandomLocation(const GameBoard&);
     /*
@@ -73,15 +316,32 @@ private:
      *Precondition: N/A
      *Postcondition: A random location is returned
      */
-    Location getNextLocation( WinningCombination&);
+    Location getNextLocation(const WinningCombination&);
     /*
      *Description: Returns the next position necessay to advance the rank of a WinningCombination
      *Precondition: The WinningCombination parameter must be an initialized WinningCombination
      *Postcondition: Location is returned of the next unoccupied position of WinningCombination
      */
     
-    WinningCombination computerWin[8]; //An array to hold Computer's possible WinningCombinations
-    WinningCombination playerWin[8]; //An array to hold Player's possible WinningCombinations    
-    
+    vector<WinningCombination> computerWin; //An array to hold Computer's possible WinningCombinations
+    vector<WinningCombination> playerWin; //An array to hold Player's possible WinningCombinations
+    const BoardGeometry* lineGeometry; //Geometry the WinningCombinations were generated for
+    RankedLines computerRanks; //Computer's valid WinningCombinations grouped by rank
+    RankedLines playerRanks; //Player's valid WinningCombinations grouped by rank
+    CellMask knownComputerMask; //Computer moves already recorded in the WinningCombinations
+    CellMask knownPlayerMask; //Player moves already recorded in the WinningCombinations
+    string knownComputerID; //Computer ID the WinningCombinations were recorded for
+    Strategy strategy; //How the next move is chosen
+    NegamaxSearch negamax; //Search used by the NEGAMAX Strategy
+    MonteCarloSearch monteCarlo; //Search used by the MONTE_CARLO Strategy
+    AlphaBetaSearch alphaBeta; //Search used by the ALPHA_BETA Strategy
+    ThreatSearch threatSearch; //Forced-win search run before alphaBeta on large boards
+    Random random; //Source of the Computer's random choices
+    const OpeningBook* openingBook; //Book consulted before the Strategy, or 0
+    double moveTime; //Milliseconds per move of the anytime mode, or 0
+    EngineStats* stats; //Where decisions are recorded, or 0
+    EngineStats::Path lastPath; //Part of the engine that chose the latest move
+    long heuristicLines; //WinningCombinations updated or ranked by the latest HEURISTIC decision
+
 };
 #endif
@@ -0,0 +1,205 @@
+/************************************************************************************
+ Title:         ConsoleGame.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of ConsoleGame.h. The interactive console front end
+                of the game.
+ 
+ Purpose:       Provides functionality to ask the user for their symbol and moves, draw
+                the game board and announce the result, while a GameBoard and a
+                Computer do the actual work.
+ 
+ Usage:         ConsoleGame game; game.play();
+ 
+ Build with:    Compile with main.cpp.
+ 
+ Modifications: Boards of any BoardGeometry can be played.
+                The layers of a cube are drawn one below the other and the Computer searches them
+                with the ALPHA_BETA Strategy.
+ ***********************************************************************************/
+
+#include "ConsoleGame.h"
+#include <limits>
+using namespace std;
+
+/*
+ *Description: Constructor that binds a classic 3x3 game to the supplied input and output streams
+ *Precondition: N/A
+ *Postcondition: A fresh GameBoard and Computer are ready to play
+ */
+ConsoleGame::ConsoleGame(istream& input, ostream& output) : in(input), out(output)
+{
+}
+
+/*
+ *Description: Constructor that binds a game of the supplied geometry to the supplied input and
+ *             output streams. On a layered board the Computer uses the ALPHA_BETA Strategy.
+ *Precondition: The BoardGeometry outlives the ConsoleGame
+ *Postcondition: A fresh GameBoard and Computer are ready to play
+ */
+ConsoleGame::ConsoleGame(const BoardGeometry& geometry, istream& input, ostream& output)
+    : in(input), out(output), gameBoard(geometry)
+{
+    //The rank-based rules only look at single lines, which is far too weak on a cube
+    if(geometry.getLayerCount() > 1)
+        cpu.setStrategy(Computer::ALPHA_BETA);
+}
+
+/*
+ *Description: Runs one complete game: asks for the Player's symbol and whether they go first,
+ *             then alternates Player and Computer moves until the game is over.
+ *Precondition: N/A
+ *Postcondition: The result of the game is displayed
+ */
+void ConsoleGame::play()
+{
+    char ans = 'n';
+    
+    drawBoard();
+    
+    //Asks user whether they like 'X' or 'O'
+    setPlayerID();
+    
+    //Asks user if they want the first move
+    out << "Would you like to go first(y/n): ";
+    in >> ans;
+    
+    if((ans == 'y' || ans == 'Y') && !playPlayerMove())
+        return;
+    
+    while(!gameBoard.getGameStatus())
+    {
+        playComputerMove();
+        
+        if(!gameBoard.getGameStatus() && !playPlayerMove())
+            return;
+    }
+    //Display the result of the game Player, Computer, or Tie
+    displayGameStatus();
+}
+
+/*
+ *Description: Provides a visual representation of the current game
+ *Precondition: N/A
+ *Postcondition: The game board drawn in the User's output
+ */
+void ConsoleGame::drawBoard()
+{
+    const BoardGeometry& geometry = gameBoard.getGeometry();
+    string separator(geometry.getWidth() * 6, '-');
+    
+    out << endl;
+    
+    for(int i = 0; i < geometry.getRowCount(); i++){
+        
+        //Rows are numbered through all layers, so each layer starts where the previous one ended
+        if(geometry.getLayerCount() > 1 && i % geometry.getHeight() == 0)
+        {
+            if(i > 0)
+                out << separator << endl << endl;
+            out << "Layer " << i / geometry.getHeight() << "(rows " << i << "-" << i + geometry.getHeight() - 1
+                << "):" << endl;
+        }
+        out << separator << endl;
+        
+        for(int j = 0; j < geometry.getWidth(); j++)
+        {
+            out << gameBoard.getLocationId(i, j) << "  |   ";
+        }
+        
+        out << endl;
+    }
+    out << separator << endl;
+}
+
+/*
+ *Description: Displays game terminating message indicating who won
+ *             or whether the game is a tie.
+ *Precondition: N/A
+ *Postcondition: Appropriate message is displayed on game status.
+ */
+void ConsoleGame::displayGameStatus()
+{
+    if(gameBoard.hasPlayerWon())
+        out << "\n***The PLAYER won !***" << endl;
+    if(gameBoard.hasComputerWon())
+        out << "\n***The COMPUTER won !***" << endl;
+    if(gameBoard.isTie())
+        out << "\n***The game is a TIE!***" << endl;
+}
+
+/*
+ *Description: Gives player the option to use whichever ID(either 'X' or 'O') for their play and then update
+ *             Computer ID accordingly.
+ *Precondition: N/A
+ *Postcondition: The board's Player and Computer IDs are initialized appropriately
+ */
+void ConsoleGame::setPlayerID()
+{
+    int ans = 1;
+    out << "Please select which symbol to use(1.'X' 2.'O'): ";
+    in >> ans;
+    
+    gameBoard.setPlayerID(ans == 2 ? "O" : "X");
+}
+
+/*
+ *Description: Provided the game is still active, inputs the Player's next move.
+ *Precondition: The game is not over.
+ *Postcondition: Returns false if the input stream is exhausted; otherwise the Location
+ *               parameter holds the Player's next move.
+ */
+bool ConsoleGame::getPlayerMove(Location& nextMove)
+{
+    out << "\nPlease enter next move[Ex. 1 1 ]: ";
+    in >> nextMove.x >> nextMove.y;
+    
+    if(in.eof() || in.bad())
+        return false;
+    
+    //Discard non-numeric input so the Player can try again
+    if(in.fail())
+    {
+        in.clear();
+        in.ignore(numeric_limits<streamsize>::max(), '\n');
+        nextMove = Location(-1, -1);
+    }
+    return true;
+}
+
+/*
+ *Description: Asks for Player moves until a legal one is entered, applies it and draws the board
+ *Precondition: The game is not over.
+ *Postcondition: Returns false if the input stream is exhausted before a legal move was entered
+ */
+bool ConsoleGame::playPlayerMove()
+{
+    Location player; //Holds Player's moves
+    
+    while(getPlayerMove(player))
+    {
+        if(gameBoard.makeMove(player, gameBoard.getPlayerID()))
+        {
+            out << "\nYour move:\n ";
+            drawBoard();
+            return true;
+        }
+        out << "Location entered was invalid !" << endl;
+    }
+    return false;
+}
+
+/*
+ *Description: Lets the Computer choose its move, applies it and draws the board
+ *Precondition: The game is not over.
+ *Postcondition: The Computer's move is on the board
+ */
+void ConsoleGame::playComputerMove()
+{
+    gameBoard.makeMove(cpu.chooseNextMove(gameBoard), gameBoard.getComputerID());
+    out << "\nComputer made move:\n ";
+    drawBoard();
+}
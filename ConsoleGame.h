@@ -0,0 +1,112 @@
+/************************************************************************************
+ Title:         ConsoleGame.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The interactive console front end of the game. All prompts, board
+                drawings and game messages live here so that GameBoard and Computer
+                stay free of console I/O.
+ 
+ Purpose:       Provides functionality to ask the user for their symbol and moves, draw
+                the game board and announce the result, while a GameBoard and a
+                Computer do the actual work.
+ 
+ Usage:         ConsoleGame game; game.play();
+                Streams default to cin/cout but any istream/ostream can be supplied.
+                ConsoleGame game(BoardGeometry::get(w, h, k)); plays on another board size.
+ 
+ Build with:    Compile with main.cpp.
+ 
+ Modifications: Boards of any BoardGeometry can be played.
+                Layered boards are played with the ALPHA_BETA Strategy.
+ ***********************************************************************************/
+
+#ifndef TicTacToe_ConsoleGame_h
+#define TicTacToe_ConsoleGame_h
+
+#include "Computer.h"
+#include "GameBoard.h"
+#include "Location.h"
+#include <iostream>
+using namespace std;
+
+class ConsoleGame {
+
+public:
+    ConsoleGame(istream& input = cin, ostream& output = cout);
+    /*
+     *Description: Constructor that binds a classic 3x3 game to the supplied input and output streams
+     *Precondition: N/A
+     *Postcondition: A fresh GameBoard and Computer are ready to play
+     */
+    
+    ConsoleGame(const BoardGeometry&, istream& input = cin, ostream& output = cout);
+    /*
+     *Description: Constructor that binds a game of the supplied geometry to the supplied input and
+     *             output streams. On a layered board the Computer uses the ALPHA_BETA Strategy.
+     *Precondition: The BoardGeometry outlives the ConsoleGame
+     *Postcondition: A fresh GameBoard and Computer are ready to play
+     */
+    
+    void play();
+    /*
+     *Description: Runs one complete game: asks for the Player's symbol and whether they go first,
+     *             then alternates Player and Computer moves until the game is over.
+     *Precondition: N/A
+     *Postcondition: The result of the game is displayed
+     */
+    
+    void drawBoard();
+    /*
+     *Description: Provides a visual representation of the current game
+     *Precondition: N/A
+     *Postcondition: The game board drawn in the User's output
+     */
+    
+    void displayGameStatus();
+    /*
+     *Description: Displays game terminating message indicating who won
+     *             or whether the game is a tie.
+     *Precondition: N/A
+     *Postcondition: Appropriate message is displayed on game status.
+     */
+
+private:
+    void setPlayerID();
+    /*
+     *Description: Gives player the option to use whichever ID(either 'X' or 'O') for their play and then update
+     *             Computer ID accordingly.
+     *Precondition: N/A
+     *Postcondition: The board's Player and Computer IDs are initialized appropriately
+     */
+    
+    bool getPlayerMove(Location&);
+    /*
+     *Description: Provided the game is still active, inputs the Player's next move.
+     *Precondition: The game is not over.
+     *Postcondition: Returns false if the input stream is exhausted; otherwise the Location
+     *               parameter holds the Player's next move.
+     */
+    
+    bool playPlayerMove();
+    /*
+     *Description: Asks for Player moves until a legal one is entered, applies it and draws the board
+     *Precondition: The game is not over.
+     *Postcondition: Returns false if the input stream is exhausted before a legal move was entered
+     */
+    
+    void playComputerMove();
+    /*
+     *Description: Lets the Computer choose its move, applies it and draws the board
+     *Precondition: The game is not over.
+     *Postcondition: The Computer's move is on the board
+     */
+    
+    istream& in; //Stream the user's answers are read from
+    ostream& out; //Stream prompts and drawings are written to
+    GameBoard gameBoard; //The board of the current game
+    Computer cpu; //The Computer opponent
+};
+#endif
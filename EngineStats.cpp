@@ -0,0 +1,308 @@
+/************************************************************************************
+ Title:         EngineStats.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of EngineStats.h. A latency below SUB_BUCKETS
+                nanoseconds has a bucket of its own; above that, every power of two is
+                split into SUB_BUCKETS equal buckets.
+ 
+ Purpose:       Records and reports the Computer's move decisions.
+ 
+ Usage:         stats.record(decision, board); stats.toJson(); stats.toText();
+ 
+ Build with:    Compile with main.cpp.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#include "EngineStats.h"
+#include <algorithm>
+#include <cstdio>
+using namespace std;
+
+//Returns the number of heap allocations made so far, or 0 if they are not counted
+static long (*allocationCounter)() = 0;
+
+/*
+ *Description: Formats a number of nanoseconds as milliseconds
+ *Precondition: N/A
+ *Postcondition: A string is returned
+ */
+static string formatMilliseconds(double nanoseconds)
+{
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.3f", nanoseconds / 1e6);
+    return buffer;
+}
+
+/*
+ *Description: Constructor of empty statistics with no latency budget
+ *Precondition: N/A
+ *Postcondition: No decision is recorded
+ */
+EngineStats::EngineStats()
+    : decisions(0), nodes(0), linesEvaluated(0), cacheHits(0), cacheMisses(0), allocations(0), nanoseconds(0),
+      slowest(0), overBudget(0), budget(0), nextSlow(0)
+{
+    for(int path = 0; path < PATH_COUNT; path++)
+        pathCounts[path].store(0, memory_order_relaxed);
+    for(int bucket = 0; bucket < BUCKET_COUNT; bucket++)
+        buckets[bucket].store(0, memory_order_relaxed);
+}
+
+/*
+ *Description: Adds a decision made on the supplied board. Safe to call from several threads.
+ *Precondition: N/A
+ *Postcondition: The sums and the histogram include the decision; a decision over budget is kept
+ */
+void EngineStats::record(const Decision& decision, const GameBoard& board)
+{
+    decisions.fetch_add(1, memory_order_relaxed);
+    nodes.fetch_add(decision.nodes, memory_order_relaxed);
+    linesEvaluated.fetch_add(decision.linesEvaluated, memory_order_relaxed);
+    cacheHits.fetch_add(decision.cacheHits, memory_order_relaxed);
+    cacheMisses.fetch_add(decision.cacheMisses, memory_order_relaxed);
+    if(decision.allocations > 0)
+        allocations.fetch_add(decision.allocations, memory_order_relaxed);
+    nanoseconds.fetch_add(decision.nanoseconds, memory_order_relaxed);
+    pathCounts[decision.path].fetch_add(1, memory_order_relaxed);
+    buckets[getBucket(decision.nanoseconds)].fetch_add(1, memory_order_relaxed);
+    
+    long previous = slowest.load(memory_order_relaxed);
+    while(decision.nanoseconds > previous
+          && !slowest.compare_exchange_weak(previous, decision.nanoseconds, memory_order_relaxed))
+    {
+    }
+    
+    long limit = budget.load(memory_order_relaxed);
+    if(limit <= 0 || decision.nanoseconds <= limit)
+        return;
+    overBudget.fetch_add(1, memory_order_relaxed);
+    
+    SlowDecision slow;
+    slow.decision = decision;
+    const CellMask& xMask = board.getMask(0);
+    const CellMask& oMask = board.getMask(1);
+    slow.board.assign(board.getGeometry().getCellCount(), '.');
+    for(int cell = 0; cell < board.getGeometry().getCellCount(); cell++)
+    {
+        if(xMask.test(cell))
+            slow.board[cell] = 'X';
+        else if(oMask.test(cell))
+            slow.board[cell] = 'O';
+    }
+    
+    lock_guard<mutex> guard(slowLock);
+    if(static_cast<int>(slowDecisions.size()) < SLOW_DECISION_COUNT)
+        slowDecisions.push_back(slow);
+    else
+    {
+        slowDecisions[nextSlow] = slow;
+        nextSlow = (nextSlow + 1) % SLOW_DECISION_COUNT;
+    }
+}
+
+/*
+ *Description: Sets the number of milliseconds beyond which a decision is kept with its board
+ *Precondition: The budget is non-negative
+ *Postcondition: Later decisions are compared with the budget
+ */
+void EngineStats::setLatencyBudget(double milliseconds)
+{
+    budget.store(static_cast<long>(milliseconds * 1e6), memory_order_relaxed);
+}
+
+/*
+ *Description: Accessor function that returns the number of decisions recorded
+ *Precondition: N/A
+ *Postcondition: A non-negative count is returned
+ */
+long EngineStats::getDecisionCount() const
+{
+    return decisions.load(memory_order_relaxed);
+}
+
+/*
+ *Description: Returns the latency, in nanoseconds, that the supplied fraction of the decisions did not exceed
+ *Precondition: 0 <= fraction <= 1
+ *Postcondition: A latency is returned; 0 if nothing is recorded
+ */
+long EngineStats::getPercentile(double fraction) const
+{
+    long counts[BUCKET_COUNT];
+    long total = 0;
+    for(int bucket = 0; bucket < BUCKET_COUNT; bucket++)
+    {
+        counts[bucket] = buckets[bucket].load(memory_order_relaxed);
+        total += counts[bucket];
+    }
+    if(total == 0)
+        return 0;
+    
+    //The decision of that rank, counting from 1
+    long rank = max(1L, static_cast<long>(fraction * total + 0.999999));
+    long seen = 0;
+    for(int bucket = 0; bucket < BUCKET_COUNT; bucket++)
+    {
+        seen += counts[bucket];
+        if(seen >= rank)
+            return min(getBucketEnd(bucket), slowest.load(memory_order_relaxed));
+    }
+    return slowest.load(memory_order_relaxed);
+}
+
+/*
+ *Description: Formats the statistics as one line of JSON
+ *Precondition: N/A
+ *Postcondition: A string without line breaks is returned
+ */
+string EngineStats::toJson() const
+{
+    long count = getDecisionCount();
+    string json = "{\"decisions\":" + to_string(count);
+    json += ",\"latency_ms\":{\"p50\":" + formatMilliseconds(getPercentile(0.5));
+    json += ",\"p99\":" + formatMilliseconds(getPercentile(0.99));
+    json += ",\"p999\":" + formatMilliseconds(getPercentile(0.999));
+    json += ",\"max\":" + formatMilliseconds(slowest.load(memory_order_relaxed));
+    json += ",\"mean\":" + formatMilliseconds(count ? static_cast<double>(nanoseconds.load(memory_order_relaxed)) / count : 0);
+    json += "},\"nodes\":" + to_string(nodes.load(memory_order_relaxed));
+    json += ",\"lines_evaluated\":" + to_string(linesEvaluated.load(memory_order_relaxed));
+    json += ",\"cache_hits\":" + to_string(cacheHits.load(memory_order_relaxed));
+    json += ",\"cache_misses\":" + to_string(cacheMisses.load(memory_order_relaxed));
+    json += ",\"allocations\":" + (allocationCounter ? to_string(allocations.load(memory_order_relaxed)) : string("null"));
+    json += ",\"paths\":{";
+    for(int path = 0; path < PATH_COUNT; path++)
+        json += (path ? ",\"" : "\"") + getPathName(static_cast<Path>(path)) + "\":"
+                + to_string(pathCounts[path].load(memory_order_relaxed));
+    json += "},\"budget_ms\":" + formatMilliseconds(budget.load(memory_order_relaxed));
+    json += ",\"over_budget\":" + to_string(overBudget.load(memory_order_relaxed));
+    json += ",\"slow\":[";
+    
+    lock_guard<mutex> guard(slowLock);
+    for(size_t i = 0; i < slowDecisions.size(); i++)
+    {
+        const Decision& decision = slowDecisions[i].decision;
+        json += i ? ",{" : "{";
+        json += "\"ms\":" + formatMilliseconds(decision.nanoseconds);
+        json += ",\"path\":\"" + getPathName(decision.path) + "\"";
+        json += ",\"nodes\":" + to_string(decision.nodes);
+        json += ",\"lines_evaluated\":" + to_string(decision.linesEvaluated);
+        json += ",\"cache_hits\":" + to_string(decision.cacheHits);
+        json += ",\"cache_misses\":" + to_string(decision.cacheMisses);
+        json += ",\"allocations\":" + (decision.allocations >= 0 ? to_string(decision.allocations) : string("null"));
+        json += ",\"board\":\"" + slowDecisions[i].board + "\"}";
+    }
+    json += "]}";
+    return json;
+}
+
+/*
+ *Description: Formats the statistics as lines of text
+ *Precondition: N/A
+ *Postcondition: A string ending in a line break is returned
+ */
+string EngineStats::toText() const
+{
+    long count = getDecisionCount();
+    string text = "decisions " + to_string(count);
+    text += "  latency ms p50 " + formatMilliseconds(getPercentile(0.5));
+    text += "  p99 " + formatMilliseconds(getPercentile(0.99));
+    text += "  p999 " + formatMilliseconds(getPercentile(0.999));
+    text += "  max " + formatMilliseconds(slowest.load(memory_order_relaxed));
+    text += "  mean " + formatMilliseconds(count ? static_cast<double>(nanoseconds.load(memory_order_relaxed)) / count : 0);
+    text += "\nnodes " + to_string(nodes.load(memory_order_relaxed));
+    text += "  lines evaluated " + to_string(linesEvaluated.load(memory_order_relaxed));
+    text += "  cache hits " + to_string(cacheHits.load(memory_order_relaxed));
+    text += "  misses " + to_string(cacheMisses.load(memory_order_relaxed));
+    text += "  allocations " + (allocationCounter ? to_string(allocations.load(memory_order_relaxed)) : string("-"));
+    text += "\npaths";
+    for(int path = 0; path < PATH_COUNT; path++)
+        text += " " + getPathName(static_cast<Path>(path)) + " " + to_string(pathCounts[path].load(memory_order_relaxed));
+    text += "\nover budget(" + formatMilliseconds(budget.load(memory_order_relaxed)) + " ms) "
+            + to_string(overBudget.load(memory_order_relaxed)) + "\n";
+    
+    lock_guard<mutex> guard(slowLock);
+    for(size_t i = 0; i < slowDecisions.size(); i++)
+    {
+        const Decision& decision = slowDecisions[i].decision;
+        text += "  " + formatMilliseconds(decision.nanoseconds) + " ms " + getPathName(decision.path);
+        text += " nodes " + to_string(decision.nodes) + " lines " + to_string(decision.linesEvaluated);
+        text += " hits " + to_string(decision.cacheHits) + " misses " + to_string(decision.cacheMisses);
+        text += " allocations " + (decision.allocations >= 0 ? to_string(decision.allocations) : string("-"));
+        text += " board " + slowDecisions[i].board + "\n";
+    }
+    return text;
+}
+
+/*
+ *Description: Installs the function that returns the number of heap allocations made so far
+ *Precondition: No decision is being recorded
+ *Postcondition: countAllocations uses the function
+ */
+void EngineStats::setAllocationCounter(long (*counter)())
+{
+    allocationCounter = counter;
+}
+
+/*
+ *Description: Returns the number of heap allocations made so far
+ *Precondition: N/A
+ *Postcondition: Returns -1 if no allocation counter is installed
+ */
+long EngineStats::countAllocations()
+{
+    return allocationCounter ? allocationCounter() : -1;
+}
+
+/*
+ *Description: Returns the lower-case name of a Path
+ *Precondition: N/A
+ *Postcondition: A string is returned
+ */
+string EngineStats::getPathName(Path path)
+{
+    switch(path)
+    {
+        case BOOK: return "book";
+        case TABLE: return "table";
+        case NEGAMAX: return "negamax";
+        case MONTE_CARLO: return "mcts";
+        case THREAT: return "threat";
+        case ALPHA_BETA: return "alphabeta";
+        default: return "heuristic";
+    }
+}
+
+/*
+ *Description: Returns the histogram bucket of a latency in nanoseconds
+ *Precondition: N/A
+ *Postcondition: An index between 0 and BUCKET_COUNT - 1 is returned
+ */
+int EngineStats::getBucket(long value)
+{
+    if(value < SUB_BUCKETS)
+        return static_cast<int>(max(value, 0L));
+    
+    //The top bit picks the power of two and the four bits below it the part of it
+    int top = 63 - __builtin_clzl(static_cast<unsigned long>(value));
+    int part = static_cast<int>(value >> (top - 4)) & (SUB_BUCKETS - 1);
+    return min(SUB_BUCKETS * (top - 3) + part, BUCKET_COUNT - 1);
+}
+
+/*
+ *Description: Returns the largest latency that falls into the supplied bucket
+ *Precondition: 0 <= bucket < BUCKET_COUNT
+ *Postcondition: A latency in nanoseconds is returned
+ */
+long EngineStats::getBucketEnd(int bucket)
+{
+    if(bucket < SUB_BUCKETS)
+        return bucket;
+    
+    int top = bucket / SUB_BUCKETS + 3;
+    long start = static_cast<long>(SUB_BUCKETS + bucket % SUB_BUCKETS) << (top - 4);
+    return start + (1L << (top - 4)) - 1;
+}
@@ -0,0 +1,189 @@
+/************************************************************************************
+ Title:         EngineStats.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   Statistics of the Computer's move decisions. Every decision reports which
+                part of the engine chose the move, the positions it searched, the winning
+                lines it read or updated, its transposition table hits and misses, its
+                heap allocations and its wall time. The counts are summed, the times go
+                into a latency histogram, and decisions slower than a latency budget are
+                kept together with their board.
+ 
+ Purpose:       Shows where the engine spends its time and which positions blow the
+                latency budget, and why. Several Computers on different threads may
+                record into one EngineStats: the sums and the histogram are relaxed
+                atomics and only a decision over budget takes a lock. A Computer with no
+                EngineStats set records nothing and pays nothing.
+ 
+ Usage:         EngineStats stats; stats.setLatencyBudget(5); //milliseconds
+                computer.setStats(&stats); ... computer.chooseNextMove(board, "X"); ...
+                cout << stats.toText(); //or stats.toJson(), one line
+                stats.getPercentile(0.99); //nanoseconds
+                The histogram has 16 buckets per power of two, so a percentile is exact
+                to within 1/16 of its value.
+ 
+ Build with:    Compile with main.cpp. Allocations are only counted in programs that link
+                AllocationCounter.cpp and call setAllocationCounter(AllocationCounter::getThreadCount).
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#ifndef TicTacToe_EngineStats_h
+#define TicTacToe_EngineStats_h
+
+#include "GameBoard.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+using namespace std;
+
+class EngineStats {
+
+public:
+    enum Path {
+        BOOK,        //The OpeningBook
+        TABLE,       //The SolvedTable
+        NEGAMAX,     //The NegamaxSearch
+        HEURISTIC,   //The rank-based rules over the WinningCombinations
+        MONTE_CARLO, //The MonteCarloSearch
+        THREAT,      //A forced win proved by the ThreatSearch
+        ALPHA_BETA   //The AlphaBetaSearch(after the ThreatSearch found no win on a large board)
+    };
+    static const int PATH_COUNT = ALPHA_BETA + 1; //Number of Path values
+    
+    //What one decision did
+    struct Decision {
+        Path path; //Part of the engine that chose the move
+        long nodes; //Positions searched(playouts for MONTE_CARLO)
+        long linesEvaluated; //Winning lines read or updated
+        long cacheHits; //Transposition table probes that found their position
+        long cacheMisses; //Probes that did not
+        long allocations; //Heap allocations, or -1 if they are not counted
+        long nanoseconds; //Wall time
+    };
+    
+    EngineStats();
+    /*
+     *Description: Constructor of empty statistics with no latency budget
+     *Precondition: N/A
+     *Postcondition: No decision is recorded
+     */
+    
+    void record(const Decision&, const GameBoard&);
+    /*
+     *Description: Adds a decision made on the supplied board. Safe to call from several threads.
+     *Precondition: N/A
+     *Postcondition: The sums and the histogram include the decision; if it took longer than the latency
+     *               budget it is kept with the board, replacing the oldest kept one when SLOW_DECISION_COUNT
+     *               are kept already
+     */
+    
+    void setLatencyBudget(double);
+    /*
+     *Description: Sets the number of milliseconds beyond which a decision is kept with its board; 0 keeps none
+     *Precondition: The budget is non-negative
+     *Postcondition: Later decisions are compared with the budget
+     */
+    
+    long getDecisionCount() const;
+    /*
+     *Description: Accessor function that returns the number of decisions recorded
+     *Precondition: N/A
+     *Postcondition: A non-negative count is returned
+     */
+    
+    long getPercentile(double) const;
+    /*
+     *Description: Returns the latency, in nanoseconds, that the supplied fraction(0.5 for the median) of the
+     *             decisions did not exceed
+     *Precondition: 0 <= fraction <= 1
+     *Postcondition: The upper end of the histogram bucket holding that decision, but no more than the
+     *               slowest decision, is returned; 0 if nothing is recorded
+     */
+    
+    string toJson() const;
+    /*
+     *Description: Formats the statistics as one line of JSON: the decision count, the latency percentiles
+     *             (p50, p99, p999, max and mean, in milliseconds), the sums, the decisions per Path, and
+     *             the decisions kept for exceeding the budget
+     *Precondition: N/A
+     *Postcondition: A string without line breaks is returned
+     */
+    
+    string toText() const;
+    /*
+     *Description: Formats the same statistics as lines of text
+     *Precondition: N/A
+     *Postcondition: A string ending in a line break is returned
+     */
+    
+    static void setAllocationCounter(long (*)());
+    /*
+     *Description: Installs the function that returns the number of heap allocations made so far, such as
+     *             AllocationCounter::getThreadCount; 0 stops allocations from being counted
+     *Precondition: No decision is being recorded
+     *Postcondition: countAllocations uses the function
+     */
+    
+    static long countAllocations();
+    /*
+     *Description: Returns the number of heap allocations made so far
+     *Precondition: N/A
+     *Postcondition: Returns -1 if no allocation counter is installed
+     */
+    
+    static string getPathName(Path);
+    /*
+     *Description: Returns the lower-case name of a Path
+     *Precondition: N/A
+     *Postcondition: A string is returned
+     */
+    
+    static const int SUB_BUCKETS = 16; //Histogram buckets per power of two
+    static const int BUCKET_COUNT = SUB_BUCKETS * 38; //Enough buckets for 2^41 nanoseconds(about 36 minutes)
+    static const int SLOW_DECISION_COUNT = 16; //Decisions over budget kept with their board
+
+private:
+    //A decision over the latency budget
+    struct SlowDecision {
+        Decision decision; //What it did
+        string board; //Its board, the cells row after row as X, O or '.'
+    };
+    
+    static int getBucket(long);
+    /*
+     *Description: Returns the histogram bucket of a latency in nanoseconds
+     *Precondition: N/A
+     *Postcondition: An index between 0 and BUCKET_COUNT - 1 is returned
+     */
+    
+    static long getBucketEnd(int);
+    /*
+     *Description: Returns the largest latency that falls into the supplied bucket
+     *Precondition: 0 <= bucket < BUCKET_COUNT
+     *Postcondition: A latency in nanoseconds is returned
+     */
+    
+    atomic<long> decisions; //Decisions recorded
+    atomic<long> nodes; //Sum of Decision::nodes
+    atomic<long> linesEvaluated; //Sum of Decision::linesEvaluated
+    atomic<long> cacheHits; //Sum of Decision::cacheHits
+    atomic<long> cacheMisses; //Sum of Decision::cacheMisses
+    atomic<long> allocations; //Sum of the Decision::allocations that were counted
+    atomic<long> nanoseconds; //Sum of Decision::nanoseconds
+    atomic<long> slowest; //Largest Decision::nanoseconds
+    atomic<long> overBudget; //Decisions slower than the budget
+    atomic<long> pathCounts[PATH_COUNT]; //Decisions made by each Path
+    atomic<long> buckets[BUCKET_COUNT]; //Latency histogram
+    atomic<long> budget; //Latency budget in nanoseconds, or 0
+    
+    mutable mutex slowLock; //Guards 'slowDecisions' and 'nextSlow'
+    vector<SlowDecision> slowDecisions; //The most recent decisions over budget
+    int nextSlow; //Entry of 'slowDecisions' replaced next once it is full
+};
+#endif
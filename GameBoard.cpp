@@ -6,103 +6,293 @@
  Created On:    February 16, 2014
  
  Description:   The implementation of GameBoard.h. A representation of the Tic-Tac-Toe
-                game board; A 3X3 two-dimensional array of Locations are used.
+                game board; two occupancy masks(one for 'X', one for 'O') are used. The board
+                may be any m,n,k size described by a BoardGeometry; the default is 3x3.
  
  Purpose:       Provides functionality to keep accurate records of Player/Computer
-                positions, drawing a visual representation of the game board, as well as methods
-                to advance and terminate an instance of a game.
+                positions as well as methods to advance and terminate an instance of a game.
+                GameBoard performs no console I/O; see ConsoleGame.h for the interactive front end.
  
  Usage:         An instance of GameBoard must be initialized to play the game.
  
  Build with:    Compile with main.cpp. Written with Xcode on OS X 10.8.5.
  
- Modifications: N/A
+ Modifications: Replaced the 3x3 array of Locations with two 9-bit occupancy masks.
+                Win, tie and vacancy checks are now mask comparisons.
+                Console I/O(drawing, prompts, messages) moved to ConsoleGame.
+                Board size and winning lines now come from a BoardGeometry.
+                Added getOtherID.
+                Moves and masks are addressed by side index; the string forms only convert the id.
  ***********************************************************************************/
 
 
 #include "GameBoard.h"
-#include <iostream>
 using namespace std;
 
 /*
- *Description: Constructor that initializes the GameBoard
+ *Description: Constructor that initializes a classic 3x3 GameBoard
  *Precondition: N/A
- *Postcondition: Each of the Locations of the GameBoard is initialized and the board is drawn
+ *Postcondition: Each of the Locations of the GameBoard is vacant
  */
-GameBoard::GameBoard()
+GameBoard::GameBoard() : GameBoard(BoardGeometry::classic())
+{
+}
+
+/*
+ *Description: Constructor that initializes a GameBoard of the supplied geometry
+ *Precondition: The BoardGeometry outlives the GameBoard(BoardGeometry::get always does)
+ *Postcondition: Each of the Locations of the GameBoard is vacant
+ */
+GameBoard::GameBoard(const BoardGeometry& boardGeometry) : playerSide(-1), computerSide(-1), geometry(&boardGeometry)
 {
     isGameOver = false;
-    //Initialize the Board by giving each Location its corresponding 3x3 matrix location
-    for(int i = 0; i < 3; i++)
-        for(int j = 0; j < 3; j++)
-        {
-            gameBoard[i][j].x = i;
-            gameBoard[i][j].y = j;
-        }
-    drawBoard();
+    playerWon = false;
+    computerWon = false;
+    tie = false;
+    for(int symmetry = 0; symmetry < Zobrist::MAX_SYMMETRIES; symmetry++)
+        hashes[symmetry] = 0;
+}
+
+/*
+ *Description: Accessor function for the size and winning lines of the board
+ *Precondition: N/A
+ *Postcondition: The board's BoardGeometry is returned
+ */
+const BoardGeometry& GameBoard::getGeometry() const
+{
+    return *geometry;
+}
+
+/*
+ *Description: Allows the supplied side(0 for 'X', 1 for 'O') to make a move to a Location on the
+ *             GameBoard provided the current game has not ended. Then checks to see if the game should
+ *             terminate via updateGameStatus(see below for description).
+ *Precondition: The Location must be initialized
+ *Error Checking: Inputed Location is validated to be on the board and not already occupied, and the
+ *                side to be 0 or 1.
+ *Postcondition: Returns true and records the move if it was legal; otherwise the board is unchanged
+ *               and false is returned.
+ */
+bool GameBoard::makeMove(const Location& loc, int side)
+{
+    if(isGameOver)
+        return false;
+    
+    if(!geometry->contains(loc.x, loc.y) || isUsed(loc.x, loc.y) || (side != 0 && side != 1))
+        return false;
+    
+    int cell = geometry->getCell(loc.x, loc.y);
+    if(side == 0)
+        xMask.set(cell);
+    else
+        oMask.set(cell);
+    for(int symmetry = 0; symmetry < geometry->getSymmetryCount(); symmetry++)
+        hashes[symmetry] ^= Zobrist::getKey(side, geometry->getSymmetry(symmetry)[cell]);
+    updateGameStatus(cell, side);
+    return true;
 }
 
 /*
- *Description: Allows player to make a move to a Location on the GameBoard provided the current game
- *             has not ended. Then checks to see if the game should terminate via updateGameStatus(see
- *             below for description). Also displays information regarding who made the move.
+ *Description: As above, for the side of the supplied id
  *Precondition: The Location must be initialized and string parameter must contain either 'X' or 'O'
- *Error Checking: Inputed Location is validated to see if it is already occupied.
- *Postcondition: locationID(see Location.h) is updated to either 'X' or 'O'.
+ *Error Checking: Same as above; any other id is rejected.
+ *Postcondition: Same as above
  */
-void GameBoard::makeMove(Location loc, string id)
+bool GameBoard::makeMove(const Location& loc, const string& id)
 {
-    if(!isGameOver)
-    {
-        if(!gameBoard[loc.x][loc.y].isUsed)
+    return makeMove(loc, getSide(id));
+}
+
+/*
+ *Description: Replaces the board with the supplied 'X' and 'O' occupancy masks and recomputes the hashes
+ *             and the game status
+ *Precondition: The masks do not overlap and only use cells of the board; the IDs are already set
+ *Postcondition: The board holds the supplied position and its status is up to date
+ */
+void GameBoard::setPosition(const CellMask& x, const CellMask& o)
+{
+    xMask = x;
+    oMask = o;
+    
+    for(int symmetry = 0; symmetry < Zobrist::MAX_SYMMETRIES; symmetry++)
+        hashes[symmetry] = 0;
+    for(int side = 0; side < 2; side++)
+        for(CellMask stones = (side == 0) ? xMask : oMask; stones.any(); )
         {
-            gameBoard[loc.x][loc.y].isUsed = true;
-            gameBoard[loc.x][loc.y].locationId = id;
-            updateGameStatus();
-            
-            if(id == computerID)
-                cout << "\nComputer made move:\n ";
-            else
-                cout << "\nYour move:\n ";
+            int cell = stones.popLowest();
+            for(int symmetry = 0; symmetry < geometry->getSymmetryCount(); symmetry++)
+                hashes[symmetry] ^= Zobrist::getKey(side, geometry->getSymmetry(symmetry)[cell]);
         }
-        else
-            cout << "Location entered was invalid !" << endl;
-    }
     
+    bool xWon = false;
+    bool oWon = false;
+    for(int line = 0; line < geometry->getLineCount(); line++)
+    {
+        xWon = xWon || geometry->getLine(line).isSubsetOf(xMask);
+        oWon = oWon || geometry->getLine(line).isSubsetOf(oMask);
+    }
+    playerWon = (playerSide == 0) ? xWon : oWon;
+    computerWon = (computerSide == 0) ? xWon : oWon;
+    tie = !playerWon && !computerWon && getEmptyCount() == 0;
+    isGameOver = playerWon || computerWon || tie;
+}
+
+/*
+ *Description: Accessor function that builds the Location at the supplied (x,y) coordinates
+ *Precondition: (x,y) lies on the board
+ *Postcondition: A Location with its isUsed and locationId filled in from the board is returned
+ */
+Location GameBoard::getLocation(int x, int y) const
+{
+    Location loc(x, y);
+    loc.isUsed = isUsed(x, y);
+    loc.locationId = getLocationId(x, y);
+    return loc;
 }
 
 /*
- *Description: Provides a visual representation of the current game
+ *Description: Returns whether the Location at the supplied (x,y) coordinates is occupied
+ *Precondition: (x,y) lies on the board
+ *Postcondition: A boolean value is returned
+ */
+bool GameBoard::isUsed(int x, int y) const
+{
+    int cell = geometry->getCell(x, y);
+    return xMask.test(cell) || oMask.test(cell);
+}
+
+/*
+ *Description: Returns the id('X', 'O' or '?' when vacant) stored at the supplied (x,y) coordinates
+ *Precondition: (x,y) lies on the board
+ *Postcondition: A string representing the occupant is returned
+ */
+string GameBoard::getLocationId(int x, int y) const
+{
+    int cell = geometry->getCell(x, y);
+    if(xMask.test(cell))
+        return "X";
+    if(oMask.test(cell))
+        return "O";
+    return "?";
+}
+
+/*
+ *Description: Returns the occupancy mask of the supplied side(0 for 'X', 1 for 'O') or id('X' or 'O').
+ *             Cell x * width + y is set when that side occupies Location (x,y). Any other side or id
+ *             yields an empty mask.
+ *Precondition: N/A
+ *Postcondition: A CellMask is returned
+ */
+const CellMask& GameBoard::getMask(int side) const
+{
+    if(side == 0)
+        return xMask;
+    if(side == 1)
+        return oMask;
+    return noMask;
+}
+
+const CellMask& GameBoard::getMask(const string& id) const
+{
+    return getMask(getSide(id));
+}
+
+/*
+ *Description: Returns the mask of all vacant Locations
  *Precondition: N/A
- *Postcondition: The game board drawn in the User's output
+ *Postcondition: A CellMask is returned
+ */
+CellMask GameBoard::getEmptyMask() const
+{
+    return geometry->getFullMask().without(xMask | oMask);
+}
+
+/*
+ *Description: Returns the number of vacant Locations
+ *Precondition: N/A
+ *Postcondition: An integer between 0 and the number of cells is returned
+ */
+int GameBoard::getEmptyCount() const
+{
+    return geometry->getCellCount() - (xMask | oMask).count();
+}
+
+/*
+ *Description: Returns true if the supplied occupancy mask covers any winning line passing through
+ *             the supplied cell. Only the lines through that cell are examined.
+ *Precondition: 0 <= cell < number of cells
+ *Postcondition: A boolean value is returned
  */
-void GameBoard::drawBoard()
+bool GameBoard::completesLine(const CellMask& mask, int cell) const
 {
-    cout << endl;
+    int count;
+    const int* lines = geometry->getCellLines(cell, count);
     
-    for(int i = 0; i < 3; i++){
-        
-        cout << "------------------" << endl;
-        
-        for(int j = 0; j < 3; j++)
+    //Boards of up to 64 cells only need the first word of each mask
+    if(geometry->isSmall())
+    {
+        uint64_t stones = mask.word(0);
+        for(int i = 0; i < count; i++)
         {
-            cout << gameBoard[i][j].locationId << "  |   ";
+            uint64_t line = geometry->getLine(lines[i]).word(0);
+            if((stones & line) == line)
+                return true;
         }
-        
-        cout << endl;
+        return false;
     }
-    cout << "------------------" << endl;
+    
+    for(int i = 0; i < count; i++)
+        if(geometry->getLine(lines[i]).isSubsetOf(mask))
+            return true;
+    return false;
+}
 
+/*
+ *Description: Returns the Zobrist hash of the stones on the board
+ *Precondition: N/A
+ *Postcondition: A 64-bit hash is returned
+ */
+uint64_t GameBoard::getHash() const
+{
+    return hashes[0];
+}
+
+/*
+ *Description: Returns the smallest of the hashes of the board's rotations and reflections
+ *Precondition: N/A
+ *Postcondition: A 64-bit hash is returned
+ */
+uint64_t GameBoard::getCanonicalHash() const
+{
+    return hashes[getCanonicalSymmetry()];
 }
 
 /*
-*Description: Accessor function for the GameBoard primary array
-*Precondition: N/A
-*Postcondition: A pointer to the Locations array is returned
-*/
-Location* GameBoard::getBoard()
+ *Description: Returns the symmetry that maps this board onto its canonical position
+ *Precondition: N/A
+ *Postcondition: An integer between 0 and getGeometry().getSymmetryCount() - 1 is returned
+ */
+int GameBoard::getCanonicalSymmetry() const
+{
+    int best = 0;
+    for(int symmetry = 1; symmetry < geometry->getSymmetryCount(); symmetry++)
+        if(hashes[symmetry] < hashes[best])
+            best = symmetry;
+    return best;
+}
+
+/*
+ *Description: Returns true if the supplied 9-bit mask covers any of the 8 winning lines of
+ *             the classic board
+ *Precondition: N/A
+ *Postcondition: A boolean value is returned
+ */
+bool GameBoard::hasLine(unsigned short mask)
 {
-    return *gameBoard;
+    for(int i = 0; i < 8; i++)
+        if((mask & LINE_MASKS[i]) == LINE_MASKS[i])
+            return true;
+    return false;
 }
 
 /*
@@ -111,118 +301,92 @@ Location* GameBoard::getBoard()
  *Precondition: N/A
  *Postcondition: A boolean value is returned
  */
-bool GameBoard::getGameStatus()
+bool GameBoard::getGameStatus() const
 {
     return isGameOver;
 }
 
 /*
- *Description: Checks if any of the game terminating scenarios(tie, player won, computer won)
- *             has occured. Then update 'isGameOver' local variable accordingly
+ *Description: Returns true if the Player completed a winning line
  *Precondition: N/A
- *Postcondition: A isGameOver is either true or false
+ *Postcondition: A boolean value is returned
  */
-void GameBoard::updateGameStatus()
+bool GameBoard::hasPlayerWon() const
 {
-    //Following set of bool variable record whether a winning scenario occured for Player/Computer
-    bool winCheckHorizontalPlayer = true;
-    bool winCheckVerticalPlayer = true;
-    bool winCheckHorizontalComputer = true;
-    bool winCheckVerticalComputer = true;
-    
-    //Checks whether horizontal/vertical winning combinations occured
-    for(int i = 0; i < 3; i++){
-        
-        for(int j = 0; j < 3; j++){
-            
-            if(gameBoard[i][j].locationId != playerID)
-                winCheckHorizontalPlayer = false;
-            if(gameBoard[j][i].locationId != playerID)
-                winCheckVerticalPlayer = false;
-            
-            if(gameBoard[i][j].locationId != computerID)
-                winCheckHorizontalComputer = false;
-            if(gameBoard[j][i].locationId != computerID)
-                winCheckVerticalComputer = false;
+    return playerWon;
+}
 
-        }
-        if(winCheckHorizontalPlayer || winCheckVerticalPlayer)
+/*
+ *Description: Returns true if the Computer completed a winning line
+ *Precondition: N/A
+ *Postcondition: A boolean value is returned
+ */
+bool GameBoard::hasComputerWon() const
+{
+    return computerWon;
+}
+
+/*
+ *Description: Returns true if the board filled up without either side winning
+ *Precondition: N/A
+ *Postcondition: A boolean value is returned
+ */
+bool GameBoard::isTie() const
+{
+    return tie;
+}
+
+/*
+ *Description: Checks if any of the game terminating scenarios(tie, player won, computer won)
+ *             has occured after the supplied side moved to the supplied cell. Then update
+ *             'isGameOver' local variable accordingly
+ *Precondition: The move has been recorded in the masks
+ *Postcondition: A isGameOver is either true or false
+ */
+void GameBoard::updateGameStatus(int cell, int side)
+{
+    //Only the side that just moved can have completed a line, and only through that cell
+    if(completesLine(getMask(side), cell))
+    {
+        if(side == playerSide)
         {
             isGameOver = true;
             playerWon = true;
-            
         }
-        else if(winCheckHorizontalComputer || winCheckVerticalComputer)
+        else if(side == computerSide)
         {
             isGameOver = true;
             computerWon = true;
-           
-        }
-        else
-        {
-            winCheckHorizontalPlayer = true;
-            winCheckVerticalPlayer = true;
-            winCheckVerticalComputer = true;
-            winCheckHorizontalComputer = true;
         }
-        
     }
-    //Checks whether any diagnoal winning combinations occured
-    if( (gameBoard[0][0].locationId == playerID && gameBoard[1][1].locationId == playerID && gameBoard[2][2].locationId == playerID) || (gameBoard[0][2].locationId == playerID && gameBoard[1][1].locationId == playerID && gameBoard[2][0].locationId == playerID))
+    //Otherwise the game is a tie once no Location is vacant
+    if(!isGameOver && getEmptyCount() == 0)
     {
         isGameOver = true;
-        playerWon = true;
-        
-    }
-    if( (gameBoard[0][0].locationId == computerID && gameBoard[1][1].locationId == computerID && gameBoard[2][2].locationId == computerID) || (gameBoard[0][2].locationId == computerID && gameBoard[1][1].locationId == computerID && gameBoard[2][0].locationId == computerID))
-    {
-        isGameOver = true;
-        computerWon = true;
-      
-    }
-    if(!isGameOver)
-    {
-        //Check whether a tie occured
-        bool tieIndicator = true;
-        for(int i = 0; i < 3; i++)
-            for(int j = 0; j < 3; j++)
-                if(gameBoard[i][j].locationId == "?")
-                    tieIndicator = false;
-        if(tieIndicator)
-        {
-            isGameOver = true;
-            tie = true;
-        }
+        tie = true;
     }
 }
 
 /*
- *Description: Gives player the option to use whichever ID(either 'X' or 'O') for their play and then update
- *             Computer ID accordingly.
+ *Description: Updates Player ID to the supplied id(either 'X' or 'O') and then updates
+ *             Computer ID to the other one. Any other value selects 'X'.
  *Precondition: N/A
  *Postcondition: The local string variables playerId and computerId are initialized appropriately
  */
-void GameBoard::setPlayerID()
+void GameBoard::setPlayerID(string id)
 {
-    int ans;
-    cout << "Please select which symbol to use(1.'X' 2.'O'): ";
-    cin >> ans;
-    
-    if(ans == 1){
-        playerID = "X";
-        setComputerID("O");
-    }
-    else if(ans == 2)
+    if(id == "O")
     {
-        playerID= "O";
+        playerID = "O";
+        playerSide = 1;
         setComputerID("X");
     }
     else
     {
         playerID = "X";
+        playerSide = 0;
         setComputerID("O");
     }
-    
 }
 
 /*
@@ -246,45 +410,36 @@ string GameBoard::getComputerID() const
 }
 
 /*
- *Description: Updates Computer ID
+ *Description: Returns the ID that plays against the supplied one
  *Precondition: N/A
- *Postcondition: computerID has value either 'X' or 'O'
+ *Postcondition: Returns "O" for "X" and "X" for anything else
  */
-void GameBoard::setComputerID(string id)
+string GameBoard::getOtherID(string id)
 {
-    computerID = id;
+    return id == "X" ? "O" : "X";
 }
 
 /*
- *Description: Provided the game is still active, inputs the Player's
- *             next move and returns a Location of that move.
- *Precondition: isGameOver is false.
- *Postcondition: Location is returned representing the Player's next move
+ *Description: Returns the side index of the supplied ID
+ *Precondition: N/A
+ *Postcondition: Returns 0 for "X", 1 for "O" and -1 for anything else
  */
-Location GameBoard::getPlayerMove()
+int GameBoard::getSide(const string& id)
 {
-    Location nextMove;
-    
-    if(!isGameOver){
-        cout << "\nPlease enter next move[Ex. 1 1 ]: ";
-        cin >> nextMove.x >> nextMove.y;
-    }
-    return nextMove;
+    if(id == "X")
+        return 0;
+    if(id == "O")
+        return 1;
+    return -1;
 }
 
 /*
- *Description: Displays game terminating message indicating who won
- *             or whether the game is a tie.
- *Precondition: playerWon, computerWon, tie local boolean variables
- *              are initialized.
- *Postcondition: Appropriate message is displayed on game status.
+ *Description: Updates Computer ID
+ *Precondition: N/A
+ *Postcondition: computerID has value either 'X' or 'O'
  */
-void GameBoard::displayGameStatus()
+void GameBoard::setComputerID(string id)
 {
-    if(playerWon)
-        cout << "\n***The PLAYER won !***" << endl;
-    if(computerWon)
-        cout << "\n***The COMPUTER won !***" << endl;
-    if(tie)
-        cout << "\n***The game is a TIE!***" << endl;
+    computerID = id;
+    computerSide = getSide(id);
 }
@@ -1,28 +1,39 @@
 /************************************************************************************
- Title:         GameBoard.cpp
+ Title:         GameBoard.h
  
  Author:        Anton Desilva
  
  Created On:    February 16, 2014
  
  Description:   A representation of the Tic-Tac-Toe
-                game board; A 3X3 two-dimensional array of Locations are used.
+                game board; two occupancy masks(one for 'X', one for 'O') are used. The board
+                may be any m,n,k size described by a BoardGeometry; the default is 3x3.
  
  Purpose:       Provides functionality to keep accurate records of Player/Computer
-                positions, drawing a visual representation of the game board, as well as methods
-                to advance and terminate an instance of a game.
+                positions as well as methods to advance and terminate an instance of a game.
+                GameBoard performs no console I/O; see ConsoleGame.h for the interactive front end.
  
  Usage:         An instance of GameBoard must be initialized to play the game.
+                GameBoard() plays on the classic 3x3 board; GameBoard(BoardGeometry::get(w, h, k))
+                plays on any other supported size.
  
  Build with:    Compile with main.cpp. Written with Xcode on OS X 10.8.5.
  
- Modifications: N/A
+ Modifications: Replaced the 3x3 array of Locations with two 9-bit occupancy masks.
+                Win, tie and vacancy checks are now mask comparisons.
+                Console I/O(drawing, prompts, messages) moved to ConsoleGame.
+                Board size and winning lines now come from a BoardGeometry.
+                Added getOtherID.
+                Moves and masks are addressed by side index; the string forms only convert the id.
  ***********************************************************************************/
 #ifndef TicTacToe_GameBoard_h
 #define TicTacToe_GameBoard_h
 
-#include "GameBoard.h"
+#include "BoardGeometry.h"
+#include "CellMask.h"
 #include "Location.h"
+#include "Zobrist.h"
+#include <cstdint>
 #include <string>
 
 class GameBoard {
@@ -30,38 +41,149 @@ class GameBoard {
 public:
     GameBoard();
     /*
-     *Description: Constructor that initializes the GameBoard
+     *Description: Constructor that initializes a classic 3x3 GameBoard
      *Precondition: N/A
-     *Postcondition: Each of the Locations of the GameBoard is initialized and the board is drawn
+     *Postcondition: Each of the Locations of the GameBoard is vacant
      */
 
-    void makeMove(Location, string);
+    explicit GameBoard(const BoardGeometry&);
     /*
-     *Description: Allows player to make a move to a Location on the GameBoard provided the current game
-     *             has not ended. Then checks to see if the game should terminate via updateGameStatus(see
-     *             below for description). Also displays information regarding who made the move.
+     *Description: Constructor that initializes a GameBoard of the supplied geometry
+     *Precondition: The BoardGeometry outlives the GameBoard(BoardGeometry::get always does)
+     *Postcondition: Each of the Locations of the GameBoard is vacant
+     */
+
+    const BoardGeometry& getGeometry() const;
+    /*
+     *Description: Accessor function for the size and winning lines of the board
+     *Precondition: N/A
+     *Postcondition: The board's BoardGeometry is returned
+     */
+
+    bool makeMove(const Location&, int);
+    /*
+     *Description: Allows the supplied side(0 for 'X', 1 for 'O') to make a move to a Location on the
+     *             GameBoard provided the current game has not ended. Then checks to see if the game should
+     *             terminate via updateGameStatus(see below for description).
+     *Precondition: The Location must be initialized
+     *Error Checking: Inputed Location is validated to be on the board and not already occupied, and the
+     *                side to be 0 or 1.
+     *Postcondition: Returns true and records the move if it was legal; otherwise the board is unchanged
+     *               and false is returned.
+     */
+
+    bool makeMove(const Location&, const string&);
+    /*
+     *Description: As above, for the side of the supplied id; for callers that hold ids read from a player
      *Precondition: The Location must be initialized and string parameter must contain either 'X' or 'O'
-     *Error Checking: Inputed Location is validated to see if it is already occupied.
-     *Postcondition: locationID(see Location.h) is updated to either 'X' or 'O'.
+     *Error Checking: Same as above; any other id is rejected.
+     *Postcondition: Same as above
      */
 
-    Location* getBoard();
+    void setPosition(const CellMask&, const CellMask&);
     /*
-     *Description: Accessor function for the GameBoard primary array
+     *Description: Replaces the board with the supplied 'X' and 'O' occupancy masks, as when a stored game
+     *             is restored, and recomputes the hashes and the game status
+     *Precondition: The masks do not overlap and only use cells of the board; the Player and Computer IDs
+     *              are already set
+     *Postcondition: The board holds the supplied position and its status is up to date
+     */
+
+    Location getLocation(int, int) const;
+    /*
+     *Description: Accessor function that builds the Location at the supplied (x,y) coordinates
+     *Precondition: (x,y) lies on the board
+     *Postcondition: A Location with its isUsed and locationId filled in from the board is returned
+     */
+
+    bool isUsed(int, int) const;
+    /*
+     *Description: Returns whether the Location at the supplied (x,y) coordinates is occupied
+     *Precondition: (x,y) lies on the board
+     *Postcondition: A boolean value is returned
+     */
+
+    string getLocationId(int, int) const;
+    /*
+     *Description: Returns the id('X', 'O' or '?' when vacant) stored at the supplied (x,y) coordinates
+     *Precondition: (x,y) lies on the board
+     *Postcondition: A string representing the occupant is returned
+     */
+
+    const CellMask& getMask(int) const;
+    const CellMask& getMask(const string&) const;
+    /*
+     *Description: Returns the occupancy mask of the supplied side(0 for 'X', 1 for 'O') or id('X' or 'O').
+     *             Cell x * width + y is set when that side occupies Location (x,y). Any other side or id
+     *             yields an empty mask. On the classic board the first word of the mask matches LINE_MASKS.
      *Precondition: N/A
-     *Postcondition: A pointer to the Locations array is returned
+     *Postcondition: A CellMask is returned
      */
 
-    Location gameBoard[3][3]; //3x3 Two-dimensional array to represent the game board
-    
-    void drawBoard();
+    CellMask getEmptyMask() const;
     /*
-     *Description: Provides a visual representation of the current game
+     *Description: Returns the mask of all vacant Locations
      *Precondition: N/A
-     *Postcondition: The game board drawn in the User's output
+     *Postcondition: A CellMask is returned
      */
+
+    int getEmptyCount() const;
+    /*
+     *Description: Returns the number of vacant Locations
+     *Precondition: N/A
+     *Postcondition: An integer between 0 and the number of cells is returned
+     */
+
+    bool completesLine(const CellMask&, int) const;
+    /*
+     *Description: Returns true if the supplied occupancy mask covers any winning line passing through
+     *             the supplied cell. Only the lines through that cell are examined.
+     *Precondition: 0 <= cell < number of cells
+     *Postcondition: A boolean value is returned
+     */
+
+    uint64_t getHash() const;
+    /*
+     *Description: Returns the Zobrist hash of the stones on the board('X' is side 0, 'O' side 1)
+     *Precondition: N/A
+     *Postcondition: A 64-bit hash is returned; it is updated with one XOR per move
+     */
+
+    uint64_t getCanonicalHash() const;
+    /*
+     *Description: Returns the smallest of the hashes of the board's rotations and reflections,
+     *             so that symmetric positions share one hash
+     *Precondition: N/A
+     *Postcondition: A 64-bit hash is returned
+     */
+
+    int getCanonicalSymmetry() const;
+    /*
+     *Description: Returns the symmetry(see BoardGeometry::getSymmetry) that maps this board onto
+     *             the position getCanonicalHash() describes. Moves stored under the canonical
+     *             hash are mapped back with the inverse of this symmetry.
+     *Precondition: N/A
+     *Postcondition: An integer between 0 and getGeometry().getSymmetryCount() - 1 is returned
+     */
+
+    static bool hasLine(unsigned short);
+    /*
+     *Description: Returns true if the supplied 9-bit mask covers any of the 8 winning lines of
+     *             the classic board
+     *Precondition: N/A
+     *Postcondition: A boolean value is returned
+     */
+
+    static const int BOARD_SIZE = 3; //Number of rows and columns of the classic board
+    static const unsigned short FULL_MASK = 0x1FF; //Mask with all 9 Locations of the classic board set
+    //Masks of the 3 rows, 3 columns and 2 diagonals of the classic board; bit (3 * x + y) represents Location (x,y)
+    static constexpr unsigned short LINE_MASKS[8] = {
+        0x007, 0x038, 0x1C0,    //Rows
+        0x049, 0x092, 0x124,    //Columns
+        0x111, 0x054            //Diagonals
+    };
     
-    bool getGameStatus();
+    bool getGameStatus() const;
     /*
      *Description: Accessor function for the isGameOver local boolean variable.
      *             Returns true if game is over; else false.
@@ -69,13 +191,25 @@ public:
      *Postcondition: A boolean value is returned
      */
 
-    void displayGameStatus();
+    bool hasPlayerWon() const;
+    /*
+     *Description: Returns true if the Player completed a winning line
+     *Precondition: N/A
+     *Postcondition: A boolean value is returned
+     */
+
+    bool hasComputerWon() const;
     /*
-     *Description: Displays game terminating message indicating who won
-     *             or whether the game is a tie.
-     *Precondition: playerWon, computerWon, tie local boolean variables
-     *              are initialized.
-     *Postcondition: Appropriate message is displayed on game status.
+     *Description: Returns true if the Computer completed a winning line
+     *Precondition: N/A
+     *Postcondition: A boolean value is returned
+     */
+
+    bool isTie() const;
+    /*
+     *Description: Returns true if the board filled up without either side winning
+     *Precondition: N/A
+     *Postcondition: A boolean value is returned
      */
     
     void setComputerID(string);
@@ -85,10 +219,10 @@ public:
      *Postcondition: computerID has value either 'X' or 'O'
      */
     
-    void setPlayerID();
+    void setPlayerID(string);
     /*
-     *Description: Gives player the option to use whichever ID(either 'X' or 'O') for their play and then update
-     *             Computer ID accordingly.
+     *Description: Updates Player ID to the supplied id(either 'X' or 'O') and then updates
+     *             Computer ID to the other one. Any other value selects 'X'.
      *Precondition: N/A
      *Postcondition: The local string variables playerId and computerId are initialized appropriately
      */
@@ -107,28 +241,44 @@ public:
      *Postcondition: Returns a string representing Player's ID
      */
     
-    Location getPlayerMove();
+    static string getOtherID(string);
+    /*
+     *Description: Returns the ID that plays against the supplied one
+     *Precondition: N/A
+     *Postcondition: Returns "O" for "X" and "X" for anything else
+     */
+    
+    static int getSide(const string&);
     /*
-     *Description: Provided the game is still active, inputs the Player's
-     *             next move and returns a Location of that move.
-     *Precondition: isGameOver is false.
-     *Postcondition: Location is returned representing the Player's next move
+     *Description: Returns the side index of the supplied ID, as used by makeMove, getMask and Zobrist
+     *Precondition: N/A
+     *Postcondition: Returns 0 for "X", 1 for "O" and -1 for anything else
      */
     
+    friend class Benchmark; //Measures private steps in isolation(see Benchmark.h)
+    
 private:
     bool isGameOver; //Maintains whether the current game should be terminated
     bool playerWon; //Initializes to 'true' if the Player activates a winning combination
     bool tie; // Initializes to 'true' when niether Player nor Computer wins
     bool computerWon; //Initializes to 'true' if the Computer activates a winning combination
-    void updateGameStatus();
+    void updateGameStatus(int, int);
     /*
      *Description: Checks if any of the game terminating scenarios(tie, player won, computer won)
-     *             has occured. Then update 'isGameOver' local variable accordingly
-     *Precondition: N/A
+     *             has occured after the supplied side moved to the supplied cell. Then update
+     *             'isGameOver' local variable accordingly
+     *Precondition: The move has been recorded in the masks
      *Postcondition: A isGameOver is either true or false
      */
     string playerID; //stores whether the Player is 'X' or 'O'
     string computerID; //stores whether the Computer is 'X' or 'O'
+    int playerSide; //Side index of playerID, or -1 before it is set
+    int computerSide; //Side index of computerID, or -1 before it is set
+    const BoardGeometry* geometry; //Size and winning lines of the board
+    CellMask xMask; //Occupancy mask of the Locations held by 'X'
+    CellMask oMask; //Occupancy mask of the Locations held by 'O'
+    CellMask noMask; //Always empty; returned by getMask for unknown ids
+    uint64_t hashes[Zobrist::MAX_SYMMETRIES]; //Zobrist hash of the board under each symmetry
 };
 
 #endif
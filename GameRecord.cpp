@@ -0,0 +1,225 @@
+/************************************************************************************
+ Title:         GameRecord.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of GameRecord.h. A finished game and its binary
+                encoding.
+ 
+ Purpose:       Lets every game played be logged in a few bytes.
+ 
+ Usage:         record.encode(bitsPerCell, bytes); record.decode(next, end, bitsPerCell);
+ 
+ Build with:    Compile with selfplay.cpp.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#include "GameRecord.h"
+using namespace std;
+
+const char GameRecord::MAGIC[4] = { 'T', 'T', 'T', 'R' };
+
+/*
+ *Description: Constructor of an unfinished game without moves
+ *Precondition: N/A
+ *Postcondition: The record is empty
+ */
+GameRecord::GameRecord() : moveCount(0), result(UNFINISHED)
+{
+}
+
+/*
+ *Description: Removes every move and marks the game unfinished
+ *Precondition: N/A
+ *Postcondition: The record is empty
+ */
+void GameRecord::clear()
+{
+    moveCount = 0;
+    result = UNFINISHED;
+}
+
+/*
+ *Description: Appends the supplied cell to the moves
+ *Precondition: Fewer than CellMask::CAPACITY moves have been added; the cell is below CellMask::CAPACITY
+ *Postcondition: The move count grows by one
+ */
+void GameRecord::addMove(int cell)
+{
+    moves[moveCount++] = static_cast<unsigned char>(cell);
+}
+
+/*
+ *Description: Sets the result
+ *Precondition: N/A
+ *Postcondition: The result is updated
+ */
+void GameRecord::setResult(Result gameResult)
+{
+    result = gameResult;
+}
+
+/*
+ *Description: Sets the result from the final position of the supplied board
+ *Precondition: N/A
+ *Postcondition: The result is updated
+ */
+void GameRecord::setResult(const GameBoard& board)
+{
+    if(board.hasPlayerWon())
+        result = (board.getPlayerID() == "X") ? X_WON : O_WON;
+    else if(board.hasComputerWon())
+        result = (board.getComputerID() == "X") ? X_WON : O_WON;
+    else if(board.isTie())
+        result = DRAW;
+    else
+        result = UNFINISHED;
+}
+
+/*
+ *Description: Accessor functions for the number of moves, the cell of the supplied move and the result
+ *Precondition: The move number is below the move count
+ *Postcondition: The requested value is returned
+ */
+int GameRecord::getMoveCount() const
+{
+    return moveCount;
+}
+
+int GameRecord::getMove(int index) const
+{
+    return moves[index];
+}
+
+GameRecord::Result GameRecord::getResult() const
+{
+    return result;
+}
+
+/*
+ *Description: Appends the encoding of the game with the supplied number of bits per cell
+ *Precondition: Every move fits in the supplied number of bits
+ *Postcondition: The vector grows by the encoded game
+ */
+void GameRecord::encode(int bitsPerCell, vector<unsigned char>& bytes) const
+{
+    //Varint of the move count and result, 7 bits per byte
+    uint32_t header = (static_cast<uint32_t>(moveCount) << 2) | result;
+    while(header >= 0x80)
+    {
+        bytes.push_back(static_cast<unsigned char>(header | 0x80));
+        header >>= 7;
+    }
+    bytes.push_back(static_cast<unsigned char>(header));
+    
+    //The cells, low bits first
+    uint32_t pending = 0;
+    int pendingBits = 0;
+    for(int i = 0; i < moveCount; i++)
+    {
+        pending |= static_cast<uint32_t>(moves[i]) << pendingBits;
+        pendingBits += bitsPerCell;
+        while(pendingBits >= 8)
+        {
+            bytes.push_back(static_cast<unsigned char>(pending));
+            pending >>= 8;
+            pendingBits -= 8;
+        }
+    }
+    if(pendingBits > 0)
+        bytes.push_back(static_cast<unsigned char>(pending));
+}
+
+/*
+ *Description: Decodes one game from the bytes between the supplied pointers, advancing the first
+ *Precondition: N/A
+ *Error Checking: The bytes must hold a whole game of at most CellMask::CAPACITY moves.
+ *Postcondition: Returns true and replaces the record on success; otherwise returns false
+ */
+bool GameRecord::decode(const unsigned char*& next, const unsigned char* end, int bitsPerCell)
+{
+    const unsigned char* in = next;
+    uint32_t header = 0;
+    for(int shift = 0; ; shift += 7)
+    {
+        if(in == end || shift > 14)
+            return false;
+        header |= static_cast<uint32_t>(*in & 0x7F) << shift;
+        if(!(*in++ & 0x80))
+            break;
+    }
+    
+    int count = static_cast<int>(header >> 2);
+    size_t bytes = (static_cast<size_t>(count) * bitsPerCell + 7) / 8;
+    if(count > CellMask::CAPACITY || static_cast<size_t>(end - in) < bytes)
+        return false;
+    
+    uint32_t pending = 0;
+    int pendingBits = 0;
+    uint32_t cellMask = (1u << bitsPerCell) - 1;
+    for(int i = 0; i < count; i++)
+    {
+        if(pendingBits < bitsPerCell)
+        {
+            pending |= static_cast<uint32_t>(*in++) << pendingBits;
+            pendingBits += 8;
+        }
+        moves[i] = static_cast<unsigned char>(pending & cellMask);
+        pending >>= bitsPerCell;
+        pendingBits -= bitsPerCell;
+    }
+    
+    moveCount = count;
+    result = static_cast<Result>(header & 3);
+    next = in;
+    return true;
+}
+
+/*
+ *Description: Returns the number of bits needed to store a cell of the supplied geometry
+ *Precondition: N/A
+ *Postcondition: A number between 1 and 8 is returned
+ */
+int GameRecord::getBitsPerCell(const BoardGeometry& geometry)
+{
+    int bits = 1;
+    while((1 << bits) < geometry.getCellCount())
+        bits++;
+    return bits;
+}
+
+/*
+ *Description: Returns the 32-bit FNV-1a hash of the supplied bytes
+ *Precondition: N/A
+ *Postcondition: The checksum is returned
+ */
+uint32_t GameRecord::checksum(const unsigned char* bytes, size_t size)
+{
+    uint32_t hash = 2166136261u;
+    for(size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/*
+ *Description: Store and load a 32-bit little-endian number
+ *Precondition: Four bytes are available
+ *Postcondition: The number is stored or returned
+ */
+void GameRecord::putWord(unsigned char* bytes, uint32_t value)
+{
+    for(int i = 0; i < 4; i++)
+        bytes[i] = static_cast<unsigned char>(value >> (8 * i));
+}
+
+uint32_t GameRecord::getWord(const unsigned char* bytes)
+{
+    return bytes[0] | (static_cast<uint32_t>(bytes[1]) << 8) | (static_cast<uint32_t>(bytes[2]) << 16)
+           | (static_cast<uint32_t>(bytes[3]) << 24);
+}
@@ -0,0 +1,141 @@
+/************************************************************************************
+ Title:         GameRecord.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   A finished game as the sequence of cells played('X' always moves first)
+                and its result, together with the binary format game logs are stored in.
+ 
+ Purpose:       Lets every game played be logged in a few bytes. A record file is:
+                  file header  16 bytes: "TTTR", format version(2 bytes), width, height,
+                               win length, bits per cell, layers(0 for a flat board), 5
+                               reserved zero bytes
+                  blocks       each a 12-byte header(payload bytes, game count and
+                               FNV-1a checksum of the payload, 4 bytes each) followed by
+                               its payload of encoded games
+                A game is encoded as a varint of (move count << 2 | result) followed by
+                its cells packed with 'bits per cell' bits each(4 on the 3x3 board), low
+                bits first, padded to a whole byte. A 3x3 game takes at most 6 bytes.
+                All numbers are little-endian. Blocks are independent of each other, so a
+                file can be decoded in parallel and a damaged block is detected.
+ 
+ Usage:         GameRecord record; record.addMove(cell); ... record.setResult(board);
+                GameRecordWriter and GameRecordReader write and read record files.
+ 
+ Build with:    Compile with selfplay.cpp.
+ 
+ Modifications: The header records the number of layers of the board.
+ ***********************************************************************************/
+
+#ifndef TicTacToe_GameRecord_h
+#define TicTacToe_GameRecord_h
+
+#include "BoardGeometry.h"
+#include "CellMask.h"
+#include "GameBoard.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+class GameRecord {
+
+public:
+    enum Result {
+        X_WON = 0,
+        O_WON = 1,
+        DRAW = 2,
+        UNFINISHED = 3 //The game was abandoned or resigned
+    };
+    
+    GameRecord();
+    /*
+     *Description: Constructor of an unfinished game without moves
+     *Precondition: N/A
+     *Postcondition: The record is empty
+     */
+    
+    void clear();
+    /*
+     *Description: Removes every move and marks the game unfinished
+     *Precondition: N/A
+     *Postcondition: The record is empty
+     */
+    
+    void addMove(int);
+    /*
+     *Description: Appends the supplied cell to the moves
+     *Precondition: Fewer than CellMask::CAPACITY moves have been added; the cell is below CellMask::CAPACITY
+     *Postcondition: The move count grows by one
+     */
+    
+    void setResult(Result);
+    void setResult(const GameBoard&);
+    /*
+     *Description: Sets the result, either directly or from the final position of the supplied board
+     *Precondition: N/A
+     *Postcondition: The result is updated
+     */
+    
+    int getMoveCount() const;
+    int getMove(int) const;
+    Result getResult() const;
+    /*
+     *Description: Accessor functions for the number of moves, the cell of the supplied move and the result
+     *Precondition: The move number is below the move count
+     *Postcondition: The requested value is returned
+     */
+    
+    void encode(int, vector<unsigned char>&) const;
+    /*
+     *Description: Appends the encoding of the game with the supplied number of bits per cell
+     *Precondition: Every move fits in the supplied number of bits
+     *Postcondition: The vector grows by the encoded game
+     */
+    
+    bool decode(const unsigned char*&, const unsigned char*, int);
+    /*
+     *Description: Decodes one game from the bytes between the supplied pointers with the supplied number
+     *             of bits per cell, advancing the first pointer past it
+     *Precondition: N/A
+     *Error Checking: The bytes must hold a whole game of at most CellMask::CAPACITY moves.
+     *Postcondition: Returns true and replaces the record on success; otherwise returns false
+     */
+    
+    static int getBitsPerCell(const BoardGeometry&);
+    /*
+     *Description: Returns the number of bits needed to store a cell of the supplied geometry
+     *Precondition: N/A
+     *Postcondition: A number between 1 and 8 is returned
+     */
+    
+    static uint32_t checksum(const unsigned char*, size_t);
+    /*
+     *Description: Returns the 32-bit FNV-1a hash of the supplied bytes
+     *Precondition: N/A
+     *Postcondition: The checksum is returned
+     */
+    
+    static void putWord(unsigned char*, uint32_t);
+    static uint32_t getWord(const unsigned char*);
+    /*
+     *Description: Store and load a 32-bit little-endian number
+     *Precondition: Four bytes are available
+     *Postcondition: The number is stored or returned
+     */
+    
+    static const uint16_t FORMAT_VERSION = 1; //Version written in the file header
+    static const size_t FILE_HEADER_SIZE = 16; //Bytes of the file header
+    static const size_t BLOCK_HEADER_SIZE = 12; //Bytes of each block header
+    static const size_t BLOCK_SIZE = 64 * 1024; //Payload after which a writer starts a new block
+    static const size_t MAX_BLOCK_PAYLOAD = BLOCK_SIZE + 2 * CellMask::CAPACITY; //Largest valid block payload
+    static const char MAGIC[4]; //First bytes of every record file
+
+private:
+    unsigned char moves[CellMask::CAPACITY]; //Cells in the order they were played
+    int moveCount; //Number of moves
+    Result result; //How the game ended
+};
+#endif
@@ -0,0 +1,226 @@
+/************************************************************************************
+ Title:         GameRecordReader.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of GameRecordReader.h. Reads the games of a record
+                file one block at a time.
+ 
+ Purpose:       Lets logged games be replayed and analyzed.
+ 
+ Usage:         reader.open(path, error); while(reader.next(record)) ...
+ 
+ Build with:    Compile with selfplay.cpp.
+ 
+ Modifications: Reads the number of layers of the board.
+ ***********************************************************************************/
+
+#include "GameRecordReader.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+using namespace std;
+
+/*
+ *Description: Constructor of a reader without a file
+ *Precondition: N/A
+ *Postcondition: open() must be called before reading
+ */
+GameRecordReader::GameRecordReader()
+    : file(0), geometry(&BoardGeometry::classic()), bitsPerCell(0), position(0), blockGamesLeft(0), gameCount(0)
+{
+}
+
+/*
+ *Description: Destructor that closes the file
+ *Precondition: N/A
+ *Postcondition: The file is closed
+ */
+GameRecordReader::~GameRecordReader()
+{
+    if(file)
+        fclose(file);
+}
+
+/*
+ *Description: Opens the record file at the supplied path and reads its header
+ *Precondition: N/A
+ *Error Checking: The file must start with a valid header of a supported version and board size.
+ *Postcondition: Returns true on success; otherwise the string holds the reason
+ */
+bool GameRecordReader::open(const string& path, string& openError)
+{
+    if(file)
+        fclose(file);
+    file = fopen(path.c_str(), "rb");
+    if(!file)
+    {
+        openError = strerror(errno);
+        return false;
+    }
+    
+    unsigned char header[GameRecord::FILE_HEADER_SIZE];
+    size_t size = fread(header, 1, sizeof(header), file);
+    if(!readHeader(header, size, geometry, bitsPerCell, openError))
+    {
+        fclose(file);
+        file = 0;
+        return false;
+    }
+    
+    blockGamesLeft = 0;
+    gameCount = 0;
+    error.clear();
+    return true;
+}
+
+/*
+ *Description: Reads the next game into the supplied record
+ *Precondition: open() succeeded
+ *Postcondition: Returns false at the end of the file or on an error
+ */
+bool GameRecordReader::next(GameRecord& record)
+{
+    if(blockGamesLeft == 0 && !readBlock())
+        return false;
+    
+    if(!record.decode(position, block.data() + block.size(), bitsPerCell))
+    {
+        error = "damaged game in block";
+        blockGamesLeft = 0;
+        return false;
+    }
+    for(int i = 0; i < record.getMoveCount(); i++)
+        if(record.getMove(i) >= geometry->getCellCount())
+        {
+            error = "move off the board";
+            blockGamesLeft = 0;
+            return false;
+        }
+    
+    blockGamesLeft--;
+    gameCount++;
+    return true;
+}
+
+/*
+ *Description: Accessor function that returns the geometry of the file's games
+ *Precondition: open() succeeded
+ *Postcondition: A BoardGeometry is returned
+ */
+const BoardGeometry& GameRecordReader::getGeometry() const
+{
+    return *geometry;
+}
+
+/*
+ *Description: Accessor function that returns why reading stopped early, or an empty string
+ *Precondition: N/A
+ *Postcondition: A string is returned
+ */
+const string& GameRecordReader::getError() const
+{
+    return error;
+}
+
+/*
+ *Description: Accessor function that returns the number of games read so far
+ *Precondition: N/A
+ *Postcondition: A non-negative count is returned
+ */
+long GameRecordReader::getGameCount() const
+{
+    return gameCount;
+}
+
+/*
+ *Description: Checks the supplied file header and returns the file's geometry and bits per cell
+ *Precondition: N/A
+ *Error Checking: The header must be complete, of a supported version and of a supported board size.
+ *Postcondition: Returns true on success; otherwise the string holds the reason
+ */
+bool GameRecordReader::readHeader(const unsigned char* header, size_t size, const BoardGeometry*& fileGeometry,
+                                  int& fileBitsPerCell, string& headerError)
+{
+    if(size < GameRecord::FILE_HEADER_SIZE || memcmp(header, GameRecord::MAGIC, sizeof(GameRecord::MAGIC)) != 0)
+    {
+        headerError = "not a game record file";
+        return false;
+    }
+    if((header[4] | (header[5] << 8)) != GameRecord::FORMAT_VERSION)
+    {
+        headerError = "unsupported record format version";
+        return false;
+    }
+    
+    try
+    {
+        fileGeometry = &BoardGeometry::get(header[6], header[7], header[8], max(1, static_cast<int>(header[10])));
+    }
+    catch(const invalid_argument&)
+    {
+        headerError = "unsupported board size";
+        return false;
+    }
+    
+    fileBitsPerCell = header[9];
+    if(fileBitsPerCell != GameRecord::getBitsPerCell(*fileGeometry))
+    {
+        headerError = "bits per cell do not match the board size";
+        return false;
+    }
+    return true;
+}
+
+/*
+ *Description: Reads the next block into 'block' and verifies its checksum
+ *Precondition: The file is open
+ *Postcondition: Returns false at the end of the file or on an error
+ */
+bool GameRecordReader::readBlock()
+{
+    if(!file || !error.empty())
+        return false;
+    
+    //Empty blocks are never written, but they are harmless
+    do
+    {
+        unsigned char header[GameRecord::BLOCK_HEADER_SIZE];
+        size_t size = fread(header, 1, sizeof(header), file);
+        if(size == 0)
+            return false;
+        if(size < sizeof(header))
+        {
+            error = "truncated block header";
+            return false;
+        }
+        
+        uint32_t payload = GameRecord::getWord(header);
+        if(payload > GameRecord::MAX_BLOCK_PAYLOAD)
+        {
+            error = "damaged block header";
+            return false;
+        }
+        blockGamesLeft = GameRecord::getWord(header + 4);
+        block.resize(payload);
+        if(fread(block.data(), 1, payload, file) != payload)
+        {
+            error = "truncated block";
+            blockGamesLeft = 0;
+            return false;
+        }
+        if(GameRecord::checksum(block.data(), payload) != GameRecord::getWord(header + 8))
+        {
+            error = "block checksum mismatch";
+            blockGamesLeft = 0;
+            return false;
+        }
+    }
+    while(blockGamesLeft == 0);
+    
+    position = block.data();
+    return true;
+}
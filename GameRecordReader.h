@@ -0,0 +1,114 @@
+/************************************************************************************
+ Title:         GameRecordReader.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   Reads the games of a record file(see GameRecord.h for the format) from
+                first to last. The file is read one block at a time and each block's
+                checksum is verified before its games are returned.
+ 
+ Purpose:       Lets logged games be replayed and analyzed.
+ 
+ Usage:         GameRecordReader reader;
+                if(!reader.open(path, error)) ...
+                GameRecord record;
+                while(reader.next(record)) ...
+                if(!reader.getError().empty()) ... //the file is damaged or truncated
+ 
+ Build with:    Compile with selfplay.cpp.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#ifndef TicTacToe_GameRecordReader_h
+#define TicTacToe_GameRecordReader_h
+
+#include "BoardGeometry.h"
+#include "GameRecord.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+using namespace std;
+
+class GameRecordReader {
+
+public:
+    GameRecordReader();
+    /*
+     *Description: Constructor of a reader without a file
+     *Precondition: N/A
+     *Postcondition: open() must be called before reading
+     */
+    
+    ~GameRecordReader();
+    /*
+     *Description: Destructor that closes the file
+     *Precondition: N/A
+     *Postcondition: The file is closed
+     */
+    
+    bool open(const string&, string&);
+    /*
+     *Description: Opens the record file at the supplied path and reads its header
+     *Precondition: N/A
+     *Error Checking: The file must start with a valid header of a supported version and board size.
+     *Postcondition: Returns true on success; otherwise the string holds the reason
+     */
+    
+    bool next(GameRecord&);
+    /*
+     *Description: Reads the next game into the supplied record
+     *Precondition: open() succeeded
+     *Postcondition: Returns false at the end of the file or on an error(see getError())
+     */
+    
+    const BoardGeometry& getGeometry() const;
+    /*
+     *Description: Accessor function that returns the geometry of the file's games
+     *Precondition: open() succeeded
+     *Postcondition: A BoardGeometry is returned
+     */
+    
+    const string& getError() const;
+    /*
+     *Description: Accessor function that returns why reading stopped early, or an empty string
+     *Precondition: N/A
+     *Postcondition: A string is returned
+     */
+    
+    long getGameCount() const;
+    /*
+     *Description: Accessor function that returns the number of games read so far
+     *Precondition: N/A
+     *Postcondition: A non-negative count is returned
+     */
+    
+    static bool readHeader(const unsigned char*, size_t, const BoardGeometry*&, int&, string&);
+    /*
+     *Description: Checks the supplied file header and returns the file's geometry and bits per cell
+     *Precondition: N/A
+     *Error Checking: The header must be complete, of a supported version and of a supported board size.
+     *Postcondition: Returns true on success; otherwise the string holds the reason
+     */
+
+private:
+    bool readBlock();
+    /*
+     *Description: Reads the next block into 'block' and verifies its checksum
+     *Precondition: The file is open
+     *Postcondition: Returns false at the end of the file or on an error
+     */
+    
+    FILE* file; //Open record file, or 0
+    const BoardGeometry* geometry; //Geometry of the file's games
+    int bitsPerCell; //Bits per encoded cell
+    vector<unsigned char> block; //Payload of the current block
+    const unsigned char* position; //Next game in 'block'
+    uint32_t blockGamesLeft; //Games of the current block not read yet
+    long gameCount; //Games read so far
+    string error; //Why reading stopped early
+};
+#endif
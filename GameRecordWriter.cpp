@@ -0,0 +1,152 @@
+/************************************************************************************
+ Title:         GameRecordWriter.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of GameRecordWriter.h. Appends GameRecords to a
+                record file one block at a time.
+ 
+ Purpose:       Lets game loops log every game they play.
+ 
+ Usage:         writer.open(path, geometry, error); writer.write(record); writer.close();
+ 
+ Build with:    Compile with selfplay.cpp.
+ 
+ Modifications: Writes the number of layers of the board.
+ ***********************************************************************************/
+
+#include "GameRecordWriter.h"
+#include <cerrno>
+#include <cstring>
+using namespace std;
+
+/*
+ *Description: Constructor of a writer without a file
+ *Precondition: N/A
+ *Postcondition: open() must be called before writing
+ */
+GameRecordWriter::GameRecordWriter() : file(0), bitsPerCell(0), blockGames(0), gameCount(0), failed(false)
+{
+}
+
+/*
+ *Description: Destructor that closes the file
+ *Precondition: N/A
+ *Postcondition: Every written game is in the file
+ */
+GameRecordWriter::~GameRecordWriter()
+{
+    close();
+}
+
+/*
+ *Description: Creates the file at the supplied path for games of the supplied geometry and writes its header
+ *Precondition: The writer is not open
+ *Postcondition: Returns true on success; otherwise the string holds the reason
+ */
+bool GameRecordWriter::open(const string& path, const BoardGeometry& geometry, string& error)
+{
+    lock_guard<mutex> guard(lock);
+    file = fopen(path.c_str(), "wb");
+    if(!file)
+    {
+        error = strerror(errno);
+        return false;
+    }
+    
+    bitsPerCell = GameRecord::getBitsPerCell(geometry);
+    unsigned char header[GameRecord::FILE_HEADER_SIZE] = { 0 };
+    memcpy(header, GameRecord::MAGIC, sizeof(GameRecord::MAGIC));
+    header[4] = static_cast<unsigned char>(GameRecord::FORMAT_VERSION & 0xFF);
+    header[5] = static_cast<unsigned char>(GameRecord::FORMAT_VERSION >> 8);
+    header[6] = static_cast<unsigned char>(geometry.getWidth());
+    header[7] = static_cast<unsigned char>(geometry.getHeight());
+    header[8] = static_cast<unsigned char>(geometry.getWinLength());
+    header[9] = static_cast<unsigned char>(bitsPerCell);
+    header[10] = static_cast<unsigned char>(geometry.getLayerCount() > 1 ? geometry.getLayerCount() : 0);
+    if(fwrite(header, 1, sizeof(header), file) != sizeof(header))
+    {
+        error = strerror(errno);
+        fclose(file);
+        file = 0;
+        return false;
+    }
+    
+    block.reserve(GameRecord::BLOCK_HEADER_SIZE + GameRecord::MAX_BLOCK_PAYLOAD);
+    block.assign(GameRecord::BLOCK_HEADER_SIZE, 0);
+    blockGames = 0;
+    gameCount = 0;
+    failed = false;
+    return true;
+}
+
+/*
+ *Description: Appends a game. Safe to call from several threads at once.
+ *Precondition: The writer is open and every move is a cell of its geometry
+ *Postcondition: Returns false if a block could not be written
+ */
+bool GameRecordWriter::write(const GameRecord& record)
+{
+    lock_guard<mutex> guard(lock);
+    if(!file)
+        return false;
+    
+    record.encode(bitsPerCell, block);
+    blockGames++;
+    gameCount++;
+    if(block.size() - GameRecord::BLOCK_HEADER_SIZE >= GameRecord::BLOCK_SIZE)
+        return flushBlock();
+    return !failed;
+}
+
+/*
+ *Description: Writes the last block and closes the file
+ *Precondition: N/A
+ *Postcondition: Returns false if the file could not be completed
+ */
+bool GameRecordWriter::close()
+{
+    lock_guard<mutex> guard(lock);
+    if(!file)
+        return !failed;
+    
+    flushBlock();
+    if(fclose(file) != 0)
+        failed = true;
+    file = 0;
+    return !failed;
+}
+
+/*
+ *Description: Accessor function that returns the number of games written since open()
+ *Precondition: N/A
+ *Postcondition: A non-negative count is returned
+ */
+long GameRecordWriter::getGameCount() const
+{
+    lock_guard<mutex> guard(lock);
+    return gameCount;
+}
+
+/*
+ *Description: Writes the current block, if it holds any games, and empties it
+ *Precondition: The caller holds 'lock'
+ *Postcondition: Returns false if the block could not be written
+ */
+bool GameRecordWriter::flushBlock()
+{
+    if(blockGames > 0)
+    {
+        size_t payload = block.size() - GameRecord::BLOCK_HEADER_SIZE;
+        GameRecord::putWord(&block[0], static_cast<uint32_t>(payload));
+        GameRecord::putWord(&block[4], blockGames);
+        GameRecord::putWord(&block[8], GameRecord::checksum(&block[GameRecord::BLOCK_HEADER_SIZE], payload));
+        if(fwrite(block.data(), 1, block.size(), file) != block.size())
+            failed = true;
+    }
+    block.resize(GameRecord::BLOCK_HEADER_SIZE);
+    blockGames = 0;
+    return !failed;
+}
@@ -0,0 +1,99 @@
+/************************************************************************************
+ Title:         GameRecordWriter.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   Appends GameRecords to a record file(see GameRecord.h for the format).
+                Games are encoded into an in-memory block that is written out once it
+                reaches GameRecord::BLOCK_SIZE bytes, so writing a game normally costs
+                a few dozen nanoseconds and no system call.
+ 
+ Purpose:       Lets game loops log every game they play.
+ 
+ Usage:         GameRecordWriter writer;
+                if(!writer.open(path, geometry, error)) ...
+                writer.write(record); //from any thread
+                writer.close(); //writes the last block; also done by the destructor
+ 
+ Build with:    Compile with selfplay.cpp.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#ifndef TicTacToe_GameRecordWriter_h
+#define TicTacToe_GameRecordWriter_h
+
+#include "BoardGeometry.h"
+#include "GameRecord.h"
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+using namespace std;
+
+class GameRecordWriter {
+
+public:
+    GameRecordWriter();
+    /*
+     *Description: Constructor of a writer without a file
+     *Precondition: N/A
+     *Postcondition: open() must be called before writing
+     */
+    
+    ~GameRecordWriter();
+    /*
+     *Description: Destructor that closes the file
+     *Precondition: N/A
+     *Postcondition: Every written game is in the file
+     */
+    
+    bool open(const string&, const BoardGeometry&, string&);
+    /*
+     *Description: Creates(or replaces) the file at the supplied path for games of the supplied geometry
+     *             and writes its header
+     *Precondition: The writer is not open
+     *Postcondition: Returns true on success; otherwise the string holds the reason
+     */
+    
+    bool write(const GameRecord&);
+    /*
+     *Description: Appends a game. Safe to call from several threads at once.
+     *Precondition: Every move is a cell of the file's geometry
+     *Postcondition: Returns false if the writer is not open or a block could not be written
+     */
+    
+    bool close();
+    /*
+     *Description: Writes the last block and closes the file
+     *Precondition: N/A
+     *Postcondition: Returns false if the file could not be completed
+     */
+    
+    long getGameCount() const;
+    /*
+     *Description: Accessor function that returns the number of games written since open()
+     *Precondition: N/A
+     *Postcondition: A non-negative count is returned
+     */
+
+private:
+    bool flushBlock();
+    /*
+     *Description: Writes the current block, if it holds any games, and empties it
+     *Precondition: The caller holds 'lock'
+     *Postcondition: Returns false if the block could not be written
+     */
+    
+    mutable mutex lock; //Guards every member below
+    FILE* file; //Open record file, or 0
+    int bitsPerCell; //Bits per encoded cell of the file's geometry
+    vector<unsigned char> block; //Block header followed by the encoded games of the current block
+    uint32_t blockGames; //Games in the current block
+    long gameCount; //Games written since open()
+    bool failed; //Set once a write has failed
+};
+#endif
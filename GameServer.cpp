@@ -0,0 +1,726 @@
+/************************************************************************************
+ Title:         GameServer.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of GameServer.h. Each worker owns an epoll instance,
+                its connections and their buffers; the listening socket is registered
+                with every instance using EPOLLEXCLUSIVE so a new connection wakes only
+                one worker. Only the session table is shared between workers.
+ 
+ Purpose:       Serves many concurrent games from one process.
+ 
+ Usage:         server.listenTcp(port, error); server.run(threads);
+ 
+ Build with:    Compile with server.cpp. Linux only; link with -pthread.
+ 
+ Modifications: Classic games are stored as CompactGames in a pool per shard and played
+                with a Computer per worker thread.
+                Added the OpeningBook.
+                Added the move time.
+                Added the decision statistics and the STATS command.
+                A peer that shuts down its sending side still receives its replies.
+                Unknown commands are rejected before their session is looked up.
+                Input is no longer read while MAX_OUTPUT bytes of replies wait to be written.
+                Classic games are played outside their shard's lock.
+ ***********************************************************************************/
+
+#include "GameServer.h"
+#include "Random.h"
+#include <arpa/inet.h>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sstream>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+using namespace std;
+
+#ifndef EPOLLEXCLUSIVE
+#define EPOLLEXCLUSIVE 0
+#endif
+
+/*
+ *Description: Constructor that sets the default Strategy and the seed of the sessions
+ *Precondition: N/A
+ *Postcondition: The server has no sessions and is not listening
+ */
+GameServer::GameServer(Computer::Strategy strategy, uint64_t serverSeed)
+    : defaultStrategy(strategy), openingBook(0), moveTime(0), stats(0), seed(serverSeed), listenFd(-1),
+      wakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+      stopping(false), nextSessionId(1), sessionCount(0)
+{
+}
+
+/*
+ *Description: Destructor that closes the listening socket
+ *Precondition: run() has returned
+ *Postcondition: The sockets are closed
+ */
+GameServer::~GameServer()
+{
+    if(listenFd >= 0)
+        close(listenFd);
+    if(wakeFd >= 0)
+        close(wakeFd);
+}
+
+/*
+ *Description: Listens for TCP connections on 127.0.0.1 at the supplied port
+ *Precondition: The server is not listening yet
+ *Postcondition: Returns true on success; otherwise the string holds the reason
+ */
+bool GameServer::listenTcp(int port, string& error)
+{
+    listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if(listenFd < 0)
+    {
+        error = strerror(errno);
+        return false;
+    }
+    
+    int enable = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    
+    if(bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0
+       || listen(listenFd, SOMAXCONN) < 0)
+    {
+        error = strerror(errno);
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    return true;
+}
+
+/*
+ *Description: Listens for connections on a Unix socket at the supplied path
+ *Precondition: The server is not listening yet
+ *Postcondition: Returns true on success; otherwise the string holds the reason
+ */
+bool GameServer::listenUnix(string path, string& error)
+{
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if(path.size() >= sizeof(address.sun_path))
+    {
+        error = "socket path too long";
+        return false;
+    }
+    strcpy(address.sun_path, path.c_str());
+    
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if(listenFd < 0)
+    {
+        error = strerror(errno);
+        return false;
+    }
+    
+    unlink(path.c_str());
+    if(bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0
+       || listen(listenFd, SOMAXCONN) < 0)
+    {
+        error = strerror(errno);
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    return true;
+}
+
+/*
+ *Description: Makes every session's Computer play from the supplied book, or from none if it is null
+ *Precondition: run() has not been called; the book outlives the server
+ *Postcondition: Later moves consult the book
+ */
+void GameServer::setOpeningBook(const OpeningBook* book)
+{
+    openingBook = book;
+}
+
+/*
+ *Description: Makes every session's Computer answer each move within the supplied number of milliseconds
+ *Precondition: run() has not been called; the time is non-negative
+ *Postcondition: Later moves use the move time
+ */
+void GameServer::setMoveTime(double milliseconds)
+{
+    moveTime = milliseconds;
+}
+
+/*
+ *Description: Makes every session's Computer record its decisions in the supplied statistics; 0 turns it off
+ *Precondition: run() has not been called; the statistics outlive the server
+ *Postcondition: Later moves are recorded
+ */
+void GameServer::setStats(EngineStats* engineStats)
+{
+    stats = engineStats;
+}
+
+/*
+ *Description: Serves connections on the supplied number of worker threads
+ *Precondition: listenTcp or listenUnix succeeded
+ *Postcondition: Returns after stop() is called; every connection is closed
+ */
+void GameServer::run(int threads)
+{
+    int count = threads > 0 ? threads : static_cast<int>(thread::hardware_concurrency());
+    if(count < 1)
+        count = 1;
+    
+    vector<thread> workers;
+    for(int i = 1; i < count; i++)
+        workers.push_back(thread(&GameServer::serve, this));
+    serve();
+    for(size_t i = 0; i < workers.size(); i++)
+        workers[i].join();
+}
+
+/*
+ *Description: Asks run() to return. Safe to call from another thread or a signal handler.
+ *Precondition: N/A
+ *Postcondition: The workers finish their current events and exit
+ */
+void GameServer::stop()
+{
+    stopping.store(true);
+    uint64_t one = 1;
+    ssize_t written = write(wakeFd, &one, sizeof(one));
+    (void)written;
+}
+
+/*
+ *Description: Carries out one protocol command and returns its reply without a line break
+ *Precondition: N/A
+ *Postcondition: The reply is returned; the bool is set to true when the connection should close
+ */
+string GameServer::execute(const string& line, bool& closeConnection)
+{
+    istringstream in(line);
+    string command;
+    in >> command;
+    for(size_t i = 0; i < command.size(); i++)
+        command[i] = static_cast<char>(toupper(static_cast<unsigned char>(command[i])));
+    
+    closeConnection = false;
+    if(command.empty())
+        return "ERR empty command";
+    
+    if(command == "QUIT")
+    {
+        closeConnection = true;
+        return "BYE";
+    }
+    
+    if(command == "STATS")
+        return stats ? "OK " + stats->toJson() : "ERR statistics are off";
+    
+    if(command == "NEW")
+    {
+        string playerID = "X";
+        int width = 3, height = 3, winLength = 3;
+        Computer::Strategy strategy = defaultStrategy;
+        
+        string token;
+        vector<string> tokens;
+        while(in >> token)
+            tokens.push_back(token);
+        
+        size_t next = 0;
+        if(next < tokens.size() && (tokens[next] == "X" || tokens[next] == "O" || tokens[next] == "x" || tokens[next] == "o"))
+            playerID = string(1, static_cast<char>(toupper(static_cast<unsigned char>(tokens[next++][0]))));
+        if(next + 3 <= tokens.size() && isdigit(static_cast<unsigned char>(tokens[next][0])))
+        {
+            width = atoi(tokens[next].c_str());
+            height = atoi(tokens[next + 1].c_str());
+            winLength = atoi(tokens[next + 2].c_str());
+            next += 3;
+        }
+        if(next < tokens.size() && !Computer::parseStrategy(tokens[next++], strategy))
+            return "ERR unknown strategy";
+        if(next < tokens.size())
+            return "ERR usage: NEW [X|O] [width height winLength] [strategy]";
+        
+        const BoardGeometry* geometry;
+        try
+        {
+            geometry = &BoardGeometry::get(width, height, winLength);
+        }
+        catch(const invalid_argument&)
+        {
+            return "ERR unsupported board size";
+        }
+        
+        return createSession(*geometry, playerID, strategy);
+    }
+    
+    //The remaining commands all name a session; anything else is rejected before one is looked up
+    if(command != "MOVE" && command != "STATE" && command != "RESIGN")
+        return "ERR unknown command";
+    
+    uint64_t id = 0;
+    if(!(in >> id))
+        return "ERR usage: " + command + " <id>";
+    
+    int x = 0, y = 0;
+    if(command == "MOVE" && !(in >> x >> y))
+        return "ERR usage: MOVE <id> <x> <y>";
+    
+    if(id & LARGE_SESSION)
+    {
+        shared_ptr<LargeSession> large = findLargeSession(id);
+        if(!large)
+            return "ERR unknown session";
+        
+        lock_guard<mutex> sessionGuard(large->lock);
+        string reply = applyCommand(id, large->session, command, x, y);
+        if(large->session.isOver())
+            removeLargeSession(id);
+        return reply;
+    }
+    
+    //A classic game is unpacked and played without its shard's lock, so a slow decision holds up no other
+    //session. The result is stored only if no other command changed the game meanwhile; a game only gains
+    //stones, so an unchanged CompactGame means an untouched game. Otherwise the command runs again on top.
+    Shard& shard = getShard(id);
+    for(;;)
+    {
+        CompactGame stored;
+        {
+            lock_guard<mutex> guard(shard.lock);
+            SessionSlot* slot = findSlot(shard, id);
+            if(!slot)
+                return "ERR unknown session";
+            stored = slot->game;
+        }
+        
+        GameSession session = stored.expand(Random::derive(seed, id));
+        string reply = applyCommand(id, session, command, x, y);
+        
+        lock_guard<mutex> guard(shard.lock);
+        SessionSlot* slot = findSlot(shard, id);
+        if(!slot)
+            return "ERR unknown session";
+        if(slot->game != stored)
+            continue;
+        if(session.isOver())
+        {
+            slot->generation++;
+            shard.slots.release(static_cast<uint32_t>((id >> 6) & 0x3FFFFFF));
+            sessionCount.fetch_sub(1);
+        }
+        else
+            slot->game = CompactGame(session);
+        return reply;
+    }
+}
+
+/*
+ *Description: Accessor function that returns the number of games in progress
+ *Precondition: N/A
+ *Postcondition: A non-negative count is returned
+ */
+long GameServer::getSessionCount() const
+{
+    return sessionCount.load();
+}
+
+/*
+ *Description: Worker loop: waits on its own epoll instance until the server stops
+ *Precondition: The server is listening
+ *Postcondition: The worker's connections are closed
+ */
+void GameServer::serve()
+{
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    unordered_map<int, unique_ptr<Connection> > connections;
+    
+    epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN | EPOLLEXCLUSIVE;
+    event.data.fd = listenFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+    event.events = EPOLLIN;
+    event.data.fd = wakeFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+    
+    const int MAX_EVENTS = 64;
+    epoll_event events[MAX_EVENTS];
+    while(!stopping.load())
+    {
+        int ready = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        if(ready < 0 && errno != EINTR)
+            break;
+        
+        for(int i = 0; i < ready; i++)
+        {
+            int fd = events[i].data.fd;
+            if(fd == wakeFd)
+                continue;
+            if(fd == listenFd)
+            {
+                acceptConnections(epollFd, connections);
+                continue;
+            }
+            
+            unordered_map<int, unique_ptr<Connection> >::iterator found = connections.find(fd);
+            if(found == connections.end())
+                continue;
+            Connection& connection = *found->second;
+            
+            //Replies are written first, so a connection that stopped at MAX_OUTPUT resumes its received lines
+            //as soon as they have drained
+            bool open = !(events[i].events & (EPOLLERR | EPOLLHUP));
+            if(open && (events[i].events & EPOLLOUT))
+                open = flushConnection(epollFd, connection);
+            if(open && ((events[i].events & EPOLLIN) || connection.input.find('\n') != string::npos))
+                open = readConnection(connection);
+            if(open)
+                open = flushConnection(epollFd, connection);
+            if(!open || (connection.closing && connection.output.empty()))
+            {
+                epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, 0);
+                close(fd);
+                connections.erase(found);
+            }
+        }
+    }
+    
+    for(unordered_map<int, unique_ptr<Connection> >::iterator it = connections.begin(); it != connections.end(); ++it)
+        close(it->first);
+    close(epollFd);
+}
+
+/*
+ *Description: Accepts every pending connection and adds it to the supplied epoll instance and table
+ *Precondition: N/A
+ *Postcondition: The new connections are watched for input
+ */
+void GameServer::acceptConnections(int epollFd, unordered_map<int, unique_ptr<Connection> >& connections)
+{
+    for(;;)
+    {
+        int fd = accept4(listenFd, 0, 0, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if(fd < 0)
+            return;
+        
+        int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable)); //Fails harmlessly on Unix sockets
+        
+        unique_ptr<Connection> connection(new Connection());
+        connection->fd = fd;
+        connection->reading = true;
+        connection->writing = false;
+        connection->closing = false;
+        
+        epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = fd;
+        if(epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0)
+        {
+            close(fd);
+            continue;
+        }
+        connections[fd] = move(connection);
+    }
+}
+
+/*
+ *Description: Executes the complete lines already received, then reads the available bytes and executes
+ *             their lines, until MAX_OUTPUT bytes of replies are waiting to be written
+ *Precondition: N/A
+ *Postcondition: Returns false if an error occurred; once the peer has stopped sending, 'closing' is set
+ */
+bool GameServer::readConnection(Connection& connection)
+{
+    //A client that sends without reading its replies stops being read, so its replies cannot pile up
+    char buffer[4096];
+    for(;;)
+    {
+        executeLines(connection);
+        if(connection.closing || connection.output.size() >= MAX_OUTPUT)
+            break;
+        if(connection.input.size() > MAX_LINE)
+        {
+            connection.output += "ERR line too long\n";
+            connection.closing = true;
+            break;
+        }
+        
+        ssize_t received = read(connection.fd, buffer, sizeof(buffer));
+        
+        //A peer that has stopped sending still gets the replies to the lines it sent
+        if(received == 0)
+        {
+            connection.closing = true;
+            return true;
+        }
+        if(received < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            if(errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            return false;
+        }
+        connection.input.append(buffer, static_cast<size_t>(received));
+    }
+    return true;
+}
+
+/*
+ *Description: Executes the complete lines of the connection's input and queues their replies
+ *Precondition: N/A
+ *Postcondition: The input holds no complete line unless the connection is closing or MAX_OUTPUT bytes of
+ *               replies are waiting
+ */
+void GameServer::executeLines(Connection& connection)
+{
+    size_t start = 0;
+    size_t end;
+    while(!connection.closing && connection.output.size() < MAX_OUTPUT
+          && (end = connection.input.find('\n', start)) != string::npos)
+    {
+        string line = connection.input.substr(start, end - start);
+        if(!line.empty() && line[line.size() - 1] == '\r')
+            line.erase(line.size() - 1);
+        start = end + 1;
+        
+        bool closeConnection;
+        connection.output += execute(line, closeConnection);
+        connection.output += '\n';
+        connection.closing = closeConnection;
+    }
+    connection.input.erase(0, start);
+}
+
+/*
+ *Description: Writes as much pending output as the socket accepts
+ *Precondition: N/A
+ *Postcondition: Returns false if the connection should be closed
+ */
+bool GameServer::flushConnection(int epollFd, Connection& connection)
+{
+    size_t written = 0;
+    while(written < connection.output.size())
+    {
+        ssize_t sent = send(connection.fd, connection.output.data() + written,
+                            connection.output.size() - written, MSG_NOSIGNAL);
+        if(sent < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            if(errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            return false;
+        }
+        written += static_cast<size_t>(sent);
+    }
+    connection.output.erase(0, written);
+    
+    //Watch for EPOLLOUT only while replies are waiting. Input is not watched once closing, where a peer that
+    //has shut down its side would report EPOLLIN until the replies are written, nor while MAX_OUTPUT bytes
+    //of replies wait, where a level-triggered EPOLLIN would fire without being read
+    bool pending = !connection.output.empty();
+    bool reading = !connection.closing && connection.output.size() < MAX_OUTPUT;
+    if(pending != connection.writing || reading != connection.reading)
+    {
+        epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = (reading ? static_cast<uint32_t>(EPOLLIN | EPOLLRDHUP) : 0u)
+                       | (pending ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+        event.data.fd = connection.fd;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+        connection.writing = pending;
+        connection.reading = reading;
+    }
+    return true;
+}
+
+/*
+ *Description: Starts a game and stores it unless the Computer's opening move already ended it
+ *Precondition: N/A
+ *Postcondition: The reply describing the new session is returned
+ */
+string GameServer::createSession(const BoardGeometry& geometry, string playerID, Computer::Strategy strategy)
+{
+    uint64_t number = nextSessionId.fetch_add(1);
+    if(!CompactGame::fits(geometry))
+    {
+        uint64_t id = LARGE_SESSION | number;
+        shared_ptr<LargeSession> large(new LargeSession(GameSession(geometry, playerID, strategy,
+                                                                    Random::derive(seed, id))));
+        lock_guard<mutex> sessionGuard(large->lock);
+        large->session.start(getWorkerComputer());
+        if(!large->session.isOver())
+        {
+            Shard& shard = getShard(id);
+            lock_guard<mutex> guard(shard.lock);
+            shard.largeSessions[id] = large;
+            sessionCount.fetch_add(1);
+        }
+        return describe(id, large->session);
+    }
+    
+    //The id records the shard, the slot and the generation the slot takes once the game is stored. The
+    //Computer opens outside the shard's lock; until then the slot keeps its even generation, so findSlot
+    //hides it from a command that guesses the id.
+    uint64_t shardIndex = number % SHARD_COUNT;
+    Shard& shard = shards[shardIndex];
+    uint32_t slotIndex;
+    uint64_t id;
+    {
+        lock_guard<mutex> guard(shard.lock);
+        slotIndex = shard.slots.acquire();
+        uint32_t generation = shard.slots.get(slotIndex).generation + 1;
+        id = shardIndex | (uint64_t(slotIndex) << 6) | (uint64_t(generation & 0x7FFFFFFF) << 32);
+    }
+    
+    GameSession session(geometry, playerID, strategy, Random::derive(seed, id));
+    session.start(getWorkerComputer());
+    
+    //A game the opening move already ended skips the id's generation, so the id is never reused
+    lock_guard<mutex> guard(shard.lock);
+    SessionSlot& slot = shard.slots.get(slotIndex);
+    if(session.isOver())
+    {
+        slot.generation += 2;
+        shard.slots.release(slotIndex);
+    }
+    else
+    {
+        slot.generation++;
+        slot.game = CompactGame(session);
+        sessionCount.fetch_add(1);
+    }
+    return describe(id, session);
+}
+
+/*
+ *Description: Carries out a MOVE, RESIGN or STATE command on a session
+ *Precondition: The caller holds the session's lock
+ *Postcondition: The reply is returned
+ */
+string GameServer::applyCommand(uint64_t id, GameSession& session, const string& command, int x, int y)
+{
+    if(command == "MOVE")
+    {
+        string error;
+        if(!session.playMove(x, y, getWorkerComputer(), error))
+            return "ERR " + error;
+    }
+    else if(command == "RESIGN")
+        session.resign();
+    else if(command != "STATE")
+        return "ERR unknown command";
+    return describe(id, session);
+}
+
+/*
+ *Description: Formats the "OK <id> <status> <board> <computer move>" reply of a session
+ *Precondition: The caller holds the session's lock
+ *Postcondition: A string is returned
+ */
+string GameServer::describe(uint64_t id, const GameSession& session) const
+{
+    string reply = "OK ";
+    reply += to_string(id);
+    reply += ' ';
+    reply += session.getStatus();
+    reply += ' ';
+    reply += session.getBoardString();
+    reply += ' ';
+    reply += session.getLastComputerMove();
+    return reply;
+}
+
+/*
+ *Description: Looks up the pool slot of a classic session by id
+ *Precondition: The caller holds the shard's lock
+ *Postcondition: Returns the slot, or 0 if the id names no game in progress
+ */
+GameServer::SessionSlot* GameServer::findSlot(Shard& shard, uint64_t id)
+{
+    uint32_t slotIndex = static_cast<uint32_t>((id >> 6) & 0x3FFFFFF);
+    uint32_t generation = static_cast<uint32_t>(id >> 32);
+    if(!shard.slots.contains(slotIndex))
+        return 0;
+    
+    SessionSlot& slot = shard.slots.get(slotIndex);
+    if((slot.generation & 1) == 0 || (slot.generation & 0x7FFFFFFF) != generation)
+        return 0;
+    return &slot;
+}
+
+/*
+ *Description: Looks up a session on a board other than the classic one by id
+ *Precondition: N/A
+ *Postcondition: Returns the session, or an empty pointer if there is none
+ */
+shared_ptr<GameServer::LargeSession> GameServer::findLargeSession(uint64_t id)
+{
+    Shard& shard = getShard(id);
+    lock_guard<mutex> guard(shard.lock);
+    unordered_map<uint64_t, shared_ptr<LargeSession> >::iterator found = shard.largeSessions.find(id);
+    if(found == shard.largeSessions.end())
+        return shared_ptr<LargeSession>();
+    return found->second;
+}
+
+/*
+ *Description: Removes a session on a board other than the classic one from the table
+ *Precondition: N/A
+ *Postcondition: The id no longer finds a session
+ */
+void GameServer::removeLargeSession(uint64_t id)
+{
+    Shard& shard = getShard(id);
+    lock_guard<mutex> guard(shard.lock);
+    if(shard.largeSessions.erase(id) > 0)
+        sessionCount.fetch_sub(1);
+}
+
+/*
+ *Description: Returns the Computer of the calling thread, which plays every game the thread serves
+ *Precondition: N/A
+ *Postcondition: A Computer is returned
+ */
+Computer& GameServer::getWorkerComputer() const
+{
+    //A Computer only keeps caches, so one per thread can play any number of games
+    static thread_local Computer computer;
+    computer.setOpeningBook(openingBook);
+    computer.setMoveTime(moveTime);
+    computer.setStats(stats);
+    return computer;
+}
+
+/*
+ *Description: Returns the shard of the session table that holds the supplied id
+ *Precondition: N/A
+ *Postcondition: A Shard is returned
+ */
+GameServer::Shard& GameServer::getShard(uint64_t id)
+{
+    return shards[id % SHARD_COUNT];
+}
@@ -0,0 +1,298 @@
+/************************************************************************************
+ Title:         GameServer.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   A game server that hosts many GameSessions for clients on the local
+                machine. Clients connect over TCP(127.0.0.1) or a Unix socket and send
+                one command per line; every command is answered with one line.
+ 
+ Purpose:       Lets one process serve tens of thousands of concurrent games. Each worker
+                thread runs its own epoll event loop over non-blocking sockets, and all
+                workers accept from the same listening socket. Sessions are not tied to a
+                connection; they live in a table split into shards with their own locks,
+                so any connection can address any session. Ids encode where a session
+                is stored: classic games hold their shard in bits 0-5, their pool slot in
+                bits 6-31 and the slot's generation in bits 32-62, so a stale id is
+                rejected; games on other boards have bit 63 set.
+ 
+ Usage:         GameServer server(Computer::TABLE, seed);
+                server.listenTcp(7373, error); //or server.listenUnix(path, error)
+                server.run(threads); //blocks until stop() is called
+ 
+                Protocol(commands are case-insensitive, fields are separated by spaces):
+                  NEW [X|O] [width height winLength] [strategy]
+                  MOVE <id> <x> <y>
+                  STATE <id>
+                  RESIGN <id>
+                  STATS
+                  QUIT
+                Replies are "OK <id> <status> <board> <computer move>", where status is
+                playing, won, lost, tie or resigned(from the client's point of view),
+                board lists the Locations row after row as X, O or '.', and the
+                Computer's latest move is "x,y" or "-". Errors are "ERR <reason>" and
+                QUIT is answered with "BYE". A session is removed once its game is over.
+                STATS is answered with "OK " and the decision statistics of every worker's
+                Computer as one line of JSON(see EngineStats::toJson), if they are on.
+ 
+ Build with:    Compile with server.cpp. Linux only(epoll, eventfd); link with -pthread.
+ 
+ Modifications: Games on the classic board are stored as six-byte CompactGames in an
+                ObjectPool per shard, and each worker plays every game with its own
+                Computer, so an idle game costs a dozen bytes and creating one allocates
+                nothing once the pool has grown. Larger boards keep a full GameSession.
+                The workers' Computers can play from a shared OpeningBook.
+                A move time makes every Computer answer on time(see Computer::setMoveTime).
+                Every Computer can record its decisions in a shared EngineStats, which the
+                STATS command reports.
+ ***********************************************************************************/
+
+#ifndef TicTacToe_GameServer_h
+#define TicTacToe_GameServer_h
+
+#include "CompactGame.h"
+#include "Computer.h"
+#include "EngineStats.h"
+#include "GameSession.h"
+#include "ObjectPool.h"
+#include "OpeningBook.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+using namespace std;
+
+class GameServer {
+
+public:
+    GameServer(Computer::Strategy, uint64_t);
+    /*
+     *Description: Constructor that sets the Strategy used when a NEW command names none, and the seed
+     *             from which every session's Computer is seeded
+     *Precondition: N/A
+     *Postcondition: The server has no sessions and is not listening
+     */
+    
+    ~GameServer();
+    /*
+     *Description: Destructor that closes the listening socket
+     *Precondition: run() has returned
+     *Postcondition: The sockets are closed
+     */
+    
+    bool listenTcp(int, string&);
+    /*
+     *Description: Listens for TCP connections on 127.0.0.1 at the supplied port
+     *Precondition: The server is not listening yet
+     *Postcondition: Returns true on success; otherwise the string holds the reason
+     */
+    
+    bool listenUnix(string, string&);
+    /*
+     *Description: Listens for connections on a Unix socket at the supplied path, replacing any file there
+     *Precondition: The server is not listening yet
+     *Postcondition: Returns true on success; otherwise the string holds the reason
+     */
+    
+    void setOpeningBook(const OpeningBook*);
+    /*
+     *Description: Makes every session's Computer play from the supplied book, or from none if it is null
+     *Precondition: run() has not been called; the book outlives the server
+     *Postcondition: Later moves consult the book
+     */
+    
+    void setMoveTime(double);
+    /*
+     *Description: Makes every session's Computer answer each move within the supplied number of
+     *             milliseconds using the anytime mode(see Computer::setMoveTime); 0 turns it off
+     *Precondition: run() has not been called; the time is non-negative
+     *Postcondition: Later moves use the move time
+     */
+    
+    void setStats(EngineStats*);
+    /*
+     *Description: Makes every session's Computer record its decisions in the supplied statistics, which
+     *             the STATS command reports; 0 turns recording off
+     *Precondition: run() has not been called; the statistics outlive the server
+     *Postcondition: Later moves are recorded
+     */
+    
+    void run(int);
+    /*
+     *Description: Serves connections on the supplied number of worker threads(0 selects one per
+     *             hardware thread), the calling thread being one of them
+     *Precondition: listenTcp or listenUnix succeeded
+     *Postcondition: Returns after stop() is called; every connection is closed
+     */
+    
+    void stop();
+    /*
+     *Description: Asks run() to return. Safe to call from another thread or a signal handler.
+     *Precondition: N/A
+     *Postcondition: The workers finish their current events and exit
+     */
+    
+    string execute(const string&, bool&);
+    /*
+     *Description: Carries out one protocol command and returns its reply without a line break
+     *Precondition: N/A
+     *Postcondition: The reply is returned; the bool is set to true when the connection should close
+     */
+    
+    long getSessionCount() const;
+    /*
+     *Description: Accessor function that returns the number of games in progress
+     *Precondition: N/A
+     *Postcondition: A non-negative count is returned
+     */
+    
+    static const int SHARD_COUNT = 64; //Number of independently locked parts of the session table
+    static const size_t MAX_LINE = 256; //Longest accepted command; longer lines close the connection
+    static const size_t MAX_OUTPUT = 64 * 1024; //Unwritten replies at which a connection's input is no longer read
+    static const uint64_t LARGE_SESSION = uint64_t(1) << 63; //Id bit of sessions stored as a full GameSession
+
+private:
+    struct Connection {
+        int fd; //Non-blocking socket
+        string input; //Received bytes not yet forming a whole line
+        string output; //Replies not yet written
+        bool reading; //Whether the socket is watched for EPOLLIN
+        bool writing; //Whether the socket is also watched for EPOLLOUT
+        bool closing; //Close once 'output' is written
+    };
+    
+    //A pooled classic game; the generation is odd while the slot holds a game in progress
+    struct SessionSlot {
+        uint32_t generation; //Incremented whenever the slot is acquired or released
+        CompactGame game; //The stored game
+        
+        SessionSlot() : generation(0) {}
+    };
+    
+    //A game on a board other than the classic one
+    struct LargeSession {
+        mutex lock; //Guards 'session'
+        GameSession session; //The game in progress
+        
+        LargeSession(const GameSession& game) : session(game) {}
+    };
+    
+    struct Shard {
+        mutex lock; //Guards 'slots' and 'largeSessions'; never held while a Computer chooses a move
+        ObjectPool<SessionSlot> slots; //Classic games in progress
+        unordered_map<uint64_t, shared_ptr<LargeSession> > largeSessions; //Other games in progress by id
+    };
+    
+    void serve();
+    /*
+     *Description: Worker loop: waits on its own epoll instance for new connections, readable and
+     *             writable sockets until the server stops
+     *Precondition: The server is listening
+     *Postcondition: The worker's connections are closed
+     */
+    
+    void acceptConnections(int, unordered_map<int, unique_ptr<Connection> >&);
+    /*
+     *Description: Accepts every pending connection and adds it to the supplied epoll instance and table
+     *Precondition: N/A
+     *Postcondition: The new connections are watched for input
+     */
+    
+    bool readConnection(Connection&);
+    /*
+     *Description: Executes the complete lines already received, then reads the available bytes and
+     *             executes their lines, until MAX_OUTPUT bytes of replies are waiting to be written
+     *Precondition: N/A
+     *Postcondition: Returns false if an error occurred; once the peer has stopped sending, 'closing' is set
+     */
+    
+    void executeLines(Connection&);
+    /*
+     *Description: Executes the complete lines of the connection's input and queues their replies
+     *Precondition: N/A
+     *Postcondition: The input holds no complete line unless the connection is closing or MAX_OUTPUT bytes
+     *               of replies are waiting
+     */
+    
+    bool flushConnection(int, Connection&);
+    /*
+     *Description: Writes as much pending output as the socket accepts, watches for EPOLLOUT while some
+     *             remains and for EPOLLIN while less than MAX_OUTPUT remains and the connection stays open
+     *Precondition: N/A
+     *Postcondition: Returns false if the connection should be closed
+     */
+    
+    string createSession(const BoardGeometry&, string, Computer::Strategy);
+    /*
+     *Description: Starts a game of the supplied geometry, player ID and Strategy and stores it unless the
+     *             Computer's opening move already ended it
+     *Precondition: N/A
+     *Postcondition: The reply describing the new session is returned
+     */
+    
+    string applyCommand(uint64_t, GameSession&, const string&, int, int);
+    /*
+     *Description: Carries out a MOVE(at the supplied x and y), RESIGN or STATE command on a session
+     *Precondition: The caller holds the session's lock or its own unpacked copy of a classic session
+     *Postcondition: The reply is returned
+     */
+    
+    string describe(uint64_t, const GameSession&) const;
+    /*
+     *Description: Formats the "OK <id> <status> <board> <computer move>" reply of a session
+     *Precondition: The caller holds the session's lock or its own unpacked copy of a classic session
+     *Postcondition: A string is returned
+     */
+    
+    SessionSlot* findSlot(Shard&, uint64_t);
+    /*
+     *Description: Looks up the pool slot of a classic session by id
+     *Precondition: The caller holds the shard's lock
+     *Postcondition: Returns the slot, or 0 if the id names no game in progress
+     */
+    
+    shared_ptr<LargeSession> findLargeSession(uint64_t);
+    /*
+     *Description: Looks up a session on a board other than the classic one by id
+     *Precondition: N/A
+     *Postcondition: Returns the session, or an empty pointer if there is none
+     */
+    
+    void removeLargeSession(uint64_t);
+    /*
+     *Description: Removes a session on a board other than the classic one from the table
+     *Precondition: N/A
+     *Postcondition: The id no longer finds a session
+     */
+    
+    Computer& getWorkerComputer() const;
+    /*
+     *Description: Returns the Computer of the calling thread, which plays every game the thread serves
+     *Precondition: N/A
+     *Postcondition: A Computer is returned
+     */
+    
+    Shard& getShard(uint64_t);
+    /*
+     *Description: Returns the shard of the session table that holds the supplied id
+     *Precondition: N/A
+     *Postcondition: A Shard is returned
+     */
+    
+    Computer::Strategy defaultStrategy; //Strategy of sessions whose NEW command names none
+    const OpeningBook* openingBook; //Book of every session's Computer, or 0
+    double moveTime; //Milliseconds per move of every session's Computer, or 0
+    EngineStats* stats; //Where every session's Computer records its decisions, or 0
+    uint64_t seed; //Seed the sessions' Computers are derived from
+    int listenFd; //Listening socket, or -1
+    int wakeFd; //eventfd that wakes every worker on stop()
+    atomic<bool> stopping; //Set by stop()
+    atomic<uint64_t> nextSessionId; //Numbers the sessions, which spreads classic games over the shards
+    atomic<long> sessionCount; //Games in progress
+    Shard shards[SHARD_COUNT]; //The session table
+};
+#endif
@@ -0,0 +1,207 @@
+/************************************************************************************
+ Title:         GameSession.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of GameSession.h. One game between a remote player and
+                the Computer.
+ 
+ Purpose:       Provides the game logic of a server session without any networking.
+ 
+ Usage:         session.start(computer); session.playMove(x, y, computer, error);
+ 
+ Build with:    Compile with server.cpp.
+ 
+ Modifications: Sessions borrow a Computer instead of owning one; added restore().
+ ***********************************************************************************/
+
+#include "GameSession.h"
+#include "Random.h"
+#include <sstream>
+using namespace std;
+
+/*
+ *Description: Constructor that sets up a game of the supplied geometry
+ *Precondition: The BoardGeometry outlives the session
+ *Postcondition: The board is empty; call start() before the first player move
+ */
+GameSession::GameSession(const BoardGeometry& geometry, string playerID, Computer::Strategy computerStrategy,
+                         uint64_t sessionSeed)
+    : board(geometry), strategy(computerStrategy), seed(sessionSeed), resigned(false), lastComputerCell(-1)
+{
+    board.setPlayerID(playerID);
+}
+
+/*
+ *Description: Lets the Computer make the opening move if it plays 'X'
+ *Precondition: No move has been made
+ *Postcondition: The Computer has moved if it was its turn
+ */
+void GameSession::start(Computer& computer)
+{
+    if(board.getComputerID() == "X")
+        playComputerMove(computer);
+}
+
+/*
+ *Description: Plays the player's move at (x,y), then the Computer's reply unless the game ended
+ *Precondition: N/A
+ *Error Checking: The game must be in progress and (x,y) must be a vacant Location on the board.
+ *Postcondition: Returns true if the move was played; otherwise the string holds the reason
+ */
+bool GameSession::playMove(int x, int y, Computer& computer, string& error)
+{
+    if(isOver())
+    {
+        error = "game over";
+        return false;
+    }
+    if(!board.getGeometry().contains(x, y))
+    {
+        error = "off the board";
+        return false;
+    }
+    if(!board.makeMove(Location(x, y), board.getPlayerID()))
+    {
+        error = "occupied";
+        return false;
+    }
+    
+    if(!board.getGameStatus())
+        playComputerMove(computer);
+    return true;
+}
+
+/*
+ *Description: Ends the game as a loss for the player
+ *Precondition: N/A
+ *Postcondition: getStatus() returns "resigned" unless the game had already ended
+ */
+void GameSession::resign()
+{
+    if(!isOver())
+        resigned = true;
+}
+
+/*
+ *Description: Restores a stored game
+ *Precondition: The session was constructed with the game's geometry, player ID, Strategy and seed
+ *Postcondition: The session continues the stored game
+ */
+void GameSession::restore(const CellMask& xMask, const CellMask& oMask, bool hasResigned, int computerCell)
+{
+    board.setPosition(xMask, oMask);
+    resigned = hasResigned;
+    lastComputerCell = computerCell;
+}
+
+/*
+ *Description: Returns the state of the game from the player's point of view
+ *Precondition: N/A
+ *Postcondition: A string is returned
+ */
+string GameSession::getStatus() const
+{
+    if(resigned)
+        return "resigned";
+    if(board.hasPlayerWon())
+        return "won";
+    if(board.hasComputerWon())
+        return "lost";
+    if(board.isTie())
+        return "tie";
+    return "playing";
+}
+
+/*
+ *Description: Returns the board row after row as one character per Location
+ *Precondition: N/A
+ *Postcondition: A string of width * height characters is returned
+ */
+string GameSession::getBoardString() const
+{
+    const BoardGeometry& geometry = board.getGeometry();
+    const CellMask& xMask = board.getMask(0);
+    const CellMask& oMask = board.getMask(1);
+    
+    string cells(geometry.getCellCount(), '.');
+    for(int cell = 0; cell < geometry.getCellCount(); cell++)
+    {
+        if(xMask.test(cell))
+            cells[cell] = 'X';
+        else if(oMask.test(cell))
+            cells[cell] = 'O';
+    }
+    return cells;
+}
+
+/*
+ *Description: Returns the Computer's latest move as "x,y", or "-" if it has not moved
+ *Precondition: N/A
+ *Postcondition: A string is returned
+ */
+string GameSession::getLastComputerMove() const
+{
+    if(lastComputerCell < 0)
+        return "-";
+    
+    Location move = board.getGeometry().getLocation(lastComputerCell);
+    ostringstream text;
+    text << move.x << "," << move.y;
+    return text.str();
+}
+
+/*
+ *Description: Returns true once the game has been won, lost, tied or resigned
+ *Precondition: N/A
+ *Postcondition: A boolean value is returned
+ */
+bool GameSession::isOver() const
+{
+    return resigned || board.getGameStatus();
+}
+
+/*
+ *Description: Accessor functions for the board, the Computer's Strategy, whether the player resigned
+ *             and the cell of the Computer's latest move
+ *Precondition: N/A
+ *Postcondition: The requested value is returned
+ */
+const GameBoard& GameSession::getBoard() const
+{
+    return board;
+}
+
+Computer::Strategy GameSession::getStrategy() const
+{
+    return strategy;
+}
+
+bool GameSession::isResigned() const
+{
+    return resigned;
+}
+
+int GameSession::getLastComputerCell() const
+{
+    return lastComputerCell;
+}
+
+/*
+ *Description: Asks the Computer for its move and records it
+ *Precondition: The game is in progress
+ *Postcondition: The Computer's move is on the board
+ */
+void GameSession::playComputerMove(Computer& computer)
+{
+    //The seed depends only on the game and the move number, whichever Computer is used
+    int stones = board.getGeometry().getCellCount() - board.getEmptyCount();
+    computer.setStrategy(strategy);
+    computer.setSeed(Random::derive(seed, static_cast<uint64_t>(stones)));
+    
+    Location move = computer.chooseNextMove(board);
+    board.makeMove(move, board.getComputerID());
+    lastComputerCell = board.getGeometry().getCell(move.x, move.y);
+}
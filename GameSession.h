@@ -0,0 +1,138 @@
+/************************************************************************************
+ Title:         GameSession.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   One game between a remote player and the Computer, as hosted by the
+                GameServer. A session holds its GameBoard, the Computer's Strategy and
+                seed, and answers each player move with the Computer's reply.
+ 
+ Purpose:       Provides the game logic of a server session(create, move, query state,
+                resign) without any networking, so the protocol can be driven directly.
+ 
+ Usage:         GameSession session(geometry, "X", Computer::TABLE, seed);
+                session.start(computer); //the Computer opens if the player chose 'O'
+                session.playMove(x, y, computer, error);
+                session.getStatus(); session.getBoardString();
+                The Computer is borrowed for each call, so one Computer can serve many
+                sessions; it is set to the session's Strategy and a seed derived from the
+                session seed and the move number, which keeps every game reproducible.
+                A session is not thread safe.
+ 
+ Build with:    Compile with server.cpp.
+ 
+ Modifications: Sessions borrow a Computer instead of owning one; added the accessors and
+                restore() used by CompactGame.
+ ***********************************************************************************/
+
+#ifndef TicTacToe_GameSession_h
+#define TicTacToe_GameSession_h
+
+#include "BoardGeometry.h"
+#include "CellMask.h"
+#include "Computer.h"
+#include "GameBoard.h"
+#include "Location.h"
+#include <cstdint>
+#include <string>
+using namespace std;
+
+class GameSession {
+
+public:
+    GameSession(const BoardGeometry&, string, Computer::Strategy, uint64_t);
+    /*
+     *Description: Constructor that sets up a game of the supplied geometry in which the player uses
+     *             the supplied ID('X' or 'O') and the Computer the supplied Strategy and seed
+     *Precondition: The BoardGeometry outlives the session
+     *Postcondition: The board is empty; call start() before the first player move
+     */
+    
+    void start(Computer&);
+    /*
+     *Description: Lets the Computer make the opening move if it plays 'X'('X' always moves first)
+     *Precondition: No move has been made
+     *Postcondition: The Computer has moved if it was its turn
+     */
+    
+    bool playMove(int, int, Computer&, string&);
+    /*
+     *Description: Plays the player's move at (x,y), then the Computer's reply unless the game ended
+     *Precondition: N/A
+     *Error Checking: The game must be in progress and (x,y) must be a vacant Location on the board.
+     *Postcondition: Returns true if the move was played; otherwise the string holds the reason and the
+     *               board is unchanged
+     */
+    
+    void resign();
+    /*
+     *Description: Ends the game as a loss for the player
+     *Precondition: N/A
+     *Postcondition: getStatus() returns "resigned" unless the game had already ended
+     */
+    
+    void restore(const CellMask&, const CellMask&, bool, int);
+    /*
+     *Description: Restores a stored game from its 'X' and 'O' masks, whether the player resigned and the
+     *             cell of the Computer's latest move(-1 if it has not moved)
+     *Precondition: The session was constructed with the game's geometry, player ID, Strategy and seed
+     *Postcondition: The session continues the stored game
+     */
+    
+    string getStatus() const;
+    /*
+     *Description: Returns the state of the game from the player's point of view: "playing", "won",
+     *             "lost", "tie" or "resigned"
+     *Precondition: N/A
+     *Postcondition: A string is returned
+     */
+    
+    string getBoardString() const;
+    /*
+     *Description: Returns the board row after row as one character per Location: 'X', 'O' or '.'
+     *Precondition: N/A
+     *Postcondition: A string of width * height characters is returned
+     */
+    
+    string getLastComputerMove() const;
+    /*
+     *Description: Returns the Computer's latest move as "x,y", or "-" if it has not moved
+     *Precondition: N/A
+     *Postcondition: A string is returned
+     */
+    
+    bool isOver() const;
+    /*
+     *Description: Returns true once the game has been won, lost, tied or resigned
+     *Precondition: N/A
+     *Postcondition: A boolean value is returned
+     */
+    
+    const GameBoard& getBoard() const;
+    Computer::Strategy getStrategy() const;
+    bool isResigned() const;
+    int getLastComputerCell() const;
+    /*
+     *Description: Accessor functions for the board, the Computer's Strategy, whether the player resigned
+     *             and the cell of the Computer's latest move(-1 if it has not moved)
+     *Precondition: N/A
+     *Postcondition: The requested value is returned
+     */
+
+private:
+    void playComputerMove(Computer&);
+    /*
+     *Description: Asks the Computer for its move and records it
+     *Precondition: The game is in progress
+     *Postcondition: The Computer's move is on the board
+     */
+    
+    GameBoard board; //The game in progress
+    Computer::Strategy strategy; //How the Computer chooses its moves
+    uint64_t seed; //Seed of the Computer's random choices in this game
+    bool resigned; //Whether the player gave up
+    int lastComputerCell; //Cell of the Computer's latest move, or -1
+};
+#endif
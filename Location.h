@@ -5,8 +5,8 @@
  
  Created On:  February 2, 2014
  
- Description: Auxliary Structure that defines a location on the 3x3 
-              Tic-Tac-Toe board.
+ Description: Auxliary Structure that defines a location on the
+              Tic-Tac-Toe board(3x3 unless a larger BoardGeometry is used).
  
  Purpose:     Contains a 'x' and 'y' coordinate for any location on the board.
               Provides functionality to identify if a particular location on the
@@ -15,11 +15,11 @@
  
  Usage:       Location, Location(int,int)
               Initialize to default location to (0,0) or any (x,y) that falls within:
-              0 <= x <= 2, 0 <= y <= 2
+              0 <= x < board height(row), 0 <= y < board width(column)
  
  Build with:  Compile with main.cpp. Written with Xcode on OS X 10.8.5 
  
- Modifications: N/A
+ Modifications: Coordinates are bounded by the board's BoardGeometry rather than 0..2.
 ***********************************************************************************/
 #ifndef TicTacToe_Location_h
 #define TicTacToe_Location_h
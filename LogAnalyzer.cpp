@@ -0,0 +1,298 @@
+/************************************************************************************
+ Title:         LogAnalyzer.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of LogAnalyzer.h. Replays memory-mapped game logs in
+                parallel against the SolvedTable.
+ 
+ Purpose:       Measures how often an engine misplays over very large game logs.
+ 
+ Usage:         analyzer.addFile(path, error); LogAnalysis analysis = analyzer.run(threads);
+ 
+ Build with:    make analyze. Linux only(mmap); link with -pthread.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#include "LogAnalyzer.h"
+#include "GameBoard.h"
+#include "GameRecordReader.h"
+#include "SolvedTable.h"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+using namespace std;
+
+/*
+ *Description: Constructor of an analyzer without files
+ *Precondition: N/A
+ *Postcondition: Files can be added
+ */
+LogAnalyzer::LogAnalyzer() : bitsPerCell(GameRecord::getBitsPerCell(BoardGeometry::classic())), nextChunk(0)
+{
+}
+
+/*
+ *Description: Destructor that unmaps the files
+ *Precondition: run() is not in progress
+ *Postcondition: The files are unmapped
+ */
+LogAnalyzer::~LogAnalyzer()
+{
+    for(size_t i = 0; i < files.size(); i++)
+        munmap(const_cast<unsigned char*>(files[i].data), files[i].size);
+}
+
+/*
+ *Description: Maps the record file at the supplied path and splits it into its blocks
+ *Precondition: N/A
+ *Error Checking: The file must be a record file of 3x3 games.
+ *Postcondition: Returns true on success; otherwise the string holds the reason
+ */
+bool LogAnalyzer::addFile(const string& path, string& error)
+{
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if(fd < 0)
+    {
+        error = strerror(errno);
+        return false;
+    }
+    
+    struct stat status;
+    if(fstat(fd, &status) < 0 || status.st_size < static_cast<off_t>(GameRecord::FILE_HEADER_SIZE))
+    {
+        error = "not a game record file";
+        close(fd);
+        return false;
+    }
+    
+    size_t size = static_cast<size_t>(status.st_size);
+    void* mapping = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(mapping == MAP_FAILED)
+    {
+        error = strerror(errno);
+        return false;
+    }
+    madvise(mapping, size, MADV_SEQUENTIAL);
+    
+    MappedFile file;
+    file.data = static_cast<const unsigned char*>(mapping);
+    file.size = size;
+    
+    const BoardGeometry* geometry;
+    int bitsPerCell;
+    if(!GameRecordReader::readHeader(file.data, size, geometry, bitsPerCell, error) || !geometry->isClassic())
+    {
+        if(error.empty())
+            error = "perfect play is only known for 3x3 games";
+        munmap(mapping, size);
+        return false;
+    }
+    files.push_back(file);
+    
+    //Only the block headers are read here; the workers verify and decode the payloads
+    size_t offset = GameRecord::FILE_HEADER_SIZE;
+    while(offset < size)
+    {
+        Chunk chunk;
+        chunk.header = file.data + offset;
+        chunk.available = size - offset;
+        chunks.push_back(chunk);
+        
+        if(chunk.available < GameRecord::BLOCK_HEADER_SIZE)
+            break;
+        offset += GameRecord::BLOCK_HEADER_SIZE + GameRecord::getWord(chunk.header);
+    }
+    return true;
+}
+
+/*
+ *Description: Returns the name of the supplied Blunder
+ *Precondition: N/A
+ *Postcondition: A string is returned
+ */
+string LogAnalyzer::getBlunderName(Blunder blunder)
+{
+    switch(blunder)
+    {
+        case MISSED_WIN:
+            return "missed win";
+        case LOST_WIN:
+            return "lost forced win";
+        case MISSED_BLOCK:
+            return "missed block";
+        default:
+            return "missed fork block";
+    }
+}
+
+/*
+ *Description: Analyzes every game of the added files on the supplied number of threads
+ *Precondition: N/A
+ *Postcondition: The totals of every file are returned
+ */
+LogAnalysis LogAnalyzer::run(int threads)
+{
+    if(threads <= 0)
+        threads = max(1u, thread::hardware_concurrency());
+    
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    
+    nextChunk.store(0);
+    vector<LogAnalysis> partial(threads);
+    vector<thread> workers;
+    for(int i = 1; i < threads; i++)
+        workers.push_back(thread(&LogAnalyzer::analyzeChunks, this, ref(partial[i])));
+    analyzeChunks(partial[0]);
+    for(size_t i = 0; i < workers.size(); i++)
+        workers[i].join();
+    
+    LogAnalysis analysis;
+    for(int i = 0; i < threads; i++)
+        analysis.add(partial[i]);
+    for(size_t i = 0; i < files.size(); i++)
+        analysis.bytes += static_cast<long>(files[i].size);
+    analysis.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return analysis;
+}
+
+/*
+ *Description: Worker loop: claims chunks until every one is analyzed
+ *Precondition: N/A
+ *Postcondition: The worker's totals are added to the supplied analysis
+ */
+void LogAnalyzer::analyzeChunks(LogAnalysis& analysis)
+{
+    for(;;)
+    {
+        size_t index = nextChunk.fetch_add(1, memory_order_relaxed);
+        if(index >= chunks.size())
+            return;
+        analyzeChunk(chunks[index], analysis);
+    }
+}
+
+/*
+ *Description: Verifies one block and analyzes each of its games
+ *Precondition: N/A
+ *Postcondition: The block's totals are added to the supplied analysis
+ */
+void LogAnalyzer::analyzeChunk(const Chunk& chunk, LogAnalysis& analysis) const
+{
+    if(chunk.available < GameRecord::BLOCK_HEADER_SIZE)
+    {
+        analysis.damagedBlocks++;
+        return;
+    }
+    
+    size_t payload = GameRecord::getWord(chunk.header);
+    uint32_t games = GameRecord::getWord(chunk.header + 4);
+    const unsigned char* next = chunk.header + GameRecord::BLOCK_HEADER_SIZE;
+    if(payload > chunk.available - GameRecord::BLOCK_HEADER_SIZE
+       || GameRecord::checksum(next, payload) != GameRecord::getWord(chunk.header + 8))
+    {
+        analysis.damagedBlocks++;
+        return;
+    }
+    
+    const unsigned char* end = next + payload;
+    GameRecord record;
+    for(uint32_t i = 0; i < games; i++)
+    {
+        if(!record.decode(next, end, bitsPerCell))
+        {
+            analysis.damagedBlocks++;
+            return;
+        }
+        analyzeGame(record, analysis);
+    }
+}
+
+/*
+ *Description: Replays one game and classifies each of its moves
+ *Precondition: N/A
+ *Postcondition: The game's totals are added to the supplied analysis
+ */
+void LogAnalyzer::analyzeGame(const GameRecord& record, LogAnalysis& analysis) const
+{
+    analysis.games++;
+    analysis.results[record.getResult()]++;
+    
+    unsigned short stones[2] = { 0, 0 }; //'X' and 'O'
+    bool over = false;
+    for(int i = 0; i < record.getMoveCount(); i++)
+    {
+        int side = i & 1;
+        unsigned short own = stones[side];
+        unsigned short opponent = stones[side ^ 1];
+        unsigned short move = static_cast<unsigned short>(1 << record.getMove(i));
+        if(over || record.getMove(i) > 8 || ((own | opponent) & move))
+        {
+            analysis.invalidGames++;
+            return;
+        }
+        
+        //Scores are from the mover's point of view before and after the move
+        int before = SolvedTable::lookup(own, opponent).score;
+        int after = -SolvedTable::lookup(opponent, own | move).score;
+        analysis.moves[side]++;
+        
+        int beforeSign = (before > 0) - (before < 0);
+        int afterSign = (after > 0) - (after < 0);
+        if(afterSign < beforeSign)
+        {
+            Blunder blunder;
+            if(findWinningCells(own, opponent))
+                blunder = MISSED_WIN;
+            else if(beforeSign > 0)
+                blunder = LOST_WIN;
+            else if(findWinningCells(opponent, own) & ~move)
+                blunder = MISSED_BLOCK;
+            else
+                blunder = ALLOWED_FORK;
+            analysis.blunders[side][blunder]++;
+        }
+        
+        stones[side] = own | move;
+        for(int line = 0; line < 8; line++)
+            over = over || (stones[side] & GameBoard::LINE_MASKS[line]) == GameBoard::LINE_MASKS[line];
+        over = over || (stones[0] | stones[1]) == GameBoard::FULL_MASK;
+    }
+    
+    //The logged result must match the replay
+    GameRecord::Result result = GameRecord::UNFINISHED;
+    for(int side = 0; side < 2; side++)
+        for(int line = 0; line < 8; line++)
+            if((stones[side] & GameBoard::LINE_MASKS[line]) == GameBoard::LINE_MASKS[line])
+                result = side == 0 ? GameRecord::X_WON : GameRecord::O_WON;
+    if(result == GameRecord::UNFINISHED && (stones[0] | stones[1]) == GameBoard::FULL_MASK)
+        result = GameRecord::DRAW;
+    if(result != record.getResult() && record.getResult() != GameRecord::UNFINISHED)
+        analysis.invalidGames++;
+}
+
+/*
+ *Description: Returns the mask of vacant cells that would complete a line of the first mask
+ *Precondition: The masks do not overlap
+ *Postcondition: A 9-bit mask is returned
+ */
+int LogAnalyzer::findWinningCells(unsigned short own, unsigned short opponent)
+{
+    int cells = 0;
+    for(int line = 0; line < 8; line++)
+    {
+        unsigned short missing = GameBoard::LINE_MASKS[line] & ~own;
+        if(__builtin_popcount(missing) == 1 && !(missing & opponent))
+            cells |= missing;
+    }
+    return cells;
+}
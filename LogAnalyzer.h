@@ -0,0 +1,170 @@
+/************************************************************************************
+ Title:         LogAnalyzer.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   Replays the games of record files(see GameRecord.h) in parallel and
+                compares every move with perfect play from the SolvedTable. A move is a
+                blunder when it lowers the game-theoretic result of the side that made
+                it(a win becomes a draw or a loss, or a draw becomes a loss).
+ 
+ Purpose:       Measures how often an engine misplays, for example by not blocking a
+                fork, over very large game logs. The files are memory-mapped and split
+                at their block boundaries; worker threads claim blocks one at a time and
+                decode them in place, so no file data is copied or parsed as text.
+ 
+ Usage:         LogAnalyzer analyzer;
+                if(!analyzer.addFile(path, error)) ...
+                LogAnalysis analysis = analyzer.run(threads);
+                Blunders are classified as:
+                  MISSED_WIN   - a line could have been completed but was not
+                  LOST_WIN     - another forced win was thrown away
+                  MISSED_BLOCK - the opponent's open two was not blocked
+                  ALLOWED_FORK - any other move that turned a draw into a loss, which
+                                 on the 3x3 board means the opponent can now fork
+                Only 3x3 logs can be analyzed, as perfect play is only known there.
+ 
+ Build with:    make analyze. Linux only(mmap); link with -pthread.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#ifndef TicTacToe_LogAnalyzer_h
+#define TicTacToe_LogAnalyzer_h
+
+#include "GameRecord.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+//Totals of an analysis; sides are indexed 0 for 'X' and 1 for 'O'
+struct LogAnalysis {
+    long games; //Games analyzed
+    long results[4]; //Games by GameRecord::Result
+    long moves[2]; //Moves analyzed per side
+    long blunders[2][4]; //Blunders per side and LogAnalyzer::Blunder
+    long invalidGames; //Games with an illegal move or a wrong result, skipped from that move on
+    long damagedBlocks; //Blocks that failed their checksum or were truncated
+    long bytes; //Bytes of the analyzed files
+    double seconds; //Wall time of the analysis
+    
+    LogAnalysis() : games(0), results(), moves(), blunders(), invalidGames(0), damagedBlocks(0), bytes(0), seconds(0) {}
+    
+    long getBlunders(int side) const { return blunders[side][0] + blunders[side][1] + blunders[side][2] + blunders[side][3]; }
+    
+    void add(const LogAnalysis& other)
+    {
+        games += other.games;
+        invalidGames += other.invalidGames;
+        damagedBlocks += other.damagedBlocks;
+        for(int i = 0; i < 4; i++)
+            results[i] += other.results[i];
+        for(int side = 0; side < 2; side++)
+        {
+            moves[side] += other.moves[side];
+            for(int kind = 0; kind < 4; kind++)
+                blunders[side][kind] += other.blunders[side][kind];
+        }
+    }
+};
+
+class LogAnalyzer {
+
+public:
+    enum Blunder {
+        MISSED_WIN,
+        LOST_WIN,
+        MISSED_BLOCK,
+        ALLOWED_FORK
+    };
+    static const int BLUNDER_KINDS = ALLOWED_FORK + 1; //Number of Blunder values
+    
+    LogAnalyzer();
+    /*
+     *Description: Constructor of an analyzer without files
+     *Precondition: N/A
+     *Postcondition: Files can be added
+     */
+    
+    ~LogAnalyzer();
+    /*
+     *Description: Destructor that unmaps the files
+     *Precondition: run() is not in progress
+     *Postcondition: The files are unmapped
+     */
+    
+    bool addFile(const string&, string&);
+    /*
+     *Description: Maps the record file at the supplied path and splits it into its blocks
+     *Precondition: N/A
+     *Error Checking: The file must be a record file of 3x3 games. A truncated last block is reported
+     *                by run() as damaged.
+     *Postcondition: Returns true on success; otherwise the string holds the reason
+     */
+    
+    static string getBlunderName(Blunder);
+    /*
+     *Description: Returns the name of the supplied Blunder, such as "missed fork block"
+     *Precondition: N/A
+     *Postcondition: A string is returned
+     */
+    
+    LogAnalysis run(int);
+    /*
+     *Description: Analyzes every game of the added files on the supplied number of threads(0 selects one
+     *             per hardware thread)
+     *Precondition: N/A
+     *Postcondition: The totals of every file are returned
+     */
+
+private:
+    struct MappedFile {
+        const unsigned char* data; //Start of the mapping
+        size_t size; //Bytes mapped
+    };
+    
+    struct Chunk {
+        const unsigned char* header; //Block header; the payload follows it
+        size_t available; //Bytes of the file from 'header' on
+    };
+    
+    void analyzeChunks(LogAnalysis&);
+    /*
+     *Description: Worker loop: claims chunks until every one is analyzed
+     *Precondition: N/A
+     *Postcondition: The worker's totals are added to the supplied analysis
+     */
+    
+    void analyzeChunk(const Chunk&, LogAnalysis&) const;
+    /*
+     *Description: Verifies one block and analyzes each of its games
+     *Precondition: N/A
+     *Postcondition: The block's totals are added to the supplied analysis
+     */
+    
+    void analyzeGame(const GameRecord&, LogAnalysis&) const;
+    /*
+     *Description: Replays one game and classifies each of its moves
+     *Precondition: N/A
+     *Postcondition: The game's totals are added to the supplied analysis
+     */
+    
+    static int findWinningCells(unsigned short, unsigned short);
+    /*
+     *Description: Returns the mask of vacant cells that would complete a line of the first mask, given
+     *             the second mask holds the other side's stones
+     *Precondition: The masks do not overlap
+     *Postcondition: A 9-bit mask is returned
+     */
+    
+    int bitsPerCell; //Bits per encoded cell of 3x3 games
+    vector<MappedFile> files; //Every added file
+    vector<Chunk> chunks; //Blocks of every added file
+    atomic<size_t> nextChunk; //Next chunk to claim
+};
+#endif
@@ -0,0 +1,483 @@
+/************************************************************************************
+ Title:         MonteCarloSearch.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of MonteCarloSearch.h. Nodes live in a preallocated
+                array and children form a linked list that only ever grows at its head,
+                so threads can read a node's children without locking. Only adding a
+                child takes the node's spin lock. Statistics are relaxed atomics.
+ 
+ Purpose:       Provides a search whose strength is set by a playout or time budget.
+ 
+ Usage:         search.chooseMove(board, "O", seed);
+ 
+ Build with:    Compile with main.cpp. Link with -pthread.
+ 
+ Modifications: Added chooseMove with a deadline.
+                On layered boards every cell is a neighbor, since the lines run through the layers.
+                A single-threaded search makes no heap allocations once its tree has grown.
+                Added reserve; a timed search looks at the clock before every playout.
+ ***********************************************************************************/
+
+#include "MonteCarloSearch.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+using namespace std;
+
+/*
+ *Description: Constructor that selects DEFAULT_PLAYOUTS playouts, no time limit, one thread and
+ *             the TREE mode
+ *Precondition: N/A
+ *Postcondition: The search is ready to choose moves
+ */
+MonteCarloSearch::MonteCarloSearch()
+    : playouts(DEFAULT_PLAYOUTS), timeLimit(0), threads(1), mode(TREE), lastPlayouts(0),
+      neighborhoodGeometry(0)
+{
+}
+
+/*
+ *Description: Returns the move for the supplied ID('X' or 'O') with the most playouts
+ *Precondition: The game is not over
+ *Postcondition: A vacant Location is returned
+ */
+Location MonteCarloSearch::chooseMove(const GameBoard& board, string ownID, uint64_t seed)
+{
+    return chooseMove(board, ownID, seed, chrono::steady_clock::time_point::max());
+}
+
+/*
+ *Description: Returns the move with the most playouts when the budget, the time limit or the supplied
+ *             deadline runs out
+ *Precondition: The game is not over
+ *Postcondition: A vacant Location is returned shortly after the deadline at the latest
+ */
+Location MonteCarloSearch::chooseMove(const GameBoard& board, string ownID, uint64_t seed,
+                                      chrono::steady_clock::time_point deadline)
+{
+    const BoardGeometry& geometry = board.getGeometry();
+    prepareNeighborhoods(geometry);
+    
+    SearchState state;
+    state.board = &board;
+    int ownSide = GameBoard::getSide(ownID);
+    state.stones[0] = board.getMask(ownSide);
+    state.stones[1] = board.getMask(ownSide ^ 1);
+    
+    CellMask occupied = state.stones[0] | state.stones[1];
+    CellMask empty = geometry.getFullMask().without(occupied);
+    lastPlayouts = 0;
+    
+    //A winning move or a single vacant Location needs no search
+    for(CellMask moves = empty; moves.any(); )
+    {
+        int cell = moves.popLowest();
+        CellMask after = state.stones[0];
+        after.set(cell);
+        if(board.completesLine(after, cell) || empty.count() == 1)
+            return geometry.getLocation(cell);
+    }
+    
+    //Open with the center; afterwards consider the cells near existing stones
+    if(occupied.none())
+    {
+        int centerRow = geometry.getLayerCount() / 2 * geometry.getHeight() + geometry.getHeight() / 2;
+        state.candidates.set(geometry.getCell(centerRow, geometry.getWidth() / 2));
+    }
+    else
+    {
+        for(CellMask stones = occupied; stones.any(); )
+            state.candidates |= neighborhoods[stones.popLowest()];
+        state.candidates = state.candidates.without(occupied);
+    }
+    if(state.candidates.none())
+        state.candidates = empty;
+    
+    state.budget = (playouts == 0 && timeLimit == 0) ? DEFAULT_PLAYOUTS : playouts;
+    state.timed = timeLimit > 0 || deadline != chrono::steady_clock::time_point::max();
+    state.deadline = deadline;
+    if(timeLimit > 0)
+        state.deadline = min(deadline, chrono::steady_clock::now()
+            + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double, milli>(timeLimit)));
+    state.claimed = 0;
+    state.stopped = false;
+    
+    int threadCount = getThreadCount();
+    int treeCount = (mode == TREE) ? 1 : threadCount;
+    prepareTrees(state.budget, treeCount);
+    for(int t = 0; t < treeCount; t++)
+        addNode(*trees[t], -1, -1, state.candidates);
+    
+    vector<thread> workers;
+    for(int t = 1; t < threadCount; t++)
+        workers.push_back(thread(&MonteCarloSearch::search, this, ref(*trees[mode == TREE ? 0 : t]),
+                                 ref(state), Random::derive(seed, t)));
+    search(*trees[0], state, Random::derive(seed, 0));
+    for(size_t t = 0; t < workers.size(); t++)
+        workers[t].join();
+    
+    //Sum the root statistics of every tree and play the most visited move
+    visits.assign(geometry.getCellCount(), 0);
+    for(int t = 0; t < treeCount; t++)
+    {
+        const Node* nodes = trees[t]->nodes.get();
+        lastPlayouts += nodes[0].visits.load();
+        for(int child = nodes[0].firstChild.load(); child >= 0; child = nodes[child].nextSibling)
+            visits[nodes[child].cell] += nodes[child].visits.load();
+    }
+    
+    int bestCell = state.candidates.lowest();
+    for(int cell = 0; cell < geometry.getCellCount(); cell++)
+        if(visits[cell] > visits[bestCell])
+            bestCell = cell;
+    return geometry.getLocation(bestCell);
+}
+
+/*
+ *Description: Worker loop: runs playouts in the supplied tree until the budget is used up
+ *Precondition: The tree's root has been initialized
+ *Postcondition: The tree's statistics include the worker's playouts
+ */
+void MonteCarloSearch::search(Tree& tree, SearchState& state, uint64_t seed)
+{
+    Random random(seed);
+    Node* nodes = tree.nodes.get();
+    const CellMask& full = state.board->getGeometry().getFullMask();
+    int path[CellMask::CAPACITY + 1]; //Nodes from the root down; a game has no more moves than cells
+    int pathLength;
+    
+    for(;;)
+    {
+        long playout = state.claimed.fetch_add(1, memory_order_relaxed);
+        if(state.budget > 0 && playout >= state.budget)
+            break;
+        if(state.timed && chrono::steady_clock::now() >= state.deadline)
+            state.stopped.store(true, memory_order_relaxed);
+        if(state.stopped.load(memory_order_relaxed))
+            break;
+        
+        CellMask stones[2] = { state.stones[0], state.stones[1] };
+        CellMask candidates = state.candidates;
+        int side = 0;
+        int node = 0;
+        int winner = -2;
+        path[0] = 0;
+        pathLength = 1;
+        
+        //Selection and expansion
+        while(winner == -2)
+        {
+            Node& current = nodes[node];
+            if(current.result >= 0)
+            {
+                //The move into this node ended the game; the side that played it is 'side ^ 1'
+                winner = current.result == 1 ? (side ^ 1) : -1;
+                break;
+            }
+            
+            int child = -1;
+            if(!current.expanded.load(memory_order_acquire))
+            {
+                while(current.busy.exchange(true, memory_order_acquire))
+                    this_thread::yield();
+                
+                if(current.untried.any())
+                {
+                    int cell = current.untried.nth(random.nextInt(current.untried.count()));
+                    CellMask after = stones[side];
+                    after.set(cell);
+                    CellMask occupied = after | stones[side ^ 1];
+                    signed char result = -1;
+                    if(state.board->completesLine(after, cell))
+                        result = 1;
+                    else if(occupied == full)
+                        result = 0;
+                    
+                    CellMask childCandidates = (candidates | neighborhoods[cell]).without(occupied);
+                    if(childCandidates.none())
+                        childCandidates = full.without(occupied);
+                    
+                    child = addNode(tree, cell, result, result < 0 ? childCandidates : CellMask());
+                    if(child >= 0)
+                    {
+                        current.untried.clear(cell);
+                        nodes[child].virtualLoss.store(1, memory_order_relaxed);
+                        nodes[child].nextSibling = current.firstChild.load(memory_order_relaxed);
+                        current.firstChild.store(child, memory_order_release);
+                        candidates = childCandidates;
+                    }
+                }
+                if(current.untried.none())
+                    current.expanded.store(true, memory_order_release);
+                current.busy.store(false, memory_order_release);
+                
+                if(child < 0 && !current.expanded.load(memory_order_acquire))
+                {
+                    //The tree is full; finish the game from here
+                    winner = this->playout(state, stones, side, random);
+                    break;
+                }
+                if(child >= 0)
+                {
+                    stones[side].set(nodes[child].cell);
+                    side ^= 1;
+                    node = child;
+                    path[pathLength++] = child;
+                    if(nodes[child].result < 0)
+                        winner = this->playout(state, stones, side, random);
+                    continue;
+                }
+            }
+            
+            //Every candidate has a child: pick the one with the best upper confidence bound,
+            //counting playouts in progress as losses
+            int parentVisits = current.visits.load(memory_order_relaxed) + current.virtualLoss.load(memory_order_relaxed);
+            double logVisits = log(static_cast<double>(parentVisits > 1 ? parentVisits : 1));
+            double bestValue = -1;
+            for(int c = current.firstChild.load(memory_order_acquire); c >= 0; c = nodes[c].nextSibling)
+            {
+                int n = nodes[c].visits.load(memory_order_relaxed) + nodes[c].virtualLoss.load(memory_order_relaxed);
+                double value = 1e9;
+                if(n > 0)
+                    value = nodes[c].score.load(memory_order_relaxed) / (2.0 * n) + EXPLORATION * sqrt(logVisits / n);
+                if(value > bestValue)
+                {
+                    bestValue = value;
+                    child = c;
+                }
+            }
+            if(child < 0)
+            {
+                winner = this->playout(state, stones, side, random);
+                break;
+            }
+            
+            nodes[child].virtualLoss.fetch_add(1, memory_order_relaxed);
+            int cell = nodes[child].cell;
+            stones[side].set(cell);
+            candidates = (candidates | neighborhoods[cell]).without(stones[0] | stones[1]);
+            side ^= 1;
+            node = child;
+            path[pathLength++] = child;
+        }
+        
+        //Backpropagation: the move into the node at depth d was played by side (d - 1) % 2
+        for(int depth = 0; depth < pathLength; depth++)
+        {
+            Node& current = nodes[path[depth]];
+            if(depth > 0)
+            {
+                int mover = static_cast<int>((depth - 1) & 1);
+                current.score.fetch_add(winner == -1 ? 1 : (winner == mover ? 2 : 0), memory_order_relaxed);
+                current.virtualLoss.fetch_sub(1, memory_order_relaxed);
+            }
+            current.visits.fetch_add(1, memory_order_relaxed);
+        }
+    }
+}
+
+/*
+ *Description: Finishes the game with random moves from the supplied stones
+ *Precondition: Neither side has completed a line
+ *Postcondition: Returns the winning side(0 or 1), or -1 for a draw
+ */
+int MonteCarloSearch::playout(const SearchState& state, CellMask* stones, int side, Random& random) const
+{
+    CellMask empty = state.board->getGeometry().getFullMask().without(stones[0] | stones[1]);
+    int cells[CellMask::CAPACITY];
+    int count = 0;
+    while(empty.any())
+        cells[count++] = empty.popLowest();
+    
+    while(count > 0)
+    {
+        int i = random.nextInt(count);
+        int cell = cells[i];
+        cells[i] = cells[--count];
+        
+        stones[side].set(cell);
+        if(state.board->completesLine(stones[side], cell))
+            return side;
+        side ^= 1;
+    }
+    return -1;
+}
+
+/*
+ *Description: Takes a node from the tree's storage and initializes it
+ *Precondition: N/A
+ *Postcondition: Returns the node index, or -1 if the tree is full
+ */
+int MonteCarloSearch::addNode(Tree& tree, int cell, signed char result, const CellMask& untried) const
+{
+    int index = tree.used.fetch_add(1, memory_order_relaxed);
+    if(index >= tree.capacity)
+        return -1;
+    
+    Node& node = tree.nodes[index];
+    node.cell = cell;
+    node.nextSibling = -1;
+    node.firstChild.store(-1, memory_order_relaxed);
+    node.visits.store(0, memory_order_relaxed);
+    node.score.store(0, memory_order_relaxed);
+    node.virtualLoss.store(0, memory_order_relaxed);
+    node.expanded.store(result >= 0 || untried.none(), memory_order_relaxed);
+    node.busy.store(false, memory_order_relaxed);
+    node.result = result;
+    node.untried = untried;
+    return index;
+}
+
+/*
+ *Description: Makes sure the tree can hold the supplied number of nodes and empties it
+ *Precondition: N/A
+ *Postcondition: The tree has no nodes
+ */
+void MonteCarloSearch::prepareTree(Tree& tree, int capacity) const
+{
+    if(tree.capacity < capacity)
+    {
+        tree.nodes.reset(new Node[capacity]);
+        tree.capacity = capacity;
+    }
+    tree.used.store(0);
+}
+
+/*
+ *Description: Makes sure the first supplied number of trees exist and can hold the nodes of a search with the
+ *             supplied playout budget(0 for none), and empties them
+ *Precondition: N/A
+ *Postcondition: The trees have no nodes
+ */
+void MonteCarloSearch::prepareTrees(long budget, int treeCount)
+{
+    int capacity = NODE_LIMIT;
+    if(budget > 0 && budget < NODE_LIMIT)
+        capacity = static_cast<int>(budget) + 1;
+    
+    while(static_cast<int>(trees.size()) < treeCount)
+        trees.push_back(unique_ptr<Tree>(new Tree()));
+    for(int t = 0; t < treeCount; t++)
+        prepareTree(*trees[t], capacity);
+}
+
+/*
+ *Description: Returns the number of threads of a search: the set count, or one per hardware thread
+ *Precondition: N/A
+ *Postcondition: A positive integer is returned
+ */
+int MonteCarloSearch::getThreadCount() const
+{
+    int threadCount = threads > 0 ? threads : static_cast<int>(thread::hardware_concurrency());
+    return threadCount < 1 ? 1 : threadCount;
+}
+
+/*
+ *Description: Computes, for every cell, the mask of cells within two steps of it(every cell on a
+ *             layered board)
+ *Precondition: N/A
+ *Postcondition: 'neighborhoods' matches the supplied geometry
+ */
+void MonteCarloSearch::prepareNeighborhoods(const BoardGeometry& geometry)
+{
+    if(neighborhoodGeometry == &geometry)
+        return;
+    
+    neighborhoods.assign(geometry.getCellCount(), CellMask());
+    for(int cell = 0; cell < geometry.getCellCount(); cell++)
+    {
+        //Nearby rows of the stacked layers are not nearby cells, so no cell is left out
+        if(geometry.getLayerCount() > 1)
+        {
+            neighborhoods[cell] = geometry.getFullMask();
+            continue;
+        }
+        
+        Location loc = geometry.getLocation(cell);
+        for(int dx = -2; dx <= 2; dx++)
+            for(int dy = -2; dy <= 2; dy++)
+                if(geometry.contains(loc.x + dx, loc.y + dy))
+                    neighborhoods[cell].set(geometry.getCell(loc.x + dx, loc.y + dy));
+    }
+    neighborhoodGeometry = &geometry;
+}
+
+/*
+ *Description: Sets the number of playouts per move; 0 removes the limit
+ *Precondition: The number is non-negative
+ *Postcondition: The playout budget is updated
+ */
+void MonteCarloSearch::setPlayouts(long count)
+{
+    playouts = count;
+}
+
+/*
+ *Description: Sets the wall time per move in milliseconds; 0 removes the limit
+ *Precondition: The time is non-negative
+ *Postcondition: The time budget is updated
+ */
+void MonteCarloSearch::setTimeLimit(double milliseconds)
+{
+    timeLimit = milliseconds;
+}
+
+/*
+ *Description: Sets the number of search threads; 0 selects one per hardware thread
+ *Precondition: The number is non-negative
+ *Postcondition: The thread count is updated
+ */
+void MonteCarloSearch::setThreads(int count)
+{
+    threads = count;
+}
+
+/*
+ *Description: Selects how several threads share the work
+ *Precondition: N/A
+ *Postcondition: The mode is updated
+ */
+void MonteCarloSearch::setMode(Mode newMode)
+{
+    mode = newMode;
+}
+
+/*
+ *Description: Allocates the trees of a search with the current budget, thread count and mode ahead of it
+ *Precondition: N/A
+ *Postcondition: The next search allocates no nodes unless one of those settings grows
+ */
+void MonteCarloSearch::reserve()
+{
+    prepareTrees((playouts == 0 && timeLimit == 0) ? DEFAULT_PLAYOUTS : playouts, (mode == TREE) ? 1 : getThreadCount());
+}
+
+/*
+ *Description: Accessor function that returns the number of playouts of the last search
+ *Precondition: N/A
+ *Postcondition: The playout count is returned
+ */
+long MonteCarloSearch::getPlayoutCount() const
+{
+    return lastPlayouts;
+}
+
+/*
+ *Description: Converts "tree" or "root" to a Mode
+ *Precondition: N/A
+ *Postcondition: Returns false and leaves the Mode unchanged if the name is unknown
+ */
+bool MonteCarloSearch::parseMode(string name, Mode& result)
+{
+    if(name == "tree")
+        result = TREE;
+    else if(name == "root")
+        result = ROOT;
+    else
+        return false;
+    return true;
+}
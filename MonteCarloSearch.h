@@ -0,0 +1,235 @@
+/************************************************************************************
+ Title:         MonteCarloSearch.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   A Monte Carlo tree search(UCT) for boards of any size. Each playout walks
+                down the tree choosing children by the UCB1 formula, adds one new node,
+                finishes the game with random moves and credits the result to every node
+                on the path. The move played most often at the root is chosen.
+ 
+ Purpose:       Provides an engine whose strength grows with the CPU it is given, for
+                boards where full search is too expensive and the rank heuristic is too
+                weak. The search can use several threads in one of two ways:
+                TREE  - all threads share one tree; a thread walking through a node adds
+                        a virtual loss to it so the others spread over different lines.
+                ROOT  - every thread grows its own tree from a different random stream and
+                        the root visit counts are summed at the end.
+ 
+ Usage:         MonteCarloSearch search;
+                search.setPlayouts(20000); //and/or search.setTimeLimit(milliseconds)
+                search.setThreads(4); search.setMode(MonteCarloSearch::TREE);
+                Location move = search.chooseMove(board, "O", seed);
+                New nodes are only added next to existing stones(within two cells), which
+                keeps the tree narrow on large boards; playouts use every vacant cell.
+ 
+ Build with:    Compile with main.cpp.
+ 
+ Modifications: Added chooseMove with a deadline.
+                A single-threaded search makes no heap allocations once its tree has grown.
+                The trees can be allocated before a timed search, which looks at the clock
+                before every playout.
+ ***********************************************************************************/
+
+#ifndef TicTacToe_MonteCarloSearch_h
+#define TicTacToe_MonteCarloSearch_h
+
+#include "BoardGeometry.h"
+#include "CellMask.h"
+#include "GameBoard.h"
+#include "Location.h"
+#include "Random.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+using namespace std;
+
+class MonteCarloSearch {
+
+public:
+    enum Mode {
+        TREE, //Threads share one tree and use virtual loss
+        ROOT  //Threads grow separate trees whose root statistics are summed
+    };
+    
+    MonteCarloSearch();
+    /*
+     *Description: Constructor that selects DEFAULT_PLAYOUTS playouts, no time limit, one thread and
+     *             the TREE mode
+     *Precondition: N/A
+     *Postcondition: The search is ready to choose moves
+     */
+    
+    Location chooseMove(const GameBoard&, string, uint64_t);
+    /*
+     *Description: Returns the move for the supplied ID('X' or 'O') with the most playouts. The seed
+     *             selects the random streams; with one thread and no time limit the same seed and
+     *             position always give the same move.
+     *Precondition: The game is not over
+     *Postcondition: A vacant Location is returned
+     */
+    
+    Location chooseMove(const GameBoard&, string, uint64_t, chrono::steady_clock::time_point);
+    /*
+     *Description: Same as above, but the search also stops at the supplied deadline, or at the end of the
+     *             time limit if that comes first
+     *Precondition: The game is not over
+     *Postcondition: A vacant Location is returned shortly after the deadline at the latest
+     */
+    
+    void setPlayouts(long);
+    /*
+     *Description: Sets the number of playouts per move; 0 removes the limit(a time limit must then be set)
+     *Precondition: The number is non-negative
+     *Postcondition: The playout budget is updated
+     */
+    
+    void setTimeLimit(double);
+    /*
+     *Description: Sets the wall time per move in milliseconds; 0 removes the limit
+     *Precondition: The time is non-negative
+     *Postcondition: The time budget is updated
+     */
+    
+    void setThreads(int);
+    /*
+     *Description: Sets the number of search threads; 0 selects one per hardware thread
+     *Precondition: The number is non-negative
+     *Postcondition: The thread count is updated
+     */
+    
+    void setMode(Mode);
+    /*
+     *Description: Selects how several threads share the work
+     *Precondition: N/A
+     *Postcondition: The mode is updated
+     */
+    
+    void reserve();
+    /*
+     *Description: Allocates the trees of a search with the current budget, thread count and mode ahead of
+     *             it, so that a search with a deadline does not spend its time on them
+     *Precondition: N/A
+     *Postcondition: The next search allocates no nodes unless one of those settings grows
+     */
+    
+    long getPlayoutCount() const;
+    /*
+     *Description: Accessor function that returns the number of playouts of the last search
+     *Precondition: N/A
+     *Postcondition: The playout count is returned
+     */
+    
+    static bool parseMode(string, Mode&);
+    /*
+     *Description: Converts "tree" or "root" to a Mode
+     *Precondition: N/A
+     *Postcondition: Returns false and leaves the Mode unchanged if the name is unknown
+     */
+    
+    static const long DEFAULT_PLAYOUTS = 20000; //Playouts per move when no budget is set
+    static const int NODE_LIMIT = 1 << 18; //Largest tree; once full, playouts start from the deepest node reached
+    static constexpr double EXPLORATION = 1.0; //Weight of the exploration term of UCB1
+
+private:
+    struct Node {
+        int cell; //Move that leads to this node, or -1 at the root
+        int nextSibling; //Next child of the same parent, or -1
+        atomic<int> firstChild; //Most recently added child, or -1
+        atomic<int> visits; //Completed playouts through this node
+        atomic<int> score; //Half-points of those playouts for the side that played 'cell': 2 win, 1 draw
+        atomic<int> virtualLoss; //Playouts currently in progress below this node
+        atomic<bool> expanded; //Set once every candidate move has a child
+        atomic<bool> busy; //Spin lock guarding 'untried'
+        signed char result; //1 if 'cell' completed a line, 0 if it filled the board, otherwise -1
+        CellMask untried; //Candidate moves that do not have a child yet
+    };
+    
+    struct Tree {
+        unique_ptr<Node[]> nodes; //Node storage, reused between searches
+        int capacity; //Number of nodes allocated
+        atomic<int> used; //Number of nodes handed out
+        
+        Tree() : capacity(0), used(0) {}
+    };
+    
+    //Everything one search needs to know about the root position
+    struct SearchState {
+        const GameBoard* board; //Root position, also used for its completesLine
+        CellMask stones[2]; //Stones of the side to move(0) and of its opponent(1)
+        CellMask candidates; //Candidate moves at the root
+        long budget; //Playouts to run, or 0 for no limit
+        bool timed; //Whether 'deadline' applies
+        chrono::steady_clock::time_point deadline; //End of the time budget
+        atomic<long> claimed; //Playouts started by all threads
+        atomic<bool> stopped; //Set once the time budget has run out
+    };
+    
+    void search(Tree&, SearchState&, uint64_t);
+    /*
+     *Description: Worker loop: runs playouts in the supplied tree until the budget is used up
+     *Precondition: The tree's root has been initialized
+     *Postcondition: The tree's statistics include the worker's playouts
+     */
+    
+    int playout(const SearchState&, CellMask*, int, Random&) const;
+    /*
+     *Description: Finishes the game with random moves from the supplied stones, with the supplied
+     *             side(0 or 1) to move
+     *Precondition: Neither side has completed a line
+     *Postcondition: Returns the winning side(0 or 1), or -1 for a draw
+     */
+    
+    int addNode(Tree&, int, signed char, const CellMask&) const;
+    /*
+     *Description: Takes a node from the tree's storage and initializes it with the supplied move,
+     *             result and candidate moves
+     *Precondition: N/A
+     *Postcondition: Returns the node index, or -1 if the tree is full
+     */
+    
+    void prepareTree(Tree&, int) const;
+    /*
+     *Description: Makes sure the tree can hold the supplied number of nodes and empties it
+     *Precondition: N/A
+     *Postcondition: The tree has no nodes
+     */
+    
+    void prepareTrees(long, int);
+    /*
+     *Description: Makes sure the first supplied number of trees exist and can hold the nodes of a search with
+     *             the supplied playout budget(0 for none), and empties them
+     *Precondition: N/A
+     *Postcondition: The trees have no nodes
+     */
+    
+    int getThreadCount() const;
+    /*
+     *Description: Returns the number of threads of a search: the set count, or one per hardware thread
+     *Precondition: N/A
+     *Postcondition: A positive integer is returned
+     */
+    
+    void prepareNeighborhoods(const BoardGeometry&);
+    /*
+     *Description: Computes, for every cell, the mask of cells within two steps of it
+     *Precondition: N/A
+     *Postcondition: 'neighborhoods' matches the supplied geometry
+     */
+    
+    long playouts; //Playouts per move, or 0 for no limit
+    double timeLimit; //Milliseconds per move, or 0 for no limit
+    int threads; //Search threads, or 0 for one per hardware thread
+    Mode mode; //How several threads share the work
+    long lastPlayouts; //Playouts run by the last search
+    const BoardGeometry* neighborhoodGeometry; //Geometry 'neighborhoods' was computed for
+    vector<CellMask> neighborhoods; //Cells within two steps of each cell
+    vector<long> visits; //Scratch visits of each root move, summed over the trees
+    vector<unique_ptr<Tree> > trees; //One tree in TREE mode, one per thread in ROOT mode
+};
+#endif
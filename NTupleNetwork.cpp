@@ -0,0 +1,227 @@
+/************************************************************************************
+ Title:         NTupleNetwork.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of NTupleNetwork.h. The whole weight file is read with
+                one call; its weights are converted from little-endian as they are copied.
+ 
+ Purpose:       Stores, loads and evaluates the learned line tables.
+ 
+ Usage:         network.open(path, error); network.evaluate(board);
+ 
+ Build with:    Compile with main.cpp.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#include "NTupleNetwork.h"
+#include "GameRecord.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+using namespace std;
+
+const char NTupleNetwork::MAGIC[4] = { 'T', 'T', 'T', 'N' };
+
+/*
+ *Description: Constructor of an empty network that belongs to no board
+ *Precondition: N/A
+ *Postcondition: getGeometry() returns 0
+ */
+NTupleNetwork::NTupleNetwork() : geometry(0), tableSize(0)
+{
+}
+
+/*
+ *Description: Gives the network one table per winning line of the supplied board, every weight 0
+ *Precondition: N/A
+ *Error Checking: Throws invalid_argument if the win length is longer than MAX_TUPLE_LENGTH
+ *Postcondition: The network evaluates every position of the board as 0
+ */
+void NTupleNetwork::reset(const BoardGeometry& boardGeometry)
+{
+    if(boardGeometry.getWinLength() > MAX_TUPLE_LENGTH)
+        throw invalid_argument("n-tuple networks are limited to lines of " + to_string(MAX_TUPLE_LENGTH) + " cells");
+    
+    tableSize = 1;
+    for(int i = 0; i < boardGeometry.getWinLength(); i++)
+        tableSize *= 3;
+    weights.assign(static_cast<size_t>(boardGeometry.getLineCount()) * tableSize, 0);
+    geometry = &boardGeometry;
+}
+
+/*
+ *Description: Reads the network file at the supplied path
+ *Precondition: No search uses the network yet
+ *Error Checking: The file must have a valid header of a supported version and board size, and
+ *                exactly the number of weights its lines need.
+ *Postcondition: Returns true on success; otherwise the string holds the reason and the network is unchanged
+ */
+bool NTupleNetwork::open(const string& path, string& error)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if(!file)
+    {
+        error = strerror(errno);
+        return false;
+    }
+    
+    unsigned char header[HEADER_SIZE];
+    NTupleNetwork loaded;
+    vector<unsigned char> bytes;
+    bool valid = false;
+    if(fread(header, 1, sizeof(header), file) != sizeof(header) || memcmp(header, MAGIC, sizeof(MAGIC)) != 0)
+        error = "not an n-tuple network";
+    else if((header[4] | (header[5] << 8)) != FORMAT_VERSION)
+        error = "unsupported network format version";
+    else
+    {
+        try
+        {
+            loaded.reset(BoardGeometry::get(header[6], header[7], header[8], max(1, static_cast<int>(header[9]))));
+            if(GameRecord::getWord(header + 10) != static_cast<uint32_t>(loaded.geometry->getLineCount()))
+                error = "line count does not match the board";
+            else
+            {
+                //One extra byte must not be there
+                bytes.resize(loaded.weights.size() * 2 + 1);
+                valid = fread(bytes.data(), 1, bytes.size(), file) == bytes.size() - 1;
+                if(!valid)
+                    error = "network size does not match its board";
+            }
+        }
+        catch(const invalid_argument&)
+        {
+            error = "unsupported board size";
+        }
+    }
+    fclose(file);
+    if(!valid)
+        return false;
+    
+    for(size_t i = 0; i < loaded.weights.size(); i++)
+        loaded.weights[i] = static_cast<short>(bytes[2 * i] | (bytes[2 * i + 1] << 8));
+    *this = loaded;
+    return true;
+}
+
+/*
+ *Description: Writes the network to the file at the supplied path
+ *Precondition: The network belongs to a board
+ *Postcondition: Returns true on success; otherwise the string holds the reason
+ */
+bool NTupleNetwork::save(const string& path, string& error) const
+{
+    vector<unsigned char> bytes(HEADER_SIZE + weights.size() * 2, 0);
+    memcpy(&bytes[0], MAGIC, sizeof(MAGIC));
+    bytes[4] = static_cast<unsigned char>(FORMAT_VERSION & 0xFF);
+    bytes[5] = static_cast<unsigned char>(FORMAT_VERSION >> 8);
+    bytes[6] = static_cast<unsigned char>(geometry->getWidth());
+    bytes[7] = static_cast<unsigned char>(geometry->getHeight());
+    bytes[8] = static_cast<unsigned char>(geometry->getWinLength());
+    bytes[9] = static_cast<unsigned char>(geometry->getLayerCount() > 1 ? geometry->getLayerCount() : 0);
+    GameRecord::putWord(&bytes[10], static_cast<uint32_t>(geometry->getLineCount()));
+    for(size_t i = 0; i < weights.size(); i++)
+    {
+        unsigned short weight = static_cast<unsigned short>(weights[i]);
+        bytes[HEADER_SIZE + 2 * i] = static_cast<unsigned char>(weight & 0xFF);
+        bytes[HEADER_SIZE + 2 * i + 1] = static_cast<unsigned char>(weight >> 8);
+    }
+    
+    FILE* file = fopen(path.c_str(), "wb");
+    if(!file)
+    {
+        error = strerror(errno);
+        return false;
+    }
+    bool written = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    if(fclose(file) != 0 || !written)
+    {
+        error = "write failed";
+        return false;
+    }
+    return true;
+}
+
+/*
+ *Description: Returns the sum of the weights selected by every line of the supplied board, for the side that
+ *             moved last
+ *Precondition: The board is of the network's size
+ *Postcondition: The evaluation is returned
+ */
+int NTupleNetwork::evaluate(const GameBoard& board) const
+{
+    const CellMask& x = board.getMask(0);
+    const CellMask& o = board.getMask(1);
+    bool xMovedLast = x.count() > o.count();
+    const CellMask& moved = xMovedLast ? x : o;
+    const CellMask& toMove = xMovedLast ? o : x;
+    int winLength = geometry->getWinLength();
+    
+    int sum = 0;
+    for(int line = 0; line < geometry->getLineCount(); line++)
+    {
+        const int* cells = geometry->getLineCells(line);
+        int entry = 0;
+        for(int i = winLength - 1; i >= 0; i--)
+            entry = entry * 3 + (moved.test(cells[i]) ? 1 : toMove.test(cells[i]) ? 2 : 0);
+        sum += weights[static_cast<size_t>(line) * tableSize + entry];
+    }
+    return sum;
+}
+
+/*
+ *Description: Returns true if the network belongs to a board of the supplied size
+ *Precondition: N/A
+ *Postcondition: A boolean value is returned
+ */
+bool NTupleNetwork::matches(const BoardGeometry& other) const
+{
+    return geometry && geometry->getWidth() == other.getWidth() && geometry->getHeight() == other.getHeight()
+           && geometry->getWinLength() == other.getWinLength() && geometry->getLayerCount() == other.getLayerCount();
+}
+
+/*
+ *Description: Accessor function that returns the board of the network, or 0
+ *Precondition: N/A
+ *Postcondition: A pointer is returned
+ */
+const BoardGeometry* NTupleNetwork::getGeometry() const
+{
+    return geometry;
+}
+
+/*
+ *Description: Accessor function that returns the number of weights of each line
+ *Precondition: N/A
+ *Postcondition: 3 to the power of the win length is returned, or 0 for an empty network
+ */
+int NTupleNetwork::getTableSize() const
+{
+    return tableSize;
+}
+
+/*
+ *Description: Accessor function that returns the weights, table after table
+ *Precondition: N/A
+ *Postcondition: A pointer to the first weight is returned
+ */
+const short* NTupleNetwork::getWeights() const
+{
+    return weights.data();
+}
+
+/*
+ *Description: Sets the weight of the supplied entry of the supplied line, clamped to a signed 16-bit value
+ *Precondition: 0 <= line < line count, 0 <= entry < getTableSize(); no search uses the network
+ *Postcondition: The weight is updated
+ */
+void NTupleNetwork::setWeight(int line, int entry, int value)
+{
+    weights[static_cast<size_t>(line) * tableSize + entry] = static_cast<short>(max(-32768, min(value, 32767)));
+}
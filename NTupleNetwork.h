@@ -0,0 +1,134 @@
+/************************************************************************************
+ Title:         NTupleNetwork.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   A learned evaluation function: an n-tuple network whose tuples are the
+                winning lines of a board. Each line has a table with one weight for
+                every way its k cells can be filled(3 to the k entries), and a position
+                is worth the sum of the weights its lines select, to the side that moved
+                last. The entry of a line is the base-3 number with one digit per cell,
+                in the order of BoardGeometry::getLineCells: 0 for vacant, 1 for a stone
+                of the side that moved last and 2 for one of the side to move. Valuing
+                every position for the side that just moved, with the other to move,
+                lets the same weights serve both sides. A move changes one digit of
+                each line through its cell, so a search can keep the sum up to date with
+                two table loads per line and side.
+                The weights are trained by NTupleTrainer and stored in SCALE units per
+                game result(a sure win is worth about +SCALE).
+                A network file is:
+                  header   16 bytes: "TTTN", format version(2 bytes), width, height,
+                           win length, layers(0 for a flat board), line count(4 bytes),
+                           2 reserved bytes
+                  weights  2 bytes each(signed): the table of line 0, then of line 1, ...
+                All numbers are little-endian.
+ 
+ Purpose:       Gives the shallow searches of large boards an evaluation learned from
+                play instead of the fixed line weights, at the same cost. Against the
+                line weights a trained network wins at depths 1 and 2 on the cube and at
+                depth 1 on 15x15, but loses from depth 3 on(118 wins to 275 at the
+                default depth 4 on the cube), so AlphaBetaSearch only uses it up to
+                AlphaBetaSearch::NETWORK_MAX_DEPTH.
+ 
+ Usage:         NTupleNetwork network;
+                if(!network.open(path, error)) ...
+                computer.setNetwork(&network); //shallow ALPHA_BETA searches of its board use it
+                network.evaluate(board);
+                Networks are written by the train program(see train.cpp). One network
+                can be shared by every Computer of a process.
+ 
+ Build with:    Compile with main.cpp.
+ 
+ Modifications: Documented the depths at which a network helps the search.
+ ***********************************************************************************/
+
+#ifndef TicTacToe_NTupleNetwork_h
+#define TicTacToe_NTupleNetwork_h
+
+#include "BoardGeometry.h"
+#include "GameBoard.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+using namespace std;
+
+class NTupleNetwork {
+
+public:
+    NTupleNetwork();
+    /*
+     *Description: Constructor of an empty network that belongs to no board
+     *Precondition: N/A
+     *Postcondition: getGeometry() returns 0
+     */
+    
+    void reset(const BoardGeometry&);
+    /*
+     *Description: Gives the network one table per winning line of the supplied board, every weight 0
+     *Precondition: N/A
+     *Error Checking: Throws invalid_argument if the win length is longer than MAX_TUPLE_LENGTH
+     *Postcondition: The network evaluates every position of the board as 0
+     */
+    
+    bool open(const string&, string&);
+    /*
+     *Description: Reads the network file at the supplied path
+     *Precondition: No search uses the network yet
+     *Error Checking: The file must have a valid header of a supported version and board size, and
+     *                exactly the number of weights its lines need.
+     *Postcondition: Returns true on success; otherwise the string holds the reason and the network is unchanged
+     */
+    
+    bool save(const string&, string&) const;
+    /*
+     *Description: Writes the network to the file at the supplied path
+     *Precondition: The network belongs to a board
+     *Postcondition: Returns true on success; otherwise the string holds the reason
+     */
+    
+    int evaluate(const GameBoard&) const;
+    /*
+     *Description: Returns the sum of the weights selected by every line of the supplied board, for the side
+     *             that moved last('X' if it has more stones, else 'O')
+     *Precondition: The board is of the network's size
+     *Postcondition: The evaluation is returned
+     */
+    
+    bool matches(const BoardGeometry&) const;
+    /*
+     *Description: Returns true if the network belongs to a board of the supplied size
+     *Precondition: N/A
+     *Postcondition: A boolean value is returned
+     */
+    
+    const BoardGeometry* getGeometry() const;
+    int getTableSize() const;
+    const short* getWeights() const;
+    /*
+     *Description: Accessor functions for the board of the network(0 if none), the number of weights of
+     *             each line, and the weights, table after table
+     *Precondition: N/A
+     *Postcondition: The requested value is returned
+     */
+    
+    void setWeight(int, int, int);
+    /*
+     *Description: Sets the weight of the supplied entry of the supplied line, clamped to a signed 16-bit value
+     *Precondition: 0 <= line < line count, 0 <= entry < getTableSize(); no search uses the network
+     *Postcondition: The weight is updated
+     */
+    
+    static const int MAX_TUPLE_LENGTH = 8; //Longest line with a table(3^8 = 6561 weights)
+    static const int SCALE = 1024; //Weight units per game result
+    static const char MAGIC[4]; //First bytes of a network file
+    static const int FORMAT_VERSION = 1; //Version of the network file format
+    static const size_t HEADER_SIZE = 16; //Bytes before the first weight
+
+private:
+    const BoardGeometry* geometry; //Board of the network, or 0
+    int tableSize; //Weights per line: 3 to the power of the win length
+    vector<short> weights; //The tables of every line, one after another
+};
+#endif
@@ -0,0 +1,261 @@
+/************************************************************************************
+ Title:         NTupleTrainer.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of NTupleTrainer.h. The entry of every line is kept up
+                to date as stones are placed, so a move is chosen and learned from by
+                reading only the tables of the lines through each vacant cell.
+ 
+ Purpose:       Trains n-tuple networks by TD(0) self-play.
+ 
+ Usage:         NTupleTrainer trainer(geometry); trainer.train(games);
+ 
+ Build with:    Compile with train.cpp.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#include "NTupleTrainer.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+using namespace std;
+
+/*
+ *Description: Constructor of a trainer for the supplied board, with every weight 0
+ *Precondition: The BoardGeometry outlives the trainer
+ *Error Checking: Throws invalid_argument if the win length is longer than NTupleNetwork::MAX_TUPLE_LENGTH
+ *Postcondition: The trainer has played no games
+ */
+NTupleTrainer::NTupleTrainer(const BoardGeometry& boardGeometry)
+    : geometry(boardGeometry), lineCount(boardGeometry.getLineCount()), learningRate(DEFAULT_LEARNING_RATE),
+      exploration(DEFAULT_EXPLORATION), gameCount(0)
+{
+    //The network checks the win length
+    NTupleNetwork network;
+    network.reset(geometry);
+    tableSize = network.getTableSize();
+    weights.assign(static_cast<size_t>(lineCount) * tableSize, 0.0f);
+    winEntry = (tableSize - 1) / 2;
+    results[0] = results[1] = results[2] = 0;
+    
+    //The power of a cell on a line is its digit's place in the line's entry
+    int winLength = geometry.getWinLength();
+    cellLineStart.assign(1, 0);
+    for(int cell = 0; cell < geometry.getCellCount(); cell++)
+    {
+        int count;
+        const int* lines = geometry.getCellLines(cell, count);
+        for(int i = 0; i < count; i++)
+        {
+            const int* cells = geometry.getLineCells(lines[i]);
+            int power = 1;
+            for(int position = 0; position < winLength && cells[position] != cell; position++)
+                power *= 3;
+            cellLines.push_back(lines[i]);
+            cellLinePowers.push_back(power);
+        }
+        cellLineStart.push_back(static_cast<int>(cellLines.size()));
+    }
+    entries[0].assign(lineCount, 0);
+    entries[1].assign(lineCount, 0);
+    previous.assign(lineCount, 0);
+    vacant.reserve(geometry.getCellCount());
+    ties.reserve(geometry.getCellCount());
+}
+
+/*
+ *Description: Mutator functions for the step size, the probability of a random move and the seed
+ *Precondition: The rate is positive and the probability between 0 and 1
+ *Postcondition: The setting is updated
+ */
+void NTupleTrainer::setLearningRate(double rate)
+{
+    learningRate = rate;
+}
+
+void NTupleTrainer::setExploration(double probability)
+{
+    exploration = probability;
+}
+
+void NTupleTrainer::setSeed(uint64_t seed)
+{
+    random.setSeed(seed);
+}
+
+/*
+ *Description: Starts from the weights of the supplied network
+ *Precondition: The network belongs to a board of the trainer's size
+ *Postcondition: Every weight is the network's divided by NTupleNetwork::SCALE
+ */
+void NTupleTrainer::readNetwork(const NTupleNetwork& network)
+{
+    const short* networkWeights = network.getWeights();
+    for(size_t i = 0; i < weights.size(); i++)
+        weights[i] = static_cast<float>(networkWeights[i]) / NTupleNetwork::SCALE;
+}
+
+/*
+ *Description: Gives the supplied network the trainer's board and rounded weights
+ *Precondition: N/A
+ *Postcondition: The network evaluates positions as the trainer does, up to rounding
+ */
+void NTupleTrainer::writeNetwork(NTupleNetwork& network) const
+{
+    network.reset(geometry);
+    for(int line = 0; line < lineCount; line++)
+        for(int entry = 0; entry < tableSize; entry++)
+            network.setWeight(line, entry,
+                              static_cast<int>(lround(weights[static_cast<size_t>(line) * tableSize + entry]
+                                                      * NTupleNetwork::SCALE)));
+}
+
+/*
+ *Description: Plays the supplied number of games against itself, learning after every move
+ *Precondition: N/A
+ *Postcondition: The weights and the result counts are updated
+ */
+void NTupleTrainer::train(long games)
+{
+    for(long game = 0; game < games; game++)
+    {
+        results[playGame() + 1]++;
+        gameCount++;
+    }
+}
+
+/*
+ *Description: Accessor functions for the games played and their results
+ *Precondition: N/A
+ *Postcondition: A non-negative count is returned
+ */
+long NTupleTrainer::getGameCount() const
+{
+    return gameCount;
+}
+
+long NTupleTrainer::getXWins() const
+{
+    return results[2];
+}
+
+long NTupleTrainer::getOWins() const
+{
+    return results[0];
+}
+
+long NTupleTrainer::getDraws() const
+{
+    return results[1];
+}
+
+/*
+ *Description: Plays one game from the empty board, updating the weights after every move
+ *Precondition: N/A
+ *Postcondition: Returns 1 for a win of 'X', -1 for a win of 'O' and 0 for a draw
+ */
+int NTupleTrainer::playGame()
+{
+    fill(entries[0].begin(), entries[0].end(), 0);
+    fill(entries[1].begin(), entries[1].end(), 0);
+    vacant.clear();
+    for(int cell = 0; cell < geometry.getCellCount(); cell++)
+        vacant.push_back(cell);
+    
+    bool hasPrevious = false;
+    for(int mover = 0; ; mover ^= 1)
+    {
+        int cell = chooseMove(mover);
+        *find(vacant.begin(), vacant.end(), cell) = vacant.back();
+        vacant.pop_back();
+        
+        //The stone is digit 1 for the mover and 2 for the other side
+        bool won = false;
+        for(int i = cellLineStart[cell]; i < cellLineStart[cell + 1]; i++)
+        {
+            int& entry = entries[mover][cellLines[i]];
+            entry += cellLinePowers[i];
+            entries[mover ^ 1][cellLines[i]] += 2 * cellLinePowers[i];
+            if(entry == winEntry)
+                won = true;
+        }
+        bool over = won || vacant.empty();
+        
+        //The other side's afterstate before this move learns from the one after it
+        if(hasPrevious)
+        {
+            double target = won ? -1 : over ? 0 : -getValue(entries[mover]);
+            float step = static_cast<float>(learningRate * (target - getValue(previous)) / lineCount);
+            for(int line = 0; line < lineCount; line++)
+                weights[static_cast<size_t>(line) * tableSize + previous[line]] += step;
+        }
+        if(over)
+            return won ? (mover ? -1 : 1) : 0;
+        previous = entries[mover];
+        hasPrevious = true;
+    }
+}
+
+/*
+ *Description: Returns the vacant cell the supplied side plays
+ *Precondition: The board has a vacant cell
+ *Postcondition: A vacant cell is returned
+ */
+int NTupleTrainer::chooseMove(int mover)
+{
+    //Every afterstate shares the mover's current value, so only the change made by the move is compared.
+    //As in the searches, a win is taken and an opponent's win is blocked whatever the values say.
+    const vector<int>& moverEntries = entries[mover];
+    const vector<int>& otherEntries = entries[mover ^ 1];
+    float best = 0;
+    ties.clear();
+    for(size_t v = 0; v < vacant.size(); v++)
+    {
+        int cell = vacant[v];
+        float gain = 0;
+        bool wins = false;
+        bool blocks = false;
+        for(int i = cellLineStart[cell]; i < cellLineStart[cell + 1]; i++)
+        {
+            const float* table = &weights[static_cast<size_t>(cellLines[i]) * tableSize];
+            int before = moverEntries[cellLines[i]];
+            int after = before + cellLinePowers[i];
+            if(after == winEntry)
+                wins = true;
+            if(otherEntries[cellLines[i]] + cellLinePowers[i] == winEntry)
+                blocks = true;
+            gain += table[after] - table[before];
+        }
+        float value = wins ? HUGE_VALF : blocks ? FLT_MAX : gain;
+        if(v == 0 || value > best)
+        {
+            best = value;
+            ties.clear();
+            ties.push_back(cell);
+        }
+        else if(value == best)
+            ties.push_back(cell);
+    }
+    
+    //53 random bits give a uniform number between 0 and 1
+    if(best < FLT_MAX && (random.next() >> 11) * (1.0 / 9007199254740992.0) < exploration)
+        return vacant[random.nextInt(static_cast<int>(vacant.size()))];
+    return ties[random.nextInt(static_cast<int>(ties.size()))];
+}
+
+/*
+ *Description: Returns the value of the position whose lines select the supplied entries
+ *Precondition: The vector has an entry for every line
+ *Postcondition: The sum of the selected weights is returned
+ */
+double NTupleTrainer::getValue(const vector<int>& lineEntries) const
+{
+    double value = 0;
+    for(int line = 0; line < lineCount; line++)
+        value += weights[static_cast<size_t>(line) * tableSize + lineEntries[line]];
+    return value;
+}
@@ -0,0 +1,146 @@
+/************************************************************************************
+ Title:         NTupleTrainer.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   Trains the weights of an NTupleNetwork by temporal-difference learning
+                from self-play. Both sides play with the same network: as in the
+                searches, a win is taken and an opponent's win blocked; any other move is,
+                with probability 'exploration', a random vacant cell, else the one whose
+                resulting position(the afterstate) the network values most for the side
+                making it. An afterstate is valued for the side that made it(see
+                NTupleNetwork.h), so after every move the value of the afterstate before
+                it, made by the other side, is moved toward the negated value of the new
+                one(TD(0)), or toward the result of the game for that side once it is
+                over: -1 as the new move won and 0 for a draw. An update of size delta
+                adds learningRate * delta / lines to the weight each line selected in
+                that afterstate, so the afterstate's value moves by learningRate * delta. The weights are kept as floats in game
+                results and are only rounded to NTupleNetwork::SCALE units when written.
+ 
+ Purpose:       Learns an evaluation for boards too large to solve, from nothing but the
+                rules, offline and in seconds to minutes.
+ 
+ Usage:         NTupleTrainer trainer(BoardGeometry::get(15, 15, 5));
+                trainer.setLearningRate(0.1); trainer.setExploration(0.1); trainer.setSeed(seed);
+                trainer.readNetwork(network); //optional: continue from a trained network
+                trainer.train(games);
+                trainer.writeNetwork(network); network.save(path, error);
+ 
+ Build with:    Compile with train.cpp.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#ifndef TicTacToe_NTupleTrainer_h
+#define TicTacToe_NTupleTrainer_h
+
+#include "BoardGeometry.h"
+#include "NTupleNetwork.h"
+#include "Random.h"
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+class NTupleTrainer {
+
+public:
+    NTupleTrainer(const BoardGeometry&);
+    /*
+     *Description: Constructor of a trainer for the supplied board, with every weight 0
+     *Precondition: The BoardGeometry outlives the trainer
+     *Error Checking: Throws invalid_argument if the win length is longer than NTupleNetwork::MAX_TUPLE_LENGTH
+     *Postcondition: The trainer has played no games
+     */
+    
+    void setLearningRate(double);
+    void setExploration(double);
+    void setSeed(uint64_t);
+    /*
+     *Description: Mutator functions for the step size of the updates(DEFAULT_LEARNING_RATE unless set),
+     *             the probability of a random move(DEFAULT_EXPLORATION unless set) and the seed of the
+     *             random moves and tie breaks
+     *Precondition: The rate is positive and the probability between 0 and 1
+     *Postcondition: The setting is updated
+     */
+    
+    void readNetwork(const NTupleNetwork&);
+    /*
+     *Description: Starts from the weights of the supplied network
+     *Precondition: The network belongs to a board of the trainer's size
+     *Postcondition: Every weight is the network's divided by NTupleNetwork::SCALE
+     */
+    
+    void writeNetwork(NTupleNetwork&) const;
+    /*
+     *Description: Gives the supplied network the trainer's board and weights, rounded to NTupleNetwork::SCALE
+     *             units per game result
+     *Precondition: N/A
+     *Postcondition: The network evaluates positions as the trainer does, up to rounding
+     */
+    
+    void train(long);
+    /*
+     *Description: Plays the supplied number of games against itself, learning after every move
+     *Precondition: N/A
+     *Postcondition: The weights and the result counts are updated
+     */
+    
+    long getGameCount() const;
+    long getXWins() const;
+    long getOWins() const;
+    long getDraws() const;
+    /*
+     *Description: Accessor functions for the games played by every call of train, and how many of them
+     *             'X' won, 'O' won or were drawn
+     *Precondition: N/A
+     *Postcondition: A non-negative count is returned
+     */
+    
+    static constexpr double DEFAULT_LEARNING_RATE = 0.1; //Share of each error corrected by one update
+    static constexpr double DEFAULT_EXPLORATION = 0.1; //Probability of a random move
+
+private:
+    int playGame();
+    /*
+     *Description: Plays one game from the empty board, updating the weights after every move
+     *Precondition: N/A
+     *Postcondition: Returns 1 for a win of 'X', -1 for a win of 'O' and 0 for a draw
+     */
+    
+    int chooseMove(int);
+    /*
+     *Description: Returns the vacant cell the supplied side(0 for 'X') plays: a win, else a block of the
+     *             opponent's win, else a random cell with probability 'exploration', else the cell whose
+     *             afterstate it values most, ties broken at random
+     *Precondition: The board has a vacant cell
+     *Postcondition: A vacant cell is returned
+     */
+    
+    double getValue(const vector<int>&) const;
+    /*
+     *Description: Returns the value of the position whose lines select the supplied entries
+     *Precondition: The vector has an entry for every line
+     *Postcondition: The sum of the selected weights is returned
+     */
+    
+    const BoardGeometry& geometry; //Board the weights are for
+    int lineCount; //Winning lines of the board
+    int tableSize; //Weights per line: 3 to the power of the win length
+    int winEntry; //Entry of a line filled by the side that moved last
+    vector<float> weights; //The tables of every line, one after another, in game results
+    vector<int> cellLineStart; //Offset of each cell's first entry in 'cellLines'; one extra entry at the end
+    vector<int> cellLines; //Lines through each cell, cell after cell
+    vector<int> cellLinePowers; //3 to the power of the cell's position on each line of 'cellLines'
+    vector<int> entries[2]; //Entry of each line in the current position for 'X' and 'O' as the side that moved last
+    vector<int> previous; //Entries of the afterstate before the last move, for the side that made it
+    vector<int> vacant; //Vacant cells of the current position
+    vector<int> ties; //Best cells found by chooseMove
+    double learningRate; //Share of each error corrected by one update
+    double exploration; //Probability of a random move
+    Random random; //Random moves and tie breaks
+    long gameCount; //Games played
+    long results[3]; //Wins of 'O', draws and wins of 'X'
+};
+#endif
@@ -0,0 +1,214 @@
+/************************************************************************************
+ Title:         NegamaxSearch.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of NegamaxSearch.h. A full-depth negamax search of
+                the 3x3 game with alpha-beta pruning.
+ 
+ Purpose:       Provides a reference-strength opponent that can not be beaten.
+ 
+ Usage:         NegamaxSearch search; search.chooseMove(ownMask, opponentMask);
+ 
+ Build with:    Compile with main.cpp.
+ 
+ Modifications: Added a transposition table keyed by the canonical Zobrist hash.
+ ***********************************************************************************/
+
+#include "NegamaxSearch.h"
+#include "GameBoard.h"
+using namespace std;
+
+//Center first, then corners, then edges
+const int NegamaxSearch::MOVE_ORDER[9] = { 4, 0, 2, 6, 8, 1, 3, 5, 7 };
+
+/*
+ *Description: Constructor that initializes the node counter and an empty transposition table
+ *Precondition: N/A
+ *Postcondition: getNodeCount() returns 0
+ */
+NegamaxSearch::NegamaxSearch() : nodeCount(0), table(TABLE_BITS)
+{
+    const BoardGeometry& geometry = BoardGeometry::classic();
+    for(int symmetry = 0; symmetry < Zobrist::MAX_SYMMETRIES; symmetry++)
+        symmetries[symmetry] = geometry.getSymmetry(symmetry);
+}
+
+/*
+ *Description: Returns the best move for the side to move. The first mask holds the Locations of
+ *             the side to move, the second mask holds the Locations of its opponent.
+ *Precondition: At least one Location is vacant and neither side has completed a line.
+ *Postcondition: A vacant Location with the best score is returned
+ */
+Location NegamaxSearch::chooseMove(unsigned short own, unsigned short opponent)
+{
+    unsigned short emptyMask = GameBoard::FULL_MASK & ~(own | opponent);
+    int alpha = -WIN_SCORE - 1;
+    int beta = WIN_SCORE + 1;
+    int bestCell = -1;
+    SymmetricHashes hashes = hashPosition(own, opponent);
+    
+    for(int i = 0; i < 9; i++)
+    {
+        int cell = MOVE_ORDER[i];
+        if(!(emptyMask & (1 << cell)))
+            continue;
+        
+        //Take an immediate win without searching
+        if(GameBoard::hasLine(own | (1 << cell)))
+            return Location(cell / GameBoard::BOARD_SIZE, cell % GameBoard::BOARD_SIZE);
+        
+        SymmetricHashes child = hashes;
+        addStone(child, 0, cell);
+        int score = -negamax(opponent, own | (1 << cell), -beta, -alpha, child, 1);
+        if(score > alpha)
+        {
+            alpha = score;
+            bestCell = cell;
+        }
+    }
+    if(bestCell < 0)
+        return Location(0,0);
+    
+    return Location(bestCell / GameBoard::BOARD_SIZE, bestCell % GameBoard::BOARD_SIZE);
+}
+
+/*
+ *Description: Returns the game-theoretic score of the position for the side to move
+ *Precondition: The masks do not overlap.
+ *Postcondition: The perfect-play score is returned
+ */
+int NegamaxSearch::evaluate(unsigned short own, unsigned short opponent)
+{
+    //The opponent already completed a line
+    if(GameBoard::hasLine(opponent))
+        return -(WIN_SCORE - __builtin_popcount(own | opponent));
+    
+    return negamax(own, opponent, -WIN_SCORE - 1, WIN_SCORE + 1, hashPosition(own, opponent), 0);
+}
+
+/*
+ *Description: Accessor function that returns the number of positions visited so far
+ *Precondition: N/A
+ *Postcondition: The node count is returned
+ */
+long NegamaxSearch::getNodeCount() const
+{
+    return nodeCount;
+}
+
+/*
+ *Description: Removes every stored position from the transposition table
+ *Precondition: N/A
+ *Postcondition: The next search starts without stored results
+ */
+void NegamaxSearch::clearTable()
+{
+    table.clear();
+}
+
+/*
+ *Description: Scores the position for the side to move using negamax with alpha-beta pruning.
+ *             The result is exact when it lies strictly between alpha and beta.
+ *Precondition: alpha < beta and neither side has completed a line
+ *Postcondition: The score of the position is returned and stored in the transposition table
+ */
+int NegamaxSearch::negamax(unsigned short own, unsigned short opponent, int alpha, int beta,
+                           const SymmetricHashes& hashes, int side)
+{
+    nodeCount++;
+    
+    unsigned short emptyMask = GameBoard::FULL_MASK & ~(own | opponent);
+    int stones = __builtin_popcount(own | opponent);
+    
+    //If any vacant Location completes a line, win at once; the fewer stones, the sooner the win
+    for(unsigned short e = emptyMask; e; e &= e - 1)
+        if(GameBoard::hasLine(own | (e & -e)))
+            return WIN_SCORE - (stones + 1);
+    
+    //With no win available, the last vacant Location can only draw
+    if(stones >= 8)
+        return 0;
+    
+    //Symmetric positions share the smallest of their hashes
+    uint64_t key = hashes.values[0];
+    for(int symmetry = 1; symmetry < Zobrist::MAX_SYMMETRIES; symmetry++)
+        if(hashes.values[symmetry] < key)
+            key = hashes.values[symmetry];
+    if(side == 1)
+        key ^= Zobrist::getSideKey();
+    
+    //Scores depend only on the position, so a stored bound can narrow the window directly
+    TranspositionEntry entry;
+    if(table.probe(key, entry))
+    {
+        if(entry.bound == TranspositionTable::EXACT)
+            return entry.score;
+        if(entry.bound == TranspositionTable::LOWER && entry.score > alpha)
+            alpha = entry.score;
+        else if(entry.bound == TranspositionTable::UPPER && entry.score < beta)
+            beta = entry.score;
+        if(alpha >= beta)
+            return entry.score;
+    }
+    
+    int originalAlpha = alpha;
+    int best = -WIN_SCORE - 1;
+    for(int i = 0; i < 9; i++)
+    {
+        int cell = MOVE_ORDER[i];
+        if(!(emptyMask & (1 << cell)))
+            continue;
+        
+        SymmetricHashes child = hashes;
+        addStone(child, side, cell);
+        int score = -negamax(opponent, own | (1 << cell), -beta, -alpha, child, 1 - side);
+        if(score > best)
+        {
+            best = score;
+            if(score > alpha)
+                alpha = score;
+            if(alpha >= beta)
+                break;
+        }
+    }
+    
+    TranspositionTable::Bound bound = TranspositionTable::EXACT;
+    if(best <= originalAlpha)
+        bound = TranspositionTable::UPPER;
+    else if(best >= beta)
+        bound = TranspositionTable::LOWER;
+    table.store(key, best, 9 - stones, bound, -1);
+    return best;
+}
+
+/*
+ *Description: Computes the hashes of a position with the first mask as side 0
+ *Precondition: The masks do not overlap
+ *Postcondition: The hash under each symmetry is returned
+ */
+NegamaxSearch::SymmetricHashes NegamaxSearch::hashPosition(unsigned short own, unsigned short opponent) const
+{
+    SymmetricHashes hashes = {};
+    for(int cell = 0; cell < 9; cell++)
+    {
+        if(own & (1 << cell))
+            addStone(hashes, 0, cell);
+        else if(opponent & (1 << cell))
+            addStone(hashes, 1, cell);
+    }
+    return hashes;
+}
+
+/*
+ *Description: Updates the hashes for a stone of the supplied side on the supplied cell
+ *Precondition: The cell was vacant
+ *Postcondition: Each hash includes the stone at the cell's image under its symmetry
+ */
+void NegamaxSearch::addStone(SymmetricHashes& hashes, int side, int cell) const
+{
+    for(int symmetry = 0; symmetry < Zobrist::MAX_SYMMETRIES; symmetry++)
+        hashes.values[symmetry] ^= Zobrist::getKey(side, symmetries[symmetry][cell]);
+}
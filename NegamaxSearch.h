@@ -0,0 +1,113 @@
+/************************************************************************************
+ Title:         NegamaxSearch.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   A perfect-play search of the 3x3 game. Runs a full-depth negamax search
+                with alpha-beta pruning directly on the GameBoard occupancy masks.
+ 
+ Purpose:       Provides a reference-strength opponent that can not be beaten. Moves are
+                tried center first, then corners, then edges, which lets alpha-beta
+                prune most of the tree.
+ 
+ Usage:         NegamaxSearch search; search.chooseMove(ownMask, opponentMask);
+                Scores are from the point of view of the side to move: 0 is a draw, a
+                positive score is a win and a negative score is a loss. Wins that end
+                sooner score higher.
+ 
+ Build with:    Compile with main.cpp.
+ 
+ Modifications: Added a transposition table keyed by the canonical Zobrist hash, which
+                folds the 8 rotations and reflections of a position into one entry. The
+                table is kept between moves and games.
+ ***********************************************************************************/
+
+#ifndef TicTacToe_NegamaxSearch_h
+#define TicTacToe_NegamaxSearch_h
+
+#include "Location.h"
+#include "TranspositionTable.h"
+#include "Zobrist.h"
+#include <cstdint>
+using namespace std;
+
+class NegamaxSearch {
+    
+public:
+    NegamaxSearch();
+    /*
+     *Description: Constructor that initializes the node counter and an empty transposition table
+     *Precondition: N/A
+     *Postcondition: getNodeCount() returns 0
+     */
+    
+    Location chooseMove(unsigned short, unsigned short);
+    /*
+     *Description: Returns the best move for the side to move. The first mask holds the Locations of
+     *             the side to move, the second mask holds the Locations of its opponent.
+     *Precondition: At least one Location is vacant and neither side has completed a line.
+     *Postcondition: A vacant Location with the best score is returned
+     */
+    
+    int evaluate(unsigned short, unsigned short);
+    /*
+     *Description: Returns the game-theoretic score of the position for the side to move
+     *Precondition: The masks do not overlap.
+     *Postcondition: The perfect-play score is returned
+     */
+    
+    long getNodeCount() const;
+    /*
+     *Description: Accessor function that returns the number of positions visited so far
+     *Precondition: N/A
+     *Postcondition: The node count is returned
+     */
+    
+    void clearTable();
+    /*
+     *Description: Removes every stored position from the transposition table
+     *Precondition: N/A
+     *Postcondition: The next search starts without stored results
+     */
+    
+    static const int MOVE_ORDER[9]; //Cells in search order: center, corners, edges
+    static const int WIN_SCORE = 10; //A win scores WIN_SCORE minus the number of stones on the board
+    static const int TABLE_BITS = 12; //The transposition table has 2^TABLE_BITS slots
+    
+private:
+    //Zobrist hash of the position under each of the 8 symmetries of the board. Side 0 is the
+    //side to move at the root of the search and side 1 its opponent.
+    struct SymmetricHashes {
+        uint64_t values[Zobrist::MAX_SYMMETRIES];
+    };
+    
+    int negamax(unsigned short, unsigned short, int, int, const SymmetricHashes&, int);
+    /*
+     *Description: Scores the position for the side to move using negamax with alpha-beta pruning.
+     *             The result is exact when it lies strictly between alpha and beta. The hashes
+     *             describe the position and the last int is the side(0 or 1) to move.
+     *Precondition: alpha < beta and neither side has completed a line
+     *Postcondition: The score of the position is returned and stored in the transposition table
+     */
+    
+    SymmetricHashes hashPosition(unsigned short, unsigned short) const;
+    /*
+     *Description: Computes the hashes of a position with the first mask as side 0
+     *Precondition: The masks do not overlap
+     *Postcondition: The hash under each symmetry is returned
+     */
+    
+    void addStone(SymmetricHashes&, int, int) const;
+    /*
+     *Description: Updates the hashes for a stone of the supplied side(0 or 1) on the supplied cell
+     *Precondition: The cell was vacant
+     *Postcondition: Each hash includes the stone at the cell's image under its symmetry
+     */
+    
+    long nodeCount; //Number of positions visited
+    const int* symmetries[Zobrist::MAX_SYMMETRIES]; //Cell permutations of the 3x3 board
+    TranspositionTable table; //Scores of positions already searched, by canonical hash
+};
+#endif
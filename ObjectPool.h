@@ -0,0 +1,92 @@
+/************************************************************************************
+ Title:         ObjectPool.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   A pool of objects of one type, allocated in large chunks and addressed by
+                index. Released slots are kept on a free list and handed out again, so
+                after warm-up acquiring and releasing objects allocates nothing.
+ 
+ Purpose:       Stores millions of small objects, such as idle game sessions, without a
+                heap allocation and its bookkeeping per object. Objects never move, so
+                references stay valid while the slot is in use.
+ 
+ Usage:         ObjectPool<CompactGame> pool;
+                uint32_t slot = pool.acquire(); pool.get(slot) = game; pool.release(slot);
+                A released slot keeps its old contents until it is acquired again. The
+                pool is not thread safe.
+ 
+ Build with:    Header only.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#ifndef TicTacToe_ObjectPool_h
+#define TicTacToe_ObjectPool_h
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+using namespace std;
+
+template <class T>
+class ObjectPool {
+
+public:
+    static const uint32_t CHUNK_SIZE = 4096; //Objects allocated at a time
+    
+    ObjectPool() : used(0), live(0) {}
+    
+    /*Returns the index of a free slot, reusing released slots first.
+     *Precondition: N/A
+     *Postcondition: The slot is in use until it is released
+     */
+    uint32_t acquire()
+    {
+        live++;
+        if(!freeSlots.empty())
+        {
+            uint32_t slot = freeSlots.back();
+            freeSlots.pop_back();
+            return slot;
+        }
+        if(used == chunks.size() * CHUNK_SIZE)
+            chunks.push_back(unique_ptr<T[]>(new T[CHUNK_SIZE]));
+        return used++;
+    }
+    
+    /*Returns the slot to the pool.
+     *Precondition: The slot is in use
+     *Postcondition: The slot may be returned by a later acquire()
+     */
+    void release(uint32_t slot)
+    {
+        freeSlots.push_back(slot);
+        live--;
+    }
+    
+    /*Returns the object in the supplied slot.
+     *Precondition: The slot has been acquired at least once
+     */
+    T& get(uint32_t slot) { return chunks[slot / CHUNK_SIZE][slot % CHUNK_SIZE]; }
+    const T& get(uint32_t slot) const { return chunks[slot / CHUNK_SIZE][slot % CHUNK_SIZE]; }
+    
+    /*Returns true if the slot has been handed out at least once, so get() may be called.*/
+    bool contains(uint32_t slot) const { return slot < used; }
+    
+    /*Returns the number of slots in use.*/
+    size_t size() const { return live; }
+    
+    /*Returns the number of objects allocated.*/
+    size_t capacity() const { return chunks.size() * CHUNK_SIZE; }
+
+private:
+    vector<unique_ptr<T[]> > chunks; //Storage, CHUNK_SIZE objects per chunk
+    vector<uint32_t> freeSlots; //Released slots
+    uint32_t used; //Slots handed out at least once
+    size_t live; //Slots in use
+};
+#endif
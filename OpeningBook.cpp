@@ -0,0 +1,217 @@
+/************************************************************************************
+ Title:         OpeningBook.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of OpeningBook.h. A memory-mapped, sorted table of
+                opening moves.
+ 
+ Purpose:       Serves the first moves of a game without computing them.
+ 
+ Usage:         book.open(path, error); book.chooseMove(board, random, move);
+ 
+ Build with:    Compile with main.cpp. Linux only(mmap).
+ 
+ Modifications: Reads the number of layers of the board.
+ ***********************************************************************************/
+
+#include "OpeningBook.h"
+#include "GameRecord.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+const char OpeningBook::MAGIC[4] = { 'T', 'T', 'T', 'B' };
+
+/*
+ *Description: Constructor of an empty book
+ *Precondition: N/A
+ *Postcondition: The book has no entries
+ */
+OpeningBook::OpeningBook()
+    : mapping(0), mappingSize(0), entries(0), entryCount(0), geometry(&BoardGeometry::classic())
+{
+}
+
+/*
+ *Description: Destructor that unmaps the book file
+ *Precondition: No Computer uses the book any more
+ *Postcondition: The file is unmapped
+ */
+OpeningBook::~OpeningBook()
+{
+    if(mapping)
+        munmap(mapping, mappingSize);
+}
+
+/*
+ *Description: Maps the book file at the supplied path
+ *Precondition: No Computer uses the book yet
+ *Error Checking: The file must have a valid header of a supported version and board size, and
+ *                exactly the number of entries it announces.
+ *Postcondition: Returns true on success; otherwise the string holds the reason
+ */
+bool OpeningBook::open(const string& path, string& error)
+{
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if(fd < 0)
+    {
+        error = strerror(errno);
+        return false;
+    }
+    
+    struct stat status;
+    if(fstat(fd, &status) < 0 || status.st_size < static_cast<off_t>(HEADER_SIZE))
+    {
+        error = "not an opening book";
+        close(fd);
+        return false;
+    }
+    
+    size_t size = static_cast<size_t>(status.st_size);
+    void* file = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(file == MAP_FAILED)
+    {
+        error = strerror(errno);
+        return false;
+    }
+    
+    const unsigned char* header = static_cast<const unsigned char*>(file);
+    const BoardGeometry* bookGeometry = 0;
+    size_t count = GameRecord::getWord(header + 10);
+    if(memcmp(header, MAGIC, sizeof(MAGIC)) != 0)
+        error = "not an opening book";
+    else if((header[4] | (header[5] << 8)) != FORMAT_VERSION)
+        error = "unsupported book format version";
+    else if(size != HEADER_SIZE + count * ENTRY_SIZE)
+        error = "book size does not match its entry count";
+    else
+    {
+        try
+        {
+            bookGeometry = &BoardGeometry::get(header[6], header[7], header[8], max(1, static_cast<int>(header[9])));
+        }
+        catch(const invalid_argument&)
+        {
+            error = "unsupported board size";
+        }
+    }
+    if(!bookGeometry)
+    {
+        munmap(file, size);
+        return false;
+    }
+    
+    if(mapping)
+        munmap(mapping, mappingSize);
+    mapping = file;
+    mappingSize = size;
+    entries = header + HEADER_SIZE;
+    entryCount = count;
+    geometry = bookGeometry;
+    return true;
+}
+
+/*
+ *Description: Looks up the supplied board and picks one of its moves, weighted at random
+ *Precondition: N/A
+ *Postcondition: Returns true and sets the Location if the book has a vacant move for the board;
+ *               otherwise returns false
+ */
+bool OpeningBook::chooseMove(const GameBoard& board, Random& random, Location& move) const
+{
+    if(entryCount == 0 || &board.getGeometry() != geometry)
+        return false;
+    
+    //Binary search for the first entry of the position
+    uint64_t key = board.getCanonicalHash();
+    size_t low = 0, high = entryCount;
+    while(low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        if(getKey(entries + middle * ENTRY_SIZE) < key)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    
+    //The stored cells are on the canonical board; map them back through the inverse symmetry
+    const int* symmetry = geometry->getSymmetry(board.getCanonicalSymmetry());
+    int inverse[CellMask::CAPACITY];
+    for(int cell = 0; cell < geometry->getCellCount(); cell++)
+        inverse[symmetry[cell]] = cell;
+    
+    CellMask empty = board.getEmptyMask();
+    int cells[MAX_MOVES];
+    uint32_t weights[MAX_MOVES];
+    uint64_t total = 0;
+    int count = 0;
+    for(size_t i = low; i < entryCount && count < MAX_MOVES; i++)
+    {
+        const unsigned char* entry = entries + i * ENTRY_SIZE;
+        if(getKey(entry) != key)
+            break;
+        
+        int stored = entry[12] | (entry[13] << 8);
+        uint32_t weight = GameRecord::getWord(entry + 8);
+        if(stored >= geometry->getCellCount() || weight == 0 || !empty.test(inverse[stored]))
+            continue;
+        cells[count] = inverse[stored];
+        weights[count++] = weight;
+        total += weight;
+    }
+    if(count == 0)
+        return false;
+    
+    uint64_t pick = random.next() % total;
+    int chosen = 0;
+    while(pick >= weights[chosen])
+        pick -= weights[chosen++];
+    move = geometry->getLocation(cells[chosen]);
+    return true;
+}
+
+/*
+ *Description: Accessor function that returns the geometry of the book's positions
+ *Precondition: N/A
+ *Postcondition: A BoardGeometry is returned
+ */
+const BoardGeometry& OpeningBook::getGeometry() const
+{
+    return *geometry;
+}
+
+/*
+ *Description: Accessor function that returns the number of moves in the book
+ *Precondition: N/A
+ *Postcondition: A non-negative count is returned
+ */
+size_t OpeningBook::getEntryCount() const
+{
+    return entryCount;
+}
+
+/*
+ *Description: Load and store a 64-bit little-endian position hash
+ *Precondition: Eight bytes are available
+ *Postcondition: The hash is returned or stored
+ */
+uint64_t OpeningBook::getKey(const unsigned char* bytes)
+{
+    return GameRecord::getWord(bytes) | (static_cast<uint64_t>(GameRecord::getWord(bytes + 4)) << 32);
+}
+
+void OpeningBook::putKey(unsigned char* bytes, uint64_t key)
+{
+    GameRecord::putWord(bytes, static_cast<uint32_t>(key));
+    GameRecord::putWord(bytes + 4, static_cast<uint32_t>(key >> 32));
+}
@@ -0,0 +1,122 @@
+/************************************************************************************
+ Title:         OpeningBook.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   A read-only opening book: the preferred moves of early positions and
+                their weights, in a sorted file that is memory-mapped and searched in
+                place. A book file is:
+                  header   16 bytes: "TTTB", format version(2 bytes), width, height,
+                           win length, layers(0 for a flat board), entry count(4 bytes), 2
+                           reserved bytes
+                  entries  16 bytes each: canonical position hash(8 bytes), weight(4
+                           bytes), cell(2 bytes), 2 reserved bytes; sorted by hash,
+                           then cell
+                Positions are stored under GameBoard::getCanonicalHash(), so the
+                rotations and reflections of a position share its entries, and each cell
+                is stored as seen on the canonical board. All numbers are little-endian.
+ 
+ Purpose:       Serves the first moves of a game, the most repeated and on large boards
+                the most expensive ones to compute, with a binary search and no startup
+                cost. One book can be shared by every Computer of a process.
+ 
+ Usage:         OpeningBook book;
+                if(!book.open(path, error)) ...
+                computer.setOpeningBook(&book);
+                Books are written by OpeningBookBuilder(see makebook.cpp). Among the
+                moves of a position, chooseMove picks one with probability proportional
+                to its weight.
+ 
+ Build with:    Compile with main.cpp. Linux only(mmap).
+ 
+ Modifications: The header records the number of layers of the board.
+ ***********************************************************************************/
+
+#ifndef TicTacToe_OpeningBook_h
+#define TicTacToe_OpeningBook_h
+
+#include "BoardGeometry.h"
+#include "GameBoard.h"
+#include "Location.h"
+#include "Random.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+using namespace std;
+
+class OpeningBook {
+
+public:
+    OpeningBook();
+    /*
+     *Description: Constructor of an empty book
+     *Precondition: N/A
+     *Postcondition: The book has no entries
+     */
+    
+    ~OpeningBook();
+    /*
+     *Description: Destructor that unmaps the book file
+     *Precondition: No Computer uses the book any more
+     *Postcondition: The file is unmapped
+     */
+    
+    bool open(const string&, string&);
+    /*
+     *Description: Maps the book file at the supplied path
+     *Precondition: No Computer uses the book yet
+     *Error Checking: The file must have a valid header of a supported version and board size, and
+     *                exactly the number of entries it announces.
+     *Postcondition: Returns true on success; otherwise the string holds the reason
+     */
+    
+    bool chooseMove(const GameBoard&, Random&, Location&) const;
+    /*
+     *Description: Looks up the supplied board and picks one of its moves, weighted at random
+     *Precondition: N/A
+     *Postcondition: Returns true and sets the Location if the book has a vacant move for the board;
+     *               otherwise returns false. Safe to call from several threads at once.
+     */
+    
+    const BoardGeometry& getGeometry() const;
+    /*
+     *Description: Accessor function that returns the geometry of the book's positions
+     *Precondition: N/A
+     *Postcondition: A BoardGeometry is returned
+     */
+    
+    size_t getEntryCount() const;
+    /*
+     *Description: Accessor function that returns the number of moves in the book
+     *Precondition: N/A
+     *Postcondition: A non-negative count is returned
+     */
+    
+    static uint64_t getKey(const unsigned char*);
+    static void putKey(unsigned char*, uint64_t);
+    /*
+     *Description: Load and store a 64-bit little-endian position hash
+     *Precondition: Eight bytes are available
+     *Postcondition: The hash is returned or stored
+     */
+    
+    static const uint16_t FORMAT_VERSION = 1; //Version written in the header
+    static const size_t HEADER_SIZE = 16; //Bytes of the header
+    static const size_t ENTRY_SIZE = 16; //Bytes of each entry
+    static const int MAX_MOVES = 64; //Most moves of one position that are considered
+    static const char MAGIC[4]; //First bytes of every book file
+
+private:
+    OpeningBook(const OpeningBook&);
+    OpeningBook& operator=(const OpeningBook&);
+    //Books own their mapping and are not copied
+    
+    void* mapping; //Mapped file, or 0
+    size_t mappingSize; //Bytes mapped
+    const unsigned char* entries; //First entry
+    size_t entryCount; //Number of entries
+    const BoardGeometry* geometry; //Geometry of the book's positions
+};
+#endif
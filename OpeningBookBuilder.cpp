@@ -0,0 +1,156 @@
+/************************************************************************************
+ Title:         OpeningBookBuilder.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of OpeningBookBuilder.h. Builds an OpeningBook file
+                from recorded games.
+ 
+ Purpose:       Turns self-play logs into a book.
+ 
+ Usage:         builder.add(record); builder.write(path, minimumGames, error);
+ 
+ Build with:    Compile with makebook.cpp.
+ 
+ Modifications: Writes the number of layers of the board.
+                Moves are weighted by their average score, and those clearly below the
+                best of their position are left out.
+ ***********************************************************************************/
+
+#include "OpeningBookBuilder.h"
+#include "GameBoard.h"
+#include "OpeningBook.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+using namespace std;
+
+/*
+ *Description: Constructor of a builder for games of the supplied geometry
+ *Precondition: The BoardGeometry outlives the builder
+ *Postcondition: The builder has no games
+ */
+OpeningBookBuilder::OpeningBookBuilder(const BoardGeometry& boardGeometry, int bookPlies)
+    : geometry(boardGeometry), plies(bookPlies), gameCount(0)
+{
+}
+
+/*
+ *Description: Credits the opening moves of the supplied game with its result
+ *Precondition: The game was played on the builder's geometry
+ *Postcondition: Returns false, and adds nothing, if the game is unfinished or has an illegal move
+ */
+bool OpeningBookBuilder::add(const GameRecord& record)
+{
+    if(record.getResult() == GameRecord::UNFINISHED)
+        return false;
+    
+    //Replay first, so that a damaged game adds nothing
+    GameBoard board(geometry);
+    board.setPlayerID("X");
+    pair<uint64_t, int> keys[CellMask::CAPACITY];
+    int count = min(plies, record.getMoveCount());
+    for(int i = 0; i < count; i++)
+    {
+        int cell = record.getMove(i);
+        const int* symmetry = geometry.getSymmetry(board.getCanonicalSymmetry());
+        keys[i] = make_pair(board.getCanonicalHash(), symmetry[cell]);
+        if(board.getGameStatus() || !board.makeMove(geometry.getLocation(cell), i % 2))
+            return false;
+    }
+    
+    for(int i = 0; i < count; i++)
+    {
+        //'X' makes the even-numbered moves
+        int points = 1;
+        if(record.getResult() != GameRecord::DRAW)
+            points = ((record.getResult() == GameRecord::X_WON) == (i % 2 == 0)) ? 2 : 0;
+        
+        MoveStats& stats = moves[keys[i]];
+        stats.games++;
+        stats.points += points;
+    }
+    gameCount++;
+    return true;
+}
+
+/*
+ *Description: Writes the book to the supplied path, keeping in each position the moves played in at least
+ *             the supplied number of games whose average score is close to the best
+ *Precondition: N/A
+ *Postcondition: Returns true on success; otherwise the string holds the reason
+ */
+bool OpeningBookBuilder::write(const string& path, long minimumGames, string& error) const
+{
+    //The map is already sorted by hash, then cell, so the moves of a position are next to each other
+    typedef map<pair<uint64_t, int>, MoveStats>::const_iterator MoveIterator;
+    vector<unsigned char> bytes(OpeningBook::HEADER_SIZE, 0);
+    uint32_t count = 0;
+    for(MoveIterator first = moves.begin(); first != moves.end(); )
+    {
+        MoveIterator last = first;
+        double best = 0;
+        for(; last != moves.end() && last->first.first == first->first.first; ++last)
+            if(last->second.games >= minimumGames)
+                best = max(best, static_cast<double>(last->second.points) / last->second.games);
+        
+        for(MoveIterator it = first; it != last; ++it)
+        {
+            double average = static_cast<double>(it->second.points) / it->second.games;
+            if(it->second.games < minimumGames || average == 0 || average < best - SCORE_MARGIN)
+                continue;
+            
+            unsigned char entry[OpeningBook::ENTRY_SIZE] = { 0 };
+            OpeningBook::putKey(entry, it->first.first);
+            GameRecord::putWord(entry + 8, static_cast<uint32_t>(max(1L, lround(average * WEIGHT_SCALE))));
+            entry[12] = static_cast<unsigned char>(it->first.second & 0xFF);
+            entry[13] = static_cast<unsigned char>(it->first.second >> 8);
+            bytes.insert(bytes.end(), entry, entry + sizeof(entry));
+            count++;
+        }
+        first = last;
+    }
+    
+    memcpy(&bytes[0], OpeningBook::MAGIC, sizeof(OpeningBook::MAGIC));
+    bytes[4] = static_cast<unsigned char>(OpeningBook::FORMAT_VERSION & 0xFF);
+    bytes[5] = static_cast<unsigned char>(OpeningBook::FORMAT_VERSION >> 8);
+    bytes[6] = static_cast<unsigned char>(geometry.getWidth());
+    bytes[7] = static_cast<unsigned char>(geometry.getHeight());
+    bytes[8] = static_cast<unsigned char>(geometry.getWinLength());
+    bytes[9] = static_cast<unsigned char>(geometry.getLayerCount() > 1 ? geometry.getLayerCount() : 0);
+    GameRecord::putWord(&bytes[10], count);
+    
+    FILE* file = fopen(path.c_str(), "wb");
+    if(!file)
+    {
+        error = strerror(errno);
+        return false;
+    }
+    bool written = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    if(fclose(file) != 0 || !written)
+    {
+        error = "write failed";
+        return false;
+    }
+    return true;
+}
+
+/*
+ *Description: Accessor functions for the number of games added and of distinct position and move pairs
+ *Precondition: N/A
+ *Postcondition: A non-negative count is returned
+ */
+long OpeningBookBuilder::getGameCount() const
+{
+    return gameCount;
+}
+
+long OpeningBookBuilder::getMoveCount() const
+{
+    return static_cast<long>(moves.size());
+}
@@ -0,0 +1,92 @@
+/************************************************************************************
+ Title:         OpeningBookBuilder.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   Builds an OpeningBook file(see OpeningBook.h) from recorded games. Every
+                move of the first plies of each finished game is credited with the
+                points its side scored: 2 for a win, 1 for a draw and 0 for a loss.
+ 
+ Purpose:       Turns self-play logs into a book, so the moves that scored best on
+                average are played without search.
+ 
+ Usage:         OpeningBookBuilder builder(geometry, plies);
+                builder.add(record); ... //every finished game
+                builder.write(path, minimumGames, error);
+                Only moves played in at least 'minimumGames' games are ranked. Of those,
+                a position keeps the moves whose average score is within SCORE_MARGIN of
+                its best, and above 0. Each is written with its average score in
+                thousandths of a point as its weight. How often a move was played does
+                not count, so the many games of a strong side's poor moves do not
+                outweigh its good ones.
+ 
+ Build with:    Compile with makebook.cpp.
+ 
+ Modifications: Moves are ranked and weighted by their average score rather than their
+                total points.
+ ***********************************************************************************/
+
+#ifndef TicTacToe_OpeningBookBuilder_h
+#define TicTacToe_OpeningBookBuilder_h
+
+#include "BoardGeometry.h"
+#include "GameRecord.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+using namespace std;
+
+class OpeningBookBuilder {
+
+public:
+    OpeningBookBuilder(const BoardGeometry&, int);
+    /*
+     *Description: Constructor of a builder for games of the supplied geometry that covers the supplied
+     *             number of plies
+     *Precondition: The BoardGeometry outlives the builder
+     *Postcondition: The builder has no games
+     */
+    
+    bool add(const GameRecord&);
+    /*
+     *Description: Credits the opening moves of the supplied game with its result
+     *Precondition: The game was played on the builder's geometry
+     *Postcondition: Returns false, and adds nothing, if the game is unfinished or has an illegal move
+     */
+    
+    bool write(const string&, long, string&) const;
+    /*
+     *Description: Writes the book to the supplied path, keeping the moves played in at least the
+     *             supplied number of games
+     *Precondition: N/A
+     *Postcondition: Returns true on success; otherwise the string holds the reason
+     */
+    
+    long getGameCount() const;
+    long getMoveCount() const;
+    /*
+     *Description: Accessor functions for the number of games added and of distinct position and move pairs
+     *Precondition: N/A
+     *Postcondition: A non-negative count is returned
+     */
+    
+    static constexpr double SCORE_MARGIN = 0.1; //Most points a kept move's average may be below its position's best
+    static const long WEIGHT_SCALE = 1000; //Weight of an average score of one point
+
+private:
+    struct MoveStats {
+        long games; //Games in which the move was played
+        long points; //Points scored by the side that played it
+        
+        MoveStats() : games(0), points(0) {}
+    };
+    
+    const BoardGeometry& geometry; //Board of the games
+    int plies; //Moves of each game that are credited
+    long gameCount; //Games added
+    map<pair<uint64_t, int>, MoveStats> moves; //Statistics by canonical hash and canonical cell
+};
+#endif
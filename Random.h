@@ -0,0 +1,112 @@
+/************************************************************************************
+ Title:         Random.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   A small seedable pseudo-random number generator(SplitMix64). Each Computer
+                and each self-play worker owns one, so results do not depend on a shared
+                global generator such as rand().
+ 
+ Purpose:       Provides reproducible random streams: the same seed always produces the
+                same sequence, and independent streams can be derived from one seed.
+ 
+ Usage:         Random random(seed); int n = random.nextInt(bound);
+                Random::derive(seed, index) gives the seed of the index-th stream.
+ 
+ Build with:    Header only. Compile with main.cpp.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+#ifndef TicTacToe_Random_h
+#define TicTacToe_Random_h
+
+#include <cstdint>
+using namespace std;
+
+class Random {
+
+public:
+    explicit Random(uint64_t = DEFAULT_SEED);
+    /*
+     *Description: Constructor that starts the generator from the supplied seed
+     *Precondition: N/A
+     *Postcondition: The generator produces the sequence of the seed
+     */
+    
+    void setSeed(uint64_t);
+    /*
+     *Description: Restarts the generator from the supplied seed
+     *Precondition: N/A
+     *Postcondition: The generator produces the sequence of the seed
+     */
+    
+    uint64_t next();
+    /*
+     *Description: Returns the next 64 random bits
+     *Precondition: N/A
+     *Postcondition: The generator has advanced by one step
+     */
+    
+    int nextInt(int);
+    /*
+     *Description: Returns a random integer below the supplied bound
+     *Precondition: bound > 0
+     *Postcondition: An integer between 0 and bound - 1 is returned
+     */
+    
+    static uint64_t derive(uint64_t, uint64_t);
+    /*
+     *Description: Returns the seed of the index-th stream derived from the supplied seed. Different
+     *             indices give statistically independent streams.
+     *Precondition: N/A
+     *Postcondition: A 64-bit seed is returned
+     */
+    
+    static const uint64_t DEFAULT_SEED = 0x853C49E6748FEA9BULL; //Seed used when none is supplied
+
+private:
+    static uint64_t mix(uint64_t);
+    /*
+     *Description: Returns the SplitMix64 finalizer of the supplied value
+     *Precondition: N/A
+     *Postcondition: A 64-bit value is returned
+     */
+    
+    uint64_t state; //Current position in the sequence
+};
+
+//The generator runs in the inner loops of the searches, so its functions are defined here
+inline Random::Random(uint64_t seed) : state(seed)
+{
+}
+
+inline void Random::setSeed(uint64_t seed)
+{
+    state = seed;
+}
+
+inline uint64_t Random::next()
+{
+    state += 0x9E3779B97F4A7C15ULL;
+    return mix(state);
+}
+
+inline int Random::nextInt(int bound)
+{
+    return static_cast<int>(((next() >> 32) * static_cast<uint64_t>(bound)) >> 32);
+}
+
+inline uint64_t Random::derive(uint64_t seed, uint64_t index)
+{
+    return mix(seed ^ mix(index + 0x9E3779B97F4A7C15ULL));
+}
+
+inline uint64_t Random::mix(uint64_t z)
+{
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+#endif
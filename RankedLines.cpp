@@ -0,0 +1,137 @@
+/************************************************************************************
+ Title:         RankedLines.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of RankedLines.h. Keeps the valid winning lines of one
+                side grouped by rank.
+ 
+ Purpose:       Provides constant-time rank changes and removals for the incremental line
+                tracking in Computer.
+ 
+ Usage:         RankedLines ranks; ranks.reset(lineCount, winLength);
+ 
+ Build with:    Compile with main.cpp.
+ 
+ Modifications: reset reserves room for every line in every bucket.
+ ***********************************************************************************/
+
+#include "RankedLines.h"
+using namespace std;
+
+/*
+ *Description: Constructor that creates an empty index
+ *Precondition: N/A
+ *Postcondition: getHighestRank() returns -1
+ */
+RankedLines::RankedLines() : highestRank(-1)
+{
+}
+
+/*
+ *Description: Places every one of the supplied number of lines at rank 0. Ranks may later
+ *             range from 0 to the supplied maximum rank.
+ *Precondition: Both parameters are non-negative.
+ *Postcondition: All lines are valid with rank 0; every bucket has room for every line
+ */
+void RankedLines::reset(int lineCount, int maxRank)
+{
+    //Every bucket can hold every line, so no later move allocates
+    buckets.resize(maxRank + 1);
+    for(size_t i = 0; i < buckets.size(); i++)
+    {
+        buckets[i].clear();
+        buckets[i].reserve(lineCount);
+    }
+    
+    rankOf.assign(lineCount, 0);
+    slotOf.resize(lineCount);
+    for(int line = 0; line < lineCount; line++)
+    {
+        slotOf[line] = line;
+        buckets[0].push_back(line);
+    }
+    highestRank = lineCount > 0 ? 0 : -1;
+}
+
+/*
+ *Description: Moves a valid line to the bucket of the supplied rank
+ *Precondition: The line has not been removed and 0 <= rank <= maximum rank
+ *Postcondition: The line is listed under its new rank only
+ */
+void RankedLines::setRank(int line, int rank)
+{
+    if(rankOf[line] == rank)
+        return;
+    
+    detach(line);
+    rankOf[line] = rank;
+    slotOf[line] = static_cast<int>(buckets[rank].size());
+    buckets[rank].push_back(line);
+    if(rank > highestRank)
+        highestRank = rank;
+}
+
+/*
+ *Description: Removes a line(it can no longer be completed)
+ *Precondition: N/A
+ *Postcondition: The line is no longer listed under any rank
+ */
+void RankedLines::remove(int line)
+{
+    if(rankOf[line] < 0)
+        return;
+    
+    detach(line);
+    rankOf[line] = -1;
+}
+
+/*
+ *Description: Returns whether the line is still valid
+ *Precondition: N/A
+ *Postcondition: A boolean value is returned
+ */
+bool RankedLines::contains(int line) const
+{
+    return rankOf[line] >= 0;
+}
+
+/*
+ *Description: Returns the highest rank that still holds a valid line
+ *Precondition: N/A
+ *Postcondition: The rank is returned, or -1 when no line is valid
+ */
+int RankedLines::getHighestRank() const
+{
+    return highestRank;
+}
+
+/*
+ *Description: Returns the valid lines of the supplied rank in no particular order
+ *Precondition: 0 <= rank <= maximum rank
+ *Postcondition: A list of line indices is returned
+ */
+const vector<int>& RankedLines::getLines(int rank) const
+{
+    return buckets[rank];
+}
+
+/*
+ *Description: Takes the line out of its current bucket
+ *Precondition: The line is valid
+ *Postcondition: The line's old slot is filled by the bucket's last line
+ */
+void RankedLines::detach(int line)
+{
+    vector<int>& bucket = buckets[rankOf[line]];
+    int last = bucket.back();
+    bucket[slotOf[line]] = last;
+    slotOf[last] = slotOf[line];
+    bucket.pop_back();
+    
+    //Lower the highest rank past buckets that just became empty
+    while(highestRank >= 0 && buckets[highestRank].empty())
+        highestRank--;
+}
@@ -0,0 +1,94 @@
+/************************************************************************************
+ Title:         RankedLines.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   Keeps the valid winning lines of one side grouped by rank, so that the
+                highest-ranked lines can be read without scanning every line.
+ 
+ Purpose:       Provides constant-time rank changes and removals(swap with the last line
+                of the bucket) for the incremental line tracking in Computer.
+ 
+ Usage:         RankedLines ranks; ranks.reset(lineCount, winLength);
+                ranks.setRank(line, 2); ranks.remove(line); ranks.getLines(ranks.getHighestRank());
+ 
+ Build with:    Compile with main.cpp.
+ 
+ Modifications: reset reserves room for every line in every bucket.
+ ***********************************************************************************/
+
+#ifndef TicTacToe_RankedLines_h
+#define TicTacToe_RankedLines_h
+
+#include <vector>
+using namespace std;
+
+class RankedLines {
+
+public:
+    RankedLines();
+    /*
+     *Description: Constructor that creates an empty index
+     *Precondition: N/A
+     *Postcondition: getHighestRank() returns -1
+     */
+    
+    void reset(int, int);
+    /*
+     *Description: Places every one of the supplied number of lines at rank 0. Ranks may later
+     *             range from 0 to the supplied maximum rank.
+     *Precondition: Both parameters are non-negative.
+     *Postcondition: All lines are valid with rank 0; every bucket has room for every line
+     */
+    
+    void setRank(int, int);
+    /*
+     *Description: Moves a valid line to the bucket of the supplied rank
+     *Precondition: The line has not been removed and 0 <= rank <= maximum rank
+     *Postcondition: The line is listed under its new rank only
+     */
+    
+    void remove(int);
+    /*
+     *Description: Removes a line(it can no longer be completed)
+     *Precondition: N/A
+     *Postcondition: The line is no longer listed under any rank
+     */
+    
+    bool contains(int) const;
+    /*
+     *Description: Returns whether the line is still valid
+     *Precondition: N/A
+     *Postcondition: A boolean value is returned
+     */
+    
+    int getHighestRank() const;
+    /*
+     *Description: Returns the highest rank that still holds a valid line
+     *Precondition: N/A
+     *Postcondition: The rank is returned, or -1 when no line is valid
+     */
+    
+    const vector<int>& getLines(int) const;
+    /*
+     *Description: Returns the valid lines of the supplied rank in no particular order
+     *Precondition: 0 <= rank <= maximum rank
+     *Postcondition: A list of line indices is returned
+     */
+
+private:
+    void detach(int);
+    /*
+     *Description: Takes the line out of its current bucket
+     *Precondition: The line is valid
+     *Postcondition: The line's old slot is filled by the bucket's last line
+     */
+    
+    vector<vector<int> > buckets; //Valid lines of each rank
+    vector<int> rankOf; //Rank of each line, or -1 once removed
+    vector<int> slotOf; //Position of each line inside its bucket
+    int highestRank; //Upper bound on the highest non-empty bucket
+};
+#endif
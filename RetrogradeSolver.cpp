@@ -0,0 +1,444 @@
+/************************************************************************************
+ Title:         RetrogradeSolver.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of RetrogradeSolver.h. While solving, the forward pass
+                leaves a mark in each entry(OPEN, FINISHED or UNREACHABLE) and the
+                backward pass replaces the marks of a layer by scores once the layer after
+                it is scored. A position is reachable if removing one of the last mover's
+                stones gives a reachable position whose game was still going on.
+ 
+ Purpose:       Computes complete game-value tables in bulk.
+ 
+ Usage:         RetrogradeSolver solver(geometry); solver.solve(threads);
+ 
+ Build with:    Compile with main.cpp. Requires a thread library(-pthread).
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#include "RetrogradeSolver.h"
+#include "GameRecord.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+using namespace std;
+
+const char RetrogradeSolver::MAGIC[4] = { 'T', 'T', 'T', 'V' };
+
+/*
+ *Description: Constructor of an unsolved table for boards of the supplied geometry
+ *Precondition: The BoardGeometry outlives the solver
+ *Error Checking: Throws invalid_argument if the board has more than MAX_CELLS cells
+ *Postcondition: The layer offsets are computed; no table is allocated until solve or open
+ */
+RetrogradeSolver::RetrogradeSolver(const BoardGeometry& boardGeometry)
+    : geometry(boardGeometry), cellCount(boardGeometry.getCellCount()), reachableCount(0)
+{
+    if(cellCount > MAX_CELLS)
+        throw invalid_argument("retrograde tables are limited to boards of " + to_string(MAX_CELLS) + " cells");
+    
+    for(int line = 0; line < geometry.getLineCount(); line++)
+        lines.push_back(static_cast<uint32_t>(geometry.getLine(line).word(0)));
+    
+    for(int n = 0; n <= MAX_CELLS; n++)
+        for(int k = 0; k <= MAX_CELLS; k++)
+            binomial[n][k] = (k == 0) ? 1 : (n == 0 || k > n) ? 0 : binomial[n - 1][k - 1] + binomial[n - 1][k];
+    
+    //Layer p places (p + 1) / 2 stones of 'X' and p / 2 of 'O' on p of the cells
+    layerOffsets[0] = 0;
+    for(int stones = 0; stones <= cellCount; stones++)
+        layerOffsets[stones + 1] = layerOffsets[stones] + getLayerSize(stones);
+}
+
+/*
+ *Description: Scores every position on the supplied number of threads(0 selects one per hardware thread)
+ *Precondition: N/A
+ *Postcondition: Every entry of the table holds its position's score or UNREACHABLE
+ */
+void RetrogradeSolver::solve(int threads)
+{
+    int threadCount = threads > 0 ? threads : max(1, static_cast<int>(thread::hardware_concurrency()));
+    scores.assign(getPositionCount(), static_cast<signed char>(UNREACHABLE));
+    
+    for(int stones = 0; stones <= cellCount; stones++)
+        runLayer(&RetrogradeSolver::markLayer, stones, threadCount);
+    for(int stones = cellCount; stones >= 0; stones--)
+        runLayer(&RetrogradeSolver::scoreLayer, stones, threadCount);
+    
+    countReachable();
+}
+
+/*
+ *Description: Writes the table to the file at the supplied path
+ *Precondition: The table is solved
+ *Postcondition: Returns true on success; otherwise the string holds the reason
+ */
+bool RetrogradeSolver::save(const string& path, string& error) const
+{
+    unsigned char header[HEADER_SIZE] = { 0 };
+    memcpy(header, MAGIC, sizeof(MAGIC));
+    header[4] = static_cast<unsigned char>(FORMAT_VERSION & 0xFF);
+    header[5] = static_cast<unsigned char>(FORMAT_VERSION >> 8);
+    header[6] = static_cast<unsigned char>(geometry.getWidth());
+    header[7] = static_cast<unsigned char>(geometry.getHeight());
+    header[8] = static_cast<unsigned char>(geometry.getWinLength());
+    header[9] = static_cast<unsigned char>(geometry.getLayerCount() > 1 ? geometry.getLayerCount() : 0);
+    GameRecord::putWord(header + 10, static_cast<uint32_t>(scores.size()));
+    
+    FILE* file = fopen(path.c_str(), "wb");
+    if(!file)
+    {
+        error = strerror(errno);
+        return false;
+    }
+    bool written = fwrite(header, 1, sizeof(header), file) == sizeof(header)
+                   && fwrite(scores.data(), 1, scores.size(), file) == scores.size();
+    if(fclose(file) != 0 || !written)
+    {
+        error = "write failed";
+        return false;
+    }
+    return true;
+}
+
+/*
+ *Description: Reads a table written by save for the same board
+ *Precondition: N/A
+ *Error Checking: The file must have a valid header of a supported version, this solver's board size,
+ *                and exactly the number of positions of that board.
+ *Postcondition: Returns true and replaces the table on success; otherwise the string holds the reason
+ */
+bool RetrogradeSolver::open(const string& path, string& error)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if(!file)
+    {
+        error = strerror(errno);
+        return false;
+    }
+    
+    unsigned char header[HEADER_SIZE];
+    vector<signed char> table;
+    bool valid = false;
+    if(fread(header, 1, sizeof(header), file) != sizeof(header) || memcmp(header, MAGIC, sizeof(MAGIC)) != 0)
+        error = "not a retrograde table";
+    else if((header[4] | (header[5] << 8)) != FORMAT_VERSION)
+        error = "unsupported table format version";
+    else if(header[6] != geometry.getWidth() || header[7] != geometry.getHeight()
+            || header[8] != geometry.getWinLength() || max(1, static_cast<int>(header[9])) != geometry.getLayerCount())
+        error = "the table is for another board size";
+    else if(GameRecord::getWord(header + 10) != static_cast<uint32_t>(getPositionCount()))
+        error = "table size does not match its board";
+    else
+    {
+        //One extra byte must not be there
+        table.resize(getPositionCount() + 1);
+        valid = fread(table.data(), 1, table.size(), file) == static_cast<size_t>(getPositionCount());
+        if(!valid)
+            error = "table size does not match its position count";
+        table.pop_back();
+    }
+    fclose(file);
+    if(!valid)
+        return false;
+    
+    scores.swap(table);
+    countReachable();
+    return true;
+}
+
+/*
+ *Description: Returns true once solve or open has filled the table
+ *Precondition: N/A
+ *Postcondition: A boolean value is returned
+ */
+bool RetrogradeSolver::isSolved() const
+{
+    return !scores.empty();
+}
+
+/*
+ *Description: Returns the index of the position with the supplied 'X' and 'O' cell masks
+ *Precondition: The masks do not overlap, use only cells of the board, and 'X' has as many stones as
+ *              'O' or one more
+ *Postcondition: An integer between 0 and getPositionCount() - 1 is returned
+ */
+long RetrogradeSolver::getIndex(uint32_t x, uint32_t o) const
+{
+    uint32_t occupied = x | o;
+    int stones = __builtin_popcount(occupied);
+    
+    //The i-th occupied cell c adds C(c, i + 1); the j-th 'X' among them, found at position i, adds C(i, j + 1)
+    long occupiedRank = 0;
+    long xRank = 0;
+    int position = 0;
+    int xCount = 0;
+    for(uint32_t rest = occupied; rest; rest &= rest - 1, position++)
+    {
+        int cell = __builtin_ctz(rest);
+        occupiedRank += binomial[cell][position + 1];
+        if(x & (1u << cell))
+            xRank += binomial[position][++xCount];
+    }
+    return layerOffsets[stones] + occupiedRank * binomial[stones][(stones + 1) / 2] + xRank;
+}
+
+/*
+ *Description: Returns the score of the supplied position for the side to move
+ *Precondition: The table is solved; the stone counts are those of a game('X' moves first)
+ *Postcondition: The score, or UNREACHABLE, is returned
+ */
+int RetrogradeSolver::getScore(uint32_t x, uint32_t o) const
+{
+    return scores[getIndex(x, o)];
+}
+
+/*
+ *Description: Returns the score of the position on the supplied board for the side to move
+ *Precondition: The table is solved; the board has this solver's geometry and the stone counts of a game
+ *Postcondition: The score, or UNREACHABLE, is returned
+ */
+int RetrogradeSolver::getScore(const GameBoard& board) const
+{
+    return getScore(static_cast<uint32_t>(board.getMask(0).word(0)), static_cast<uint32_t>(board.getMask(1).word(0)));
+}
+
+/*
+ *Description: Returns a best move for the side to move on a board of this solver's geometry
+ *Precondition: The table is solved; the game is not over
+ *Postcondition: The lowest-numbered vacant cell whose move achieves the position's score is returned
+ */
+Location RetrogradeSolver::chooseMove(const GameBoard& board) const
+{
+    uint32_t x = static_cast<uint32_t>(board.getMask(0).word(0));
+    uint32_t o = static_cast<uint32_t>(board.getMask(1).word(0));
+    bool xToMove = __builtin_popcount(x) == __builtin_popcount(o);
+    int score = getScore(x, o);
+    
+    uint32_t vacant = ((uint32_t(1) << cellCount) - 1) & ~(x | o);
+    for(uint32_t rest = vacant; rest; rest &= rest - 1)
+    {
+        uint32_t cell = rest & (0u - rest);
+        if(-(xToMove ? getScore(x | cell, o) : getScore(x, o | cell)) == score)
+            return geometry.getLocation(__builtin_ctz(cell));
+    }
+    return geometry.getLocation(__builtin_ctz(vacant));
+}
+
+/*
+ *Description: Accessor function that returns the number of entries of the table
+ *Precondition: N/A
+ *Postcondition: A positive count is returned
+ */
+long RetrogradeSolver::getPositionCount() const
+{
+    return layerOffsets[cellCount + 1];
+}
+
+/*
+ *Description: Accessor function that returns the number of positions with the supplied number of stones
+ *Precondition: N/A
+ *Postcondition: A count is returned; 0 if the number is not between 0 and the number of cells
+ */
+long RetrogradeSolver::getLayerSize(int stones) const
+{
+    if(stones < 0 || stones > cellCount)
+        return 0;
+    return binomial[cellCount][stones] * binomial[stones][(stones + 1) / 2];
+}
+
+/*
+ *Description: Accessor function that returns the number of positions that can occur in a game
+ *Precondition: N/A
+ *Postcondition: A count is returned; 0 until the table is solved
+ */
+long RetrogradeSolver::getReachableCount() const
+{
+    return reachableCount;
+}
+
+/*
+ *Description: Returns the score of a win on an empty board: the number of cells plus one
+ *Precondition: N/A
+ *Postcondition: A positive integer is returned
+ */
+int RetrogradeSolver::getWinScore() const
+{
+    return cellCount + 1;
+}
+
+/*
+ *Description: Accessor function that returns the board the table is for
+ *Precondition: N/A
+ *Postcondition: The BoardGeometry is returned
+ */
+const BoardGeometry& RetrogradeSolver::getGeometry() const
+{
+    return geometry;
+}
+
+/*
+ *Description: Marks the positions of the supplied layer between the supplied indices from the marks of
+ *             the layer before
+ *Precondition: The layer before is marked
+ *Postcondition: The entries hold OPEN, FINISHED or UNREACHABLE
+ */
+void RetrogradeSolver::markLayer(int stones, long begin, long end)
+{
+    for(long index = begin; index < end; index++)
+    {
+        if(stones == 0)
+        {
+            scores[index] = OPEN;
+            continue;
+        }
+        
+        uint32_t x, o;
+        getPosition(index, x, o);
+        bool xMovedLast = stones % 2 == 1;
+        uint32_t lastMover = xMovedLast ? x : o;
+        
+        bool reachable = false;
+        for(uint32_t rest = lastMover; rest && !reachable; rest &= rest - 1)
+        {
+            uint32_t cell = rest & (0u - rest);
+            reachable = scores[xMovedLast ? getIndex(x ^ cell, o) : getIndex(x, o ^ cell)] == OPEN;
+        }
+        if(reachable)
+            scores[index] = (hasLine(lastMover) || stones == cellCount) ? FINISHED : OPEN;
+    }
+}
+
+/*
+ *Description: Replaces the marks of the positions of the supplied layer between the supplied indices by
+ *             their scores, from the scores of the layer after
+ *Precondition: The layer is marked and the layer after is scored
+ *Postcondition: The entries hold scores or UNREACHABLE
+ */
+void RetrogradeSolver::scoreLayer(int stones, long begin, long end)
+{
+    int winScore = getWinScore();
+    uint32_t board = (uint32_t(1) << cellCount) - 1;
+    for(long index = begin; index < end; index++)
+    {
+        signed char mark = scores[index];
+        if(mark == UNREACHABLE)
+            continue;
+        
+        uint32_t x, o;
+        getPosition(index, x, o);
+        if(mark == FINISHED)
+        {
+            //The game ended with the last move: a win for its mover, or a draw on a full board
+            scores[index] = static_cast<signed char>(hasLine(stones % 2 == 1 ? x : o) ? -(winScore - stones) : 0);
+            continue;
+        }
+        
+        bool xToMove = stones % 2 == 0;
+        int best = -winScore - 1;
+        for(uint32_t rest = board & ~(x | o); rest; rest &= rest - 1)
+        {
+            uint32_t cell = rest & (0u - rest);
+            best = max(best, -static_cast<int>(scores[xToMove ? getIndex(x | cell, o) : getIndex(x, o | cell)]));
+        }
+        scores[index] = static_cast<signed char>(best);
+    }
+}
+
+/*
+ *Description: Runs the supplied layer function over the supplied layer, split among the supplied number of threads
+ *Precondition: threads >= 1
+ *Postcondition: Every position of the layer has been processed
+ */
+void RetrogradeSolver::runLayer(void (RetrogradeSolver::*function)(int, long, long), int stones, int threads)
+{
+    //Small layers are not worth a thread
+    const long MIN_CHUNK = 4096;
+    long begin = layerOffsets[stones];
+    long size = getLayerSize(stones);
+    long chunks = max(1L, min(static_cast<long>(threads), size / MIN_CHUNK));
+    
+    vector<thread> workers;
+    for(long chunk = 1; chunk < chunks; chunk++)
+        workers.push_back(thread(function, this, stones, begin + size * chunk / chunks, begin + size * (chunk + 1) / chunks));
+    (this->*function)(stones, begin, begin + size / chunks);
+    for(size_t i = 0; i < workers.size(); i++)
+        workers[i].join();
+}
+
+/*
+ *Description: Sets the 'X' and 'O' cell masks of the position with the supplied index
+ *Precondition: 0 <= index < getPositionCount()
+ *Postcondition: The masks are set
+ */
+void RetrogradeSolver::getPosition(long index, uint32_t& x, uint32_t& o) const
+{
+    int stones = 0;
+    while(layerOffsets[stones + 1] <= index)
+        stones++;
+    long xSubsets = binomial[stones][(stones + 1) / 2];
+    long occupiedRank = (index - layerOffsets[stones]) / xSubsets;
+    long xRank = (index - layerOffsets[stones]) % xSubsets;
+    
+    //Undo the combinatorial number system from the highest element down: the k-th element is the
+    //largest c with C(c, k) <= rank
+    int occupied[MAX_CELLS];
+    int cell = cellCount;
+    for(int k = stones; k >= 1; k--)
+    {
+        do
+            cell--;
+        while(binomial[cell][k] > occupiedRank);
+        occupiedRank -= binomial[cell][k];
+        occupied[k - 1] = cell;
+    }
+    
+    x = 0;
+    int position = stones;
+    for(int k = (stones + 1) / 2; k >= 1; k--)
+    {
+        do
+            position--;
+        while(binomial[position][k] > xRank);
+        xRank -= binomial[position][k];
+        x |= 1u << occupied[position];
+    }
+    
+    o = 0;
+    for(int i = 0; i < stones; i++)
+        o |= 1u << occupied[i];
+    o &= ~x;
+}
+
+/*
+ *Description: Counts the entries of the table that are not UNREACHABLE
+ *Precondition: The table is solved
+ *Postcondition: 'reachableCount' is set
+ */
+void RetrogradeSolver::countReachable()
+{
+    reachableCount = 0;
+    for(size_t index = 0; index < scores.size(); index++)
+        if(scores[index] != UNREACHABLE)
+            reachableCount++;
+}
+
+/*
+ *Description: Returns true if the supplied cell mask holds a complete winning line
+ *Precondition: N/A
+ *Postcondition: A boolean value is returned
+ */
+bool RetrogradeSolver::hasLine(uint32_t mask) const
+{
+    for(size_t line = 0; line < lines.size(); line++)
+        if((mask & lines[line]) == lines[line])
+            return true;
+    return false;
+}
@@ -0,0 +1,212 @@
+/************************************************************************************
+ Title:         RetrogradeSolver.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   A retrograde-analysis solver that computes the perfect-play score of
+                every reachable position of a small board(up to 16 cells, such as 3x3
+                and 4x4). Positions are numbered by a perfect index over ply layers: a
+                position with p stones has (p + 1) / 2 of 'X' and p / 2 of 'O', and its
+                index is the offset of layer p plus
+                  rank(occupied cells) * C(p, (p + 1) / 2) + rank('X' among the occupied)
+                where a rank is the position of a set in the combinatorial number system.
+                Every index is a possible stone placement and every placement has exactly
+                one index, so the table is dense: 6046 bytes for 3x3, 10165779 for 4x4.
+                The solver first marks the reachable positions layer by layer from the
+                empty board, then scores them layer by layer from the full board back,
+                every position's successors being already scored. Each layer is split
+                among threads, which only read the neighbouring layer and only write
+                their own part of the current one.
+                A table file is:
+                  header   16 bytes: "TTTV", format version(2 bytes), width, height,
+                           win length, layers(0 for a flat board), position count(4
+                           bytes), 2 reserved bytes
+                  scores   one signed byte per position index
+                All numbers are little-endian.
+ 
+ Purpose:       Provides complete game-value tables computed in bulk: an oracle that
+                other engines can be checked against, and instant answers on boards
+                too large for a compile-time table like SolvedTable.
+ 
+ Usage:         RetrogradeSolver solver(BoardGeometry::get(4, 4, 4));
+                solver.solve(threads); //or solver.open(path, error)
+                solver.getScore(board); solver.chooseMove(board);
+                solver.save(path, error);
+                Scores are from the point of view of the side to move, as in
+                NegamaxSearch: 0 is a draw, and a win scores getWinScore() minus the
+                stones on the board after the winning move(a loss the negative of that).
+                Positions that can not occur in a game score UNREACHABLE. The game rules
+                are those of GameBoard::updateGameStatus: a line of the win length ends
+                the game, and so does a full board.
+ 
+ Build with:    Compile with main.cpp. Requires a thread library(-pthread).
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#ifndef TicTacToe_RetrogradeSolver_h
+#define TicTacToe_RetrogradeSolver_h
+
+#include "BoardGeometry.h"
+#include "GameBoard.h"
+#include "Location.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+class RetrogradeSolver {
+
+public:
+    RetrogradeSolver(const BoardGeometry&);
+    /*
+     *Description: Constructor of an unsolved table for boards of the supplied geometry
+     *Precondition: The BoardGeometry outlives the solver
+     *Error Checking: Throws invalid_argument if the board has more than MAX_CELLS cells
+     *Postcondition: The layer offsets are computed; no table is allocated until solve or open
+     */
+    
+    void solve(int);
+    /*
+     *Description: Scores every position on the supplied number of threads(0 selects one per hardware thread)
+     *Precondition: N/A
+     *Postcondition: Every entry of the table holds its position's score or UNREACHABLE
+     */
+    
+    bool save(const string&, string&) const;
+    /*
+     *Description: Writes the table to the file at the supplied path(see the format above)
+     *Precondition: The table is solved
+     *Postcondition: Returns true on success; otherwise the string holds the reason
+     */
+    
+    bool open(const string&, string&);
+    /*
+     *Description: Reads a table written by save for the same board
+     *Precondition: N/A
+     *Error Checking: The file must have a valid header of a supported version, this solver's board size,
+     *                and exactly the number of positions of that board.
+     *Postcondition: Returns true and replaces the table on success; otherwise the string holds the reason
+     */
+    
+    bool isSolved() const;
+    /*
+     *Description: Returns true once solve or open has filled the table
+     *Precondition: N/A
+     *Postcondition: A boolean value is returned
+     */
+    
+    long getIndex(uint32_t, uint32_t) const;
+    /*
+     *Description: Returns the index of the position with the supplied 'X' and 'O' cell masks
+     *Precondition: The masks do not overlap, use only cells of the board, and 'X' has as many stones as
+     *              'O' or one more
+     *Postcondition: An integer between 0 and getPositionCount() - 1 is returned
+     */
+    
+    int getScore(uint32_t, uint32_t) const;
+    int getScore(const GameBoard&) const;
+    /*
+     *Description: Returns the score of the supplied position(as 'X' and 'O' cell masks, or a board of this
+     *             solver's geometry) for the side to move
+     *Precondition: The table is solved; the stone counts are those of a game('X' moves first)
+     *Postcondition: The score, or UNREACHABLE, is returned
+     */
+    
+    Location chooseMove(const GameBoard&) const;
+    /*
+     *Description: Returns a best move for the side to move on a board of this solver's geometry
+     *Precondition: The table is solved; the game is not over
+     *Postcondition: The lowest-numbered vacant cell whose move achieves the position's score is returned
+     */
+    
+    long getPositionCount() const;
+    long getLayerSize(int) const;
+    long getReachableCount() const;
+    /*
+     *Description: Accessor functions for the number of entries of the table, the number of positions with
+     *             the supplied number of stones, and the number of positions that can occur in a game
+     *Precondition: N/A
+     *Postcondition: The requested count is returned; the reachable count is 0 until the table is solved
+     */
+    
+    int getWinScore() const;
+    /*
+     *Description: Returns the score of a win on an empty board: the number of cells plus one
+     *Precondition: N/A
+     *Postcondition: A positive integer is returned
+     */
+    
+    const BoardGeometry& getGeometry() const;
+    /*
+     *Description: Accessor function that returns the board the table is for
+     *Precondition: N/A
+     *Postcondition: The BoardGeometry is returned
+     */
+    
+    static const int MAX_CELLS = 16; //Largest board solved; 20 cells would need 741 million entries
+    static const signed char UNREACHABLE = -128; //Score of positions that can not occur in a game
+    static const char MAGIC[4]; //First bytes of a table file
+    static const int FORMAT_VERSION = 1; //Version of the table file format
+    static const size_t HEADER_SIZE = 16; //Bytes before the first score
+
+private:
+    void markLayer(int, long, long);
+    /*
+     *Description: Marks the positions of the supplied layer between the supplied indices as open,
+     *             finished or UNREACHABLE, from the marks of the layer before
+     *Precondition: The layer before is marked
+     *Postcondition: The entries hold OPEN, FINISHED or UNREACHABLE
+     */
+    
+    void scoreLayer(int, long, long);
+    /*
+     *Description: Replaces the marks of the positions of the supplied layer between the supplied indices
+     *             by their scores, from the scores of the layer after
+     *Precondition: The layer is marked and the layer after is scored
+     *Postcondition: The entries hold scores or UNREACHABLE
+     */
+    
+    void runLayer(void (RetrogradeSolver::*)(int, long, long), int, int);
+    /*
+     *Description: Runs the supplied layer function over the supplied layer, split among the supplied
+     *             number of threads
+     *Precondition: threads >= 1
+     *Postcondition: Every position of the layer has been processed
+     */
+    
+    void getPosition(long, uint32_t&, uint32_t&) const;
+    /*
+     *Description: Sets the 'X' and 'O' cell masks of the position with the supplied index
+     *Precondition: 0 <= index < getPositionCount()
+     *Postcondition: The masks are set
+     */
+    
+    void countReachable();
+    /*
+     *Description: Counts the entries of the table that are not UNREACHABLE
+     *Precondition: The table is solved
+     *Postcondition: 'reachableCount' is set
+     */
+    
+    bool hasLine(uint32_t) const;
+    /*
+     *Description: Returns true if the supplied cell mask holds a complete winning line
+     *Precondition: N/A
+     *Postcondition: A boolean value is returned
+     */
+    
+    static const signed char OPEN = 1; //Mark of a reachable position whose game goes on
+    static const signed char FINISHED = 2; //Mark of a reachable position whose game is over
+    
+    const BoardGeometry& geometry; //Board the table is for
+    int cellCount; //Cells of the board
+    vector<uint32_t> lines; //Cell mask of each winning line
+    long binomial[MAX_CELLS + 1][MAX_CELLS + 1]; //binomial[n][k] is C(n, k)
+    long layerOffsets[MAX_CELLS + 2]; //Index of the first position of each layer; one extra entry at the end
+    vector<signed char> scores; //Score of each position, or a mark while solving; empty until solved
+    long reachableCount; //Positions that can occur in a game
+};
+#endif
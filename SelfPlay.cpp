@@ -0,0 +1,295 @@
+/************************************************************************************
+ Title:         SelfPlay.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of SelfPlay.h. Plays many games of an engine against
+                another engine or against a random mover, spread across worker threads.
+ 
+ Purpose:       Provides reproducible win/draw/loss counts and throughput.
+ 
+ Usage:         SelfPlay selfPlay(geometry); selfPlay.run(games, seed, threads);
+ 
+ Build with:    Compile with selfplay.cpp. Requires a thread library(-pthread).
+ 
+ Modifications: Added the Monte Carlo search budget.
+                Games can be logged to a record file.
+                The engine can play from an OpeningBook.
+                Added the search depth of ALPHA_BETA engines.
+                Added the move time of the anytime mode.
+                The search threads also apply to ALPHA_BETA engines.
+                Added the engine's decision statistics.
+                Added the engine's n-tuple network.
+                Both Computers start every game with newGame, so results do not depend on which
+                worker played which games.
+ ***********************************************************************************/
+
+#include "SelfPlay.h"
+#include <chrono>
+#include <thread>
+#include <vector>
+using namespace std;
+
+//Number of consecutive games a worker claims at a time
+static const long GAMES_PER_CLAIM = 64;
+
+/*
+ *Description: Constructor that plays games on boards of the supplied geometry, HEURISTIC engine
+ *             against a random mover by default
+ *Precondition: The BoardGeometry outlives the SelfPlay
+ *Postcondition: The SelfPlay is ready to run
+ */
+SelfPlay::SelfPlay(const BoardGeometry& boardGeometry)
+    : geometry(boardGeometry), engineStrategy(Computer::HEURISTIC), opponentStrategy(Computer::HEURISTIC),
+      randomOpponent(true), searchPlayouts(MonteCarloSearch::DEFAULT_PLAYOUTS), searchTimeLimit(0),
+      searchThreads(1), searchMode(MonteCarloSearch::TREE),
+      searchDepth(AlphaBetaSearch::DEFAULT_DEPTH), moveTime(0), recorder(0), openingBook(0), network(0), stats(0), nextGame(0)
+{
+}
+
+/*
+ *Description: Selects the Strategy of the engine whose results are reported
+ *Precondition: N/A
+ *Postcondition: The engine's Strategy is updated
+ */
+void SelfPlay::setEngine(Computer::Strategy strategy)
+{
+    engineStrategy = strategy;
+}
+
+/*
+ *Description: Makes the opponent an engine with the supplied Strategy
+ *Precondition: N/A
+ *Postcondition: The opponent's Strategy is updated
+ */
+void SelfPlay::setOpponent(Computer::Strategy strategy)
+{
+    opponentStrategy = strategy;
+    randomOpponent = false;
+}
+
+/*
+ *Description: Makes the opponent play uniformly random legal moves
+ *Precondition: N/A
+ *Postcondition: The opponent is a random mover
+ */
+void SelfPlay::setRandomOpponent()
+{
+    randomOpponent = true;
+}
+
+/*
+ *Description: Sets the playouts, milliseconds, search threads and mode of every MONTE_CARLO engine;
+ *             the search threads also apply to ALPHA_BETA engines
+ *Precondition: The numbers are non-negative
+ *Postcondition: Both engines use the budget from the next run
+ */
+void SelfPlay::setSearchBudget(long playouts, double milliseconds, int threads, MonteCarloSearch::Mode mode)
+{
+    searchPlayouts = playouts;
+    searchTimeLimit = milliseconds;
+    searchThreads = threads;
+    searchMode = mode;
+}
+
+/*
+ *Description: Sets the depth of every ALPHA_BETA engine
+ *Precondition: N/A
+ *Postcondition: Both engines search to the depth from the next run
+ */
+void SelfPlay::setSearchDepth(int depth)
+{
+    searchDepth = depth;
+}
+
+/*
+ *Description: Makes both engines answer every move within the supplied number of milliseconds
+ *Precondition: The time is non-negative
+ *Postcondition: Both engines use the move time from the next run
+ */
+void SelfPlay::setMoveTime(double milliseconds)
+{
+    moveTime = milliseconds;
+}
+
+/*
+ *Description: Lets the engine play from the supplied book, or from none if it is null
+ *Precondition: The book outlives the runs that use it
+ *Postcondition: Later runs consult the book
+ */
+void SelfPlay::setOpeningBook(const OpeningBook* book)
+{
+    openingBook = book;
+}
+
+/*
+ *Description: Lets an ALPHA_BETA engine evaluate with the supplied network, or with the line weights if it is null
+ *Precondition: The network outlives the runs that use it
+ *Postcondition: Later runs evaluate with the network
+ */
+void SelfPlay::setNetwork(const NTupleNetwork* engineNetwork)
+{
+    network = engineNetwork;
+}
+
+/*
+ *Description: Makes the engine record its decisions in the supplied statistics, or stops recording if they are null
+ *Precondition: The statistics outlive the runs that use them
+ *Postcondition: Later runs record the engine's decisions
+ */
+void SelfPlay::setStats(EngineStats* engineStats)
+{
+    stats = engineStats;
+}
+
+/*
+ *Description: Logs every game played to the supplied open writer, or stops logging if it is null
+ *Precondition: The writer outlives the runs that use it and was opened for this geometry
+ *Postcondition: Later runs write their games in the order they finish
+ */
+void SelfPlay::setRecorder(GameRecordWriter* writer)
+{
+    recorder = writer;
+}
+
+/*
+ *Description: Plays the supplied number of games from the supplied seed on the supplied number of
+ *             threads(0 selects one per hardware thread)
+ *Precondition: The number of games is non-negative
+ *Postcondition: The engine's wins, draws, losses and the wall time are returned
+ */
+SelfPlayResult SelfPlay::run(long games, uint64_t seed, int threads)
+{
+    if(threads <= 0)
+        threads = max(1u, thread::hardware_concurrency());
+    
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    
+    //Each worker keeps its own counts; sums do not depend on which worker played which game
+    nextGame.store(0);
+    vector<SelfPlayResult> partial(threads);
+    vector<thread> workers;
+    for(int i = 1; i < threads; i++)
+        workers.push_back(thread(&SelfPlay::playGames, this, games, seed, ref(partial[i])));
+    playGames(games, seed, partial[0]);
+    for(size_t i = 0; i < workers.size(); i++)
+        workers[i].join();
+    
+    SelfPlayResult result;
+    for(int i = 0; i < threads; i++)
+    {
+        result.wins += partial[i].wins;
+        result.draws += partial[i].draws;
+        result.losses += partial[i].losses;
+    }
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+/*
+ *Description: Worker loop: claims blocks of game indices until the run is complete
+ *Precondition: N/A
+ *Postcondition: The worker's wins, draws and losses are added to the supplied result
+ */
+void SelfPlay::playGames(long games, uint64_t seed, SelfPlayResult& result)
+{
+    Computer engine;
+    Computer opponent;
+    Random mover;
+    GameRecord record;
+    engine.setStrategy(engineStrategy);
+    engine.setOpeningBook(openingBook);
+    engine.setNetwork(network);
+    engine.setStats(stats);
+    opponent.setStrategy(opponentStrategy);
+    
+    Computer* players[] = { &engine, &opponent };
+    for(int i = 0; i < 2; i++)
+    {
+        MonteCarloSearch& search = players[i]->getMonteCarloSearch();
+        search.setPlayouts(searchPlayouts);
+        search.setTimeLimit(searchTimeLimit);
+        search.setThreads(searchThreads);
+        search.setMode(searchMode);
+        players[i]->getAlphaBetaSearch().setDepth(searchDepth);
+        players[i]->getAlphaBetaSearch().setThreads(searchThreads);
+        players[i]->setMoveTime(moveTime);
+    }
+    
+    for(;;)
+    {
+        long first = nextGame.fetch_add(GAMES_PER_CLAIM, memory_order_relaxed);
+        if(first >= games)
+            return;
+        
+        long last = min(games, first + GAMES_PER_CLAIM);
+        for(long index = first; index < last; index++)
+        {
+            int outcome = playGame(index, seed, engine, opponent, mover, record);
+            if(recorder)
+                recorder->write(record);
+            if(outcome > 0)
+                result.wins++;
+            else if(outcome < 0)
+                result.losses++;
+            else
+                result.draws++;
+        }
+    }
+}
+
+/*
+ *Description: Plays game number 'index' of a run with the supplied seed, using the supplied engine,
+ *             opponent and random mover. Their random streams are reseeded from the seed and index.
+ *Precondition: N/A
+ *Postcondition: Returns 1 if the engine won, 0 for a draw and -1 if the opponent won; the record
+ *               holds the game's moves and result
+ */
+int SelfPlay::playGame(long index, uint64_t seed, Computer& engine, Computer& opponent, Random& mover,
+                       GameRecord& record) const
+{
+    //The Computers are reused game after game, so they forget the previous games' searches
+    uint64_t gameSeed = Random::derive(seed, index);
+    engine.newGame();
+    opponent.newGame();
+    engine.setSeed(Random::derive(gameSeed, 0));
+    opponent.setSeed(Random::derive(gameSeed, 1));
+    mover.setSeed(Random::derive(gameSeed, 2));
+    
+    //The engine plays 'X' in even games; 'X' always moves first
+    string engineID = (index % 2 == 0) ? "X" : "O";
+    string opponentID = GameBoard::getOtherID(engineID);
+    int engineSide = GameBoard::getSide(engineID);
+    
+    GameBoard board(geometry);
+    board.setPlayerID(opponentID);
+    record.clear();
+    
+    int toMove = 0;
+    while(!board.getGameStatus())
+    {
+        Location move;
+        if(toMove == engineSide)
+            move = engine.chooseNextMove(board, engineID);
+        else if(randomOpponent)
+        {
+            CellMask empty = board.getEmptyMask();
+            move = geometry.getLocation(empty.nth(mover.nextInt(empty.count())));
+        }
+        else
+            move = opponent.chooseNextMove(board, opponentID);
+        
+        board.makeMove(move, toMove);
+        record.addMove(geometry.getCell(move.x, move.y));
+        toMove ^= 1;
+    }
+    record.setResult(board);
+    
+    if(board.hasComputerWon())
+        return 1;
+    if(board.hasPlayerWon())
+        return -1;
+    return 0;
+}
@@ -0,0 +1,187 @@
+/************************************************************************************
+ Title:         SelfPlay.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   Plays many games of an engine against another engine or against a
+                random mover, spread across worker threads.
+ 
+ Purpose:       Provides the win/draw/loss counts and throughput needed to validate engine
+                changes. Every game draws its random numbers from streams derived from the
+                run's seed and the game's index, so a run is reproducible from its seed no
+                matter how many threads play it.
+ 
+ Usage:         SelfPlay selfPlay(BoardGeometry::classic());
+                selfPlay.setEngine(Computer::NEGAMAX); selfPlay.setRandomOpponent();
+                SelfPlayResult result = selfPlay.run(games, seed, threads);
+                The engine plays 'X'(and moves first) in even-numbered games and 'O' in odd ones.
+ 
+ Build with:    Compile with selfplay.cpp. Requires a thread library(-pthread).
+ 
+ Modifications: Added the Monte Carlo search budget.
+                Games can be logged to a record file(see GameRecordWriter.h).
+                The engine can play from an OpeningBook.
+                Added the search depth of ALPHA_BETA engines.
+                Added the move time of the anytime mode.
+                The search threads also apply to ALPHA_BETA engines.
+                The engine's decisions can be recorded in an EngineStats.
+                The engine can evaluate with an NTupleNetwork.
+ ***********************************************************************************/
+
+#ifndef TicTacToe_SelfPlay_h
+#define TicTacToe_SelfPlay_h
+
+#include "BoardGeometry.h"
+#include "Computer.h"
+#include "EngineStats.h"
+#include "GameBoard.h"
+#include "GameRecord.h"
+#include "GameRecordWriter.h"
+#include "NTupleNetwork.h"
+#include "OpeningBook.h"
+#include "Random.h"
+#include <atomic>
+#include <cstdint>
+using namespace std;
+
+struct SelfPlayResult {
+    long wins; //Games won by the engine
+    long draws; //Games drawn
+    long losses; //Games won by the opponent
+    double seconds; //Wall time of the run
+    
+    SelfPlayResult() : wins(0), draws(0), losses(0), seconds(0) {}
+    
+    long getGames() const { return wins + draws + losses; }
+    double getGamesPerSecond() const { return seconds > 0 ? getGames() / seconds : 0; }
+};
+
+class SelfPlay {
+
+public:
+    SelfPlay(const BoardGeometry&);
+    /*
+     *Description: Constructor that plays games on boards of the supplied geometry, HEURISTIC engine
+     *             against a random mover by default
+     *Precondition: The BoardGeometry outlives the SelfPlay
+     *Postcondition: The SelfPlay is ready to run
+     */
+    
+    void setEngine(Computer::Strategy);
+    /*
+     *Description: Selects the Strategy of the engine whose results are reported
+     *Precondition: N/A
+     *Postcondition: The engine's Strategy is updated
+     */
+    
+    void setOpponent(Computer::Strategy);
+    /*
+     *Description: Makes the opponent an engine with the supplied Strategy
+     *Precondition: N/A
+     *Postcondition: The opponent's Strategy is updated
+     */
+    
+    void setRandomOpponent();
+    /*
+     *Description: Makes the opponent play uniformly random legal moves
+     *Precondition: N/A
+     *Postcondition: The opponent is a random mover
+     */
+    
+    void setSearchBudget(long, double, int, MonteCarloSearch::Mode);
+    /*
+     *Description: Sets the playouts, milliseconds, search threads and mode of every MONTE_CARLO
+     *             engine(see MonteCarloSearch.h); the search threads also apply to ALPHA_BETA engines
+     *Precondition: The numbers are non-negative
+     *Postcondition: Both engines use the budget from the next run
+     */
+    
+    void setSearchDepth(int);
+    /*
+     *Description: Sets the depth of every ALPHA_BETA engine(see AlphaBetaSearch.h)
+     *Precondition: N/A
+     *Postcondition: Both engines search to the depth from the next run
+     */
+    
+    void setMoveTime(double);
+    /*
+     *Description: Makes both engines answer every move within the supplied number of milliseconds using the
+     *             anytime mode(see Computer::setMoveTime); 0 turns it off
+     *Precondition: The time is non-negative
+     *Postcondition: Both engines use the move time from the next run
+     */
+    
+    void setOpeningBook(const OpeningBook*);
+    /*
+     *Description: Lets the engine(not the opponent) play from the supplied book, or from none if it is null
+     *Precondition: The book outlives the runs that use it
+     *Postcondition: Later runs consult the book
+     */
+    
+    void setNetwork(const NTupleNetwork*);
+    /*
+     *Description: Lets an ALPHA_BETA engine(not the opponent) evaluate with the supplied network, or with the
+     *             line weights if it is null
+     *Precondition: The network outlives the runs that use it
+     *Postcondition: Later runs evaluate with the network
+     */
+    
+    void setStats(EngineStats*);
+    /*
+     *Description: Makes the engine(not the opponent) record its decisions in the supplied statistics, or stops
+     *             recording if they are null
+     *Precondition: The statistics outlive the runs that use them
+     *Postcondition: Later runs record the engine's decisions
+     */
+    
+    void setRecorder(GameRecordWriter*);
+    /*
+     *Description: Logs every game played to the supplied open writer, or stops logging if it is null
+     *Precondition: The writer outlives the runs that use it and was opened for this geometry
+     *Postcondition: Later runs write their games in the order they finish
+     */
+    
+    SelfPlayResult run(long, uint64_t, int);
+    /*
+     *Description: Plays the supplied number of games from the supplied seed on the supplied number of
+     *             threads(0 selects one per hardware thread)
+     *Precondition: The number of games is non-negative
+     *Postcondition: The engine's wins, draws, losses and the wall time are returned
+     */
+    
+    int playGame(long, uint64_t, Computer&, Computer&, Random&, GameRecord&) const;
+    /*
+     *Description: Plays game number 'index' of a run with the supplied seed, using the supplied engine,
+     *             opponent and random mover. Their random streams are reseeded from the seed and index.
+     *Precondition: N/A
+     *Postcondition: Returns 1 if the engine won, 0 for a draw and -1 if the opponent won; the record
+     *               holds the game's moves and result
+     */
+
+private:
+    void playGames(long, uint64_t, SelfPlayResult&);
+    /*
+     *Description: Worker loop: claims blocks of game indices until the run is complete
+     *Precondition: N/A
+     *Postcondition: The worker's wins, draws and losses are added to the supplied result
+     */
+    
+    const BoardGeometry& geometry; //Board the games are played on
+    Computer::Strategy engineStrategy; //Strategy of the engine
+    Computer::Strategy opponentStrategy; //Strategy of the opponent when it is an engine
+    bool randomOpponent; //Whether the opponent plays random moves
+    long searchPlayouts; //Playouts per move of MONTE_CARLO engines
+    double searchTimeLimit; //Milliseconds per move of MONTE_CARLO engines
+    int searchThreads; //Threads per move of MONTE_CARLO and ALPHA_BETA engines
+    MonteCarloSearch::Mode searchMode; //How those threads share the work
+    int searchDepth; //Depth of ALPHA_BETA engines
+    double moveTime; //Milliseconds per move of the anytime mode, or 0
+    GameRecordWriter* recorder; //Where games are logged, or 0
+    const OpeningBook* openingBook; //Book of the engine, or 0
+    const NTupleNetwork* network; //Evaluation of the engine, or 0
+    EngineStats* stats; //Where the engine records its decisions, or 0
+    atomic<long> nextGame; //Next unclaimed game index
+};
+#endif
@@ -0,0 +1,133 @@
+/************************************************************************************
+ Title:         SharedTranspositionTable.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of SharedTranspositionTable.h. A key's slot is chosen by
+                its low bits. The data word holds the score in bits 0-15, the depth in
+                bits 16-23, the bound in bits 24-31, the best move in bits 32-47 and the
+                generation in bits 48-63; an empty slot is all zero, whose bound is NONE.
+                An entry of another generation reads as empty.
+ 
+ Purpose:       Lets the threads of a parallel search share their results without locks.
+ 
+ Usage:         table.allocate(); table.probe(key, entry); table.store(key, score, depth, bound, cell);
+ 
+ Build with:    Compile with main.cpp.
+ 
+ Modifications: clear starts a new generation instead of freeing the slots; the slots are
+                only zeroed when the generation wraps around.
+ ***********************************************************************************/
+
+#include "SharedTranspositionTable.h"
+using namespace std;
+
+/*
+ *Description: Constructor that sizes the table to 2 to the power of the supplied number of slots
+ *Precondition: 0 <= bits <= 30
+ *Postcondition: The table is empty; no memory is allocated until allocate is called
+ */
+SharedTranspositionTable::SharedTranspositionTable(int bits) : indexMask((size_t(1) << bits) - 1), generation(0)
+{
+}
+
+/*
+ *Description: Allocates the slots unless they already are
+ *Precondition: No other thread is using the table
+ *Postcondition: Stores are kept
+ */
+void SharedTranspositionTable::allocate()
+{
+    if(!slots)
+        slots.reset(new Slot[indexMask + 1]);
+}
+
+/*
+ *Description: Looks up the supplied key
+ *Precondition: N/A
+ *Postcondition: Returns true and copies the stored entry if the key is present and whole; otherwise
+ *               returns false
+ */
+bool SharedTranspositionTable::probe(uint64_t key, TranspositionEntry& entry) const
+{
+    if(!slots)
+        return false;
+    
+    //Relaxed loads suffice: a torn pair fails the check like any other key
+    const Slot& slot = slots[key & indexMask];
+    uint64_t data = slot.data.load(memory_order_relaxed);
+    uint64_t check = slot.check.load(memory_order_relaxed);
+    if((check ^ data) != key)
+        return false;
+    
+    entry.bound = static_cast<unsigned char>(data >> 24);
+    if(entry.bound == TranspositionTable::NONE || (data >> 48) != generation)
+        return false;
+    entry.key = key;
+    entry.score = static_cast<short>(data & 0xFFFF);
+    entry.depth = static_cast<signed char>((data >> 16) & 0xFF);
+    entry.bestCell = static_cast<short>((data >> 32) & 0xFFFF);
+    return true;
+}
+
+/*
+ *Description: Stores the score, search depth, bound and best move of the supplied key
+ *Precondition: The score and depth fit in the entry fields
+ *Postcondition: The entry is stored unless a deeper result of the same key is kept
+ */
+void SharedTranspositionTable::store(uint64_t key, int score, int depth, TranspositionTable::Bound bound,
+                                     int bestCell)
+{
+    if(!slots)
+        return;
+    
+    Slot& slot = slots[key & indexMask];
+    uint64_t old = slot.data.load(memory_order_relaxed);
+    if((slot.check.load(memory_order_relaxed) ^ old) == key && static_cast<signed char>((old >> 16) & 0xFF) > depth
+       && static_cast<unsigned char>(old >> 24) != TranspositionTable::NONE && (old >> 48) == generation)
+        return;
+    
+    uint64_t data = pack(score, depth, bound, bestCell);
+    slot.check.store(key ^ data, memory_order_relaxed);
+    slot.data.store(data, memory_order_relaxed);
+}
+
+/*
+ *Description: Removes every entry; the slots stay allocated
+ *Precondition: No other thread is using the table
+ *Postcondition: Every probe fails until a store is made
+ */
+void SharedTranspositionTable::clear()
+{
+    //Once the generation wraps around, entries of 65536 clears ago would match again
+    if(++generation == 0 && slots)
+        for(size_t i = 0; i <= indexMask; i++)
+        {
+            slots[i].check.store(0, memory_order_relaxed);
+            slots[i].data.store(0, memory_order_relaxed);
+        }
+}
+
+/*
+ *Description: Accessor function that returns the number of slots
+ *Precondition: N/A
+ *Postcondition: A power of two is returned
+ */
+size_t SharedTranspositionTable::getSize() const
+{
+    return indexMask + 1;
+}
+
+/*
+ *Description: Packs a score, depth, bound and best move of the current generation into one word
+ *Precondition: The values fit in the entry fields
+ *Postcondition: The word is returned
+ */
+uint64_t SharedTranspositionTable::pack(int score, int depth, TranspositionTable::Bound bound, int bestCell) const
+{
+    return uint64_t(static_cast<uint16_t>(score)) | uint64_t(static_cast<uint8_t>(depth)) << 16
+           | uint64_t(static_cast<uint8_t>(bound)) << 24 | uint64_t(static_cast<uint16_t>(bestCell)) << 32
+           | uint64_t(generation) << 48;
+}
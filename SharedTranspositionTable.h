@@ -0,0 +1,105 @@
+/************************************************************************************
+ Title:         SharedTranspositionTable.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   A transposition table that several threads read and write at once without
+                locks. Each slot is two 64-bit words: the entry packed into one word and
+                the key XORed with it in the other. The words are read and written
+                separately, so a reader may see halves of two different stores; the
+                XOR then no longer gives back its key and the slot reads as empty.
+ 
+ Purpose:       Lets the threads of a parallel search share what each of them has found
+                without ever waiting for one another.
+ 
+ Usage:         SharedTranspositionTable table(18); //262144 slots
+                table.allocate(); //before the threads start
+                TranspositionEntry entry;
+                if(table.probe(key, entry)) ... ; table.store(key, score, depth, bound, cell);
+ 
+ Build with:    Compile with main.cpp.
+ 
+ Modifications: clear keeps the slots allocated and ends every entry by moving to a new
+                generation instead of freeing the table.
+ ***********************************************************************************/
+
+#ifndef TicTacToe_SharedTranspositionTable_h
+#define TicTacToe_SharedTranspositionTable_h
+
+#include "TranspositionTable.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+using namespace std;
+
+class SharedTranspositionTable {
+
+public:
+    explicit SharedTranspositionTable(int);
+    /*
+     *Description: Constructor that sizes the table to 2 to the power of the supplied number of slots
+     *Precondition: 0 <= bits <= 30
+     *Postcondition: The table is empty; no memory is allocated until allocate is called
+     */
+    
+    void allocate();
+    /*
+     *Description: Allocates the slots unless they already are
+     *Precondition: No other thread is using the table
+     *Postcondition: Stores are kept
+     */
+    
+    bool probe(uint64_t, TranspositionEntry&) const;
+    /*
+     *Description: Looks up the supplied key. Safe to call while other threads store.
+     *Precondition: N/A
+     *Postcondition: Returns true and copies the stored entry if the key is present and its slot was not
+     *               being written at the same time; otherwise returns false
+     */
+    
+    void store(uint64_t, int, int, TranspositionTable::Bound, int);
+    /*
+     *Description: Stores the score, search depth, bound and best move of the supplied key, with the same
+     *             replacement rule as TranspositionTable. Safe to call while other threads probe and store.
+     *Precondition: The score and depth fit in the entry fields
+     *Postcondition: The entry is stored unless a deeper result of the same key is kept; nothing is
+     *               stored before allocate is called
+     */
+    
+    void clear();
+    /*
+     *Description: Removes every entry. The slots stay allocated, and the entries are only ended by
+     *             starting a new generation, so a search can clear the table before every game.
+     *Precondition: No other thread is using the table
+     *Postcondition: Every probe fails until a store is made
+     */
+    
+    size_t getSize() const;
+    /*
+     *Description: Accessor function that returns the number of slots
+     *Precondition: N/A
+     *Postcondition: A power of two is returned
+     */
+
+private:
+    struct Slot {
+        atomic<uint64_t> check; //Key XOR data
+        atomic<uint64_t> data; //Score, depth, bound, best move and generation packed by pack()
+        
+        Slot() : check(0), data(0) {}
+    };
+    
+    uint64_t pack(int, int, TranspositionTable::Bound, int) const;
+    /*
+     *Description: Packs a score, depth, bound and best move of the current generation into one word
+     *Precondition: The values fit in the entry fields
+     *Postcondition: The word is returned; it is never 0 unless the bound is NONE
+     */
+    
+    size_t indexMask; //Number of slots minus one
+    uint16_t generation; //Entries stored before the last clear carry an older generation
+    unique_ptr<Slot[]> slots; //The slots; null until allocate is called
+};
+#endif
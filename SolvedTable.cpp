@@ -0,0 +1,167 @@
+/************************************************************************************
+ Title:         SolvedTable.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of SolvedTable.h. The table is built by a constexpr
+                backward induction: positions are solved from 9 stones down to 0 so
+                that every position's successors are already solved.
+ 
+ Purpose:       Provides O(1) perfect play with no search and no startup cost.
+ 
+ Usage:         SolvedTable::chooseMove(ownMask, opponentMask);
+ 
+ Build with:    Compile with main.cpp. Requires C++17.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#include "SolvedTable.h"
+#include "GameBoard.h"
+#include "NegamaxSearch.h"
+using namespace std;
+
+namespace {
+
+//Ternary digits of every 9-bit mask: TERNARY[mask] is the sum of 3^cell over its set cells
+struct TernaryTable {
+    int digits[512];
+};
+
+struct PositionTable {
+    SolvedEntry entries[SolvedTable::POSITION_COUNT];
+};
+
+constexpr int countBits(unsigned mask)
+{
+    int count = 0;
+    for(; mask; mask &= mask - 1)
+        count++;
+    return count;
+}
+
+constexpr bool hasLine(unsigned mask)
+{
+    for(int i = 0; i < 8; i++)
+        if((mask & GameBoard::LINE_MASKS[i]) == GameBoard::LINE_MASKS[i])
+            return true;
+    return false;
+}
+
+constexpr TernaryTable buildTernaryTable()
+{
+    TernaryTable table = {};
+    for(unsigned mask = 0; mask < 512; mask++)
+    {
+        int power = 1;
+        for(int cell = 0; cell < 9; cell++, power *= 3)
+            if(mask & (1u << cell))
+                table.digits[mask] += power;
+    }
+    return table;
+}
+
+constexpr TernaryTable TERNARY = buildTernaryTable();
+
+/*
+ *Description: Solves every position by backward induction. A position is legal when the side to
+ *             move has not completed a line and has either as many stones as its opponent or one
+ *             fewer(whichever side moved first).
+ *Precondition: N/A
+ *Postcondition: A table with every legal position scored is returned
+ */
+constexpr PositionTable buildPositionTable()
+{
+    PositionTable table = {};
+    for(int i = 0; i < SolvedTable::POSITION_COUNT; i++)
+        table.entries[i].score = SolvedTable::ILLEGAL;
+    
+    for(int stones = 9; stones >= 0; stones--)
+        for(unsigned own = 0; own < 512; own++)
+        {
+            int ownCount = countBits(own);
+            int opponentCount = stones - ownCount;
+            if(hasLine(own) || (opponentCount != ownCount && opponentCount != ownCount + 1))
+                continue;
+            
+            //Visit every opponent mask with the required number of stones among the vacant cells
+            unsigned vacant = GameBoard::FULL_MASK & ~own;
+            for(unsigned opponent = vacant; ; opponent = (opponent - 1) & vacant)
+            {
+                if(countBits(opponent) == opponentCount)
+                {
+                    SolvedEntry& entry = table.entries[TERNARY.digits[own] + 2 * TERNARY.digits[opponent]];
+                    unsigned empty = vacant & ~opponent;
+                    
+                    if(hasLine(opponent))
+                        entry.score = -(NegamaxSearch::WIN_SCORE - stones);
+                    else if(empty == 0)
+                        entry.score = 0;
+                    else
+                    {
+                        int best = -NegamaxSearch::WIN_SCORE - 1;
+                        for(unsigned e = empty; e; e &= e - 1)
+                        {
+                            unsigned bit = e & (~e + 1);
+                            //After the move the opponent is the side to move
+                            int score = -table.entries[TERNARY.digits[opponent] + 2 * TERNARY.digits[own | bit]].score;
+                            if(score > best)
+                            {
+                                best = score;
+                                entry.bestMoves = 0;
+                            }
+                            if(score == best)
+                                entry.bestMoves |= bit;
+                        }
+                        entry.score = best;
+                    }
+                }
+                if(opponent == 0)
+                    break;
+            }
+        }
+    return table;
+}
+
+constexpr PositionTable SOLVED = buildPositionTable();
+
+}
+
+/*
+ *Description: Returns the table index of the position(see Usage in SolvedTable.h)
+ *Precondition: The masks do not overlap.
+ *Postcondition: An integer between 0 and POSITION_COUNT - 1 is returned
+ */
+int SolvedTable::getIndex(unsigned short own, unsigned short opponent)
+{
+    return TERNARY.digits[own] + 2 * TERNARY.digits[opponent];
+}
+
+/*
+ *Description: Returns the entry of the position where the first mask holds the Locations of the
+ *             side to move and the second mask holds the Locations of its opponent.
+ *Precondition: The masks do not overlap.
+ *Postcondition: The solved entry is returned; its score is ILLEGAL if the position can not
+ *               occur in a game.
+ */
+const SolvedEntry& SolvedTable::lookup(unsigned short own, unsigned short opponent)
+{
+    return SOLVED.entries[getIndex(own, opponent)];
+}
+
+/*
+ *Description: Returns a best move for the side to move
+ *Precondition: The position is legal and not over.
+ *Postcondition: The lowest-numbered Location among the best moves is returned
+ */
+Location SolvedTable::chooseMove(unsigned short own, unsigned short opponent)
+{
+    unsigned short moves = lookup(own, opponent).bestMoves;
+    if(moves == 0)
+        return Location(0,0);
+    
+    int cell = __builtin_ctz(moves);
+    return Location(cell / GameBoard::BOARD_SIZE, cell % GameBoard::BOARD_SIZE);
+}
@@ -0,0 +1,64 @@
+/************************************************************************************
+ Title:         SolvedTable.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   A complete table of solved 3x3 positions. Every position is stored with
+                its game-theoretic score and the set of moves that achieve it. The table
+                is computed at compile time and lives in read-only data.
+ 
+ Purpose:       Provides O(1) perfect play with no search and no startup cost.
+ 
+ Usage:         SolvedTable::chooseMove(ownMask, opponentMask);
+                Positions are indexed from the point of view of the side to move: a base-3
+                number with one digit per Location, 0 for vacant, 1 for the side to move
+                and 2 for its opponent. Scores use the NegamaxSearch convention.
+ 
+ Build with:    Compile with main.cpp. Requires C++17.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#ifndef TicTacToe_SolvedTable_h
+#define TicTacToe_SolvedTable_h
+
+#include "Location.h"
+using namespace std;
+
+struct SolvedEntry {
+    signed char score; //Perfect-play score for the side to move, or SolvedTable::ILLEGAL
+    unsigned short bestMoves; //Mask of the Locations that achieve 'score'; 0 when the game is over
+};
+
+class SolvedTable {
+    
+public:
+    static const SolvedEntry& lookup(unsigned short, unsigned short);
+    /*
+     *Description: Returns the entry of the position where the first mask holds the Locations of the
+     *             side to move and the second mask holds the Locations of its opponent.
+     *Precondition: The masks do not overlap.
+     *Postcondition: The solved entry is returned; its score is ILLEGAL if the position can not
+     *               occur in a game.
+     */
+    
+    static Location chooseMove(unsigned short, unsigned short);
+    /*
+     *Description: Returns a best move for the side to move
+     *Precondition: The position is legal and not over.
+     *Postcondition: The lowest-numbered Location among the best moves is returned
+     */
+    
+    static int getIndex(unsigned short, unsigned short);
+    /*
+     *Description: Returns the table index of the position(see Usage above)
+     *Precondition: The masks do not overlap.
+     *Postcondition: An integer between 0 and POSITION_COUNT - 1 is returned
+     */
+    
+    static const int POSITION_COUNT = 19683; //3 to the 9th power
+    static const signed char ILLEGAL = -128; //Score of positions that can not occur in a game
+};
+#endif
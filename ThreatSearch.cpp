@@ -0,0 +1,431 @@
+/************************************************************************************
+ Title:         ThreatSearch.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of ThreatSearch.h. A proof-number search: the tree is
+                grown at its most-proving node, the leaf reached by following the child
+                with the smallest proof number from attacker nodes and the smallest
+                disproof number from defender nodes, and the numbers are then recomputed
+                on the way back to the root.
+ 
+ Purpose:       Finds forced wins made of threats on large boards.
+ 
+ Usage:         ThreatSearch search; Location move;
+                if(search.findWin(board, "X", move)) ...
+ 
+ Build with:    Compile with main.cpp.
+ 
+ Modifications: Counts the lines updated by each search.
+ ***********************************************************************************/
+
+#include "ThreatSearch.h"
+#include <algorithm>
+using namespace std;
+
+//Proof or disproof number of a position that can not be proved or disproved
+static const unsigned INFINITE = 1u << 30;
+
+/*
+ *Description: Appends a line to a list of lines and records its position
+ *Precondition: The line is not in the list
+ *Postcondition: The line is at the end of the list
+ */
+static void addLine(vector<int>& lines, vector<int>& slots, int line)
+{
+    slots[line] = static_cast<int>(lines.size());
+    lines.push_back(line);
+}
+
+/*
+ *Description: Removes a line from a list of lines by moving the last line into its place
+ *Precondition: The line is in the list
+ *Postcondition: The line is no longer in the list
+ */
+static void removeLine(vector<int>& lines, vector<int>& slots, int line)
+{
+    int slot = slots[line];
+    lines[slot] = lines.back();
+    slots[lines[slot]] = slot;
+    lines.pop_back();
+    slots[line] = -1;
+}
+
+/*
+ *Description: Constructor that selects DEFAULT_NODE_LIMIT
+ *Precondition: N/A
+ *Postcondition: The search is ready; no memory has been allocated
+ */
+ThreatSearch::ThreatSearch() : geometry(0), winLength(0), nodeLimit(DEFAULT_NODE_LIMIT), linesEvaluated(0), timed(false)
+{
+}
+
+/*
+ *Description: Searches for a forced win of the supplied ID to move within the node limit
+ *Precondition: The game is not over
+ *Postcondition: Returns true and sets the Location to the first move of the win if one is proved
+ */
+bool ThreatSearch::findWin(const GameBoard& board, string ownID, Location& move)
+{
+    timed = false;
+    return search(board, ownID, move);
+}
+
+/*
+ *Description: Searches for a forced win of the supplied ID to move within the node limit and until the
+ *             supplied deadline
+ *Precondition: The game is not over
+ *Postcondition: Returns true and sets the Location to the first move of the win if one is proved
+ */
+bool ThreatSearch::findWin(const GameBoard& board, string ownID, Location& move, chrono::steady_clock::time_point end)
+{
+    timed = true;
+    deadline = end;
+    return search(board, ownID, move);
+}
+
+/*
+ *Description: Sets the largest number of positions a search may add to its tree
+ *Precondition: The limit is positive
+ *Postcondition: The limit is updated
+ */
+void ThreatSearch::setNodeLimit(long limit)
+{
+    nodeLimit = limit;
+}
+
+/*
+ *Description: Accessor functions for the node limit and the size and line updates of the last search
+ *Precondition: N/A
+ *Postcondition: The requested value is returned
+ */
+long ThreatSearch::getNodeLimit() const
+{
+    return nodeLimit;
+}
+
+long ThreatSearch::getNodeCount() const
+{
+    return static_cast<long>(nodes.size());
+}
+
+long ThreatSearch::getLinesEvaluated() const
+{
+    return linesEvaluated;
+}
+
+/*
+ *Description: Grows the proof tree of the supplied board until the root is settled or a limit is reached
+ *Precondition: The game is not over
+ *Postcondition: Returns true and sets the Location if a win is proved
+ */
+bool ThreatSearch::search(const GameBoard& board, string ownID, Location& move)
+{
+    nodes.clear();
+    linesEvaluated = 0;
+    
+    //Shorter lines have no twos to build threes from
+    if(board.getGeometry().getWinLength() < 4)
+        return false;
+    prepare(board.getGeometry());
+    load(board, ownID);
+    linesEvaluated = 0;
+    
+    Node root;
+    root.parent = -1;
+    root.firstChild = -1;
+    root.childCount = 0;
+    root.cell = -1;
+    root.attackerToMove = true;
+    evaluate(root);
+    nodes.push_back(root);
+    
+    //A four already on the board wins at once
+    if(nodes[0].proof == 0)
+    {
+        move = geometry->getLocation(getEmptyCells(fourLines[0]).lowest());
+        return true;
+    }
+    
+    for(long expansions = 0; nodes[0].proof != 0 && nodes[0].disproof != 0; expansions++)
+    {
+        if(static_cast<long>(nodes.size()) >= nodeLimit)
+            break;
+        if(timed && expansions % CLOCK_INTERVAL == 0 && chrono::steady_clock::now() >= deadline)
+            break;
+        
+        //Walk down to the most-proving node, playing its moves
+        int current = 0;
+        while(nodes[current].firstChild >= 0)
+        {
+            const Node& node = nodes[current];
+            int best = node.firstChild;
+            for(int child = node.firstChild + 1; child < node.firstChild + node.childCount; child++)
+                if(node.attackerToMove ? nodes[child].proof < nodes[best].proof
+                                       : nodes[child].disproof < nodes[best].disproof)
+                    best = child;
+            play(node.attackerToMove ? 0 : 1, nodes[best].cell);
+            current = best;
+        }
+        
+        expand(current);
+        
+        //Back up the new numbers, taking the moves back
+        while(current != 0)
+        {
+            int parent = nodes[current].parent;
+            undo(nodes[parent].attackerToMove ? 0 : 1, nodes[current].cell);
+            current = parent;
+            update(current);
+        }
+    }
+    
+    if(nodes[0].proof != 0)
+        return false;
+    for(int child = nodes[0].firstChild; child < nodes[0].firstChild + nodes[0].childCount; child++)
+        if(nodes[child].proof == 0)
+        {
+            move = geometry->getLocation(nodes[child].cell);
+            return true;
+        }
+    return false;
+}
+
+/*
+ *Description: Copies the winning lines and the lines through each cell of the supplied geometry
+ *Precondition: N/A
+ *Postcondition: The tables match the geometry; nothing is done if they already did
+ */
+void ThreatSearch::prepare(const BoardGeometry& boardGeometry)
+{
+    if(geometry == &boardGeometry)
+        return;
+    
+    geometry = &boardGeometry;
+    boardMask = geometry->getFullMask();
+    winLength = geometry->getWinLength();
+    
+    lineMasks.resize(geometry->getLineCount());
+    for(int line = 0; line < geometry->getLineCount(); line++)
+        lineMasks[line] = geometry->getLine(line);
+    
+    cellLineStart.assign(1, 0);
+    cellLines.clear();
+    for(int cell = 0; cell < geometry->getCellCount(); cell++)
+    {
+        int count;
+        const int* lines = geometry->getCellLines(cell, count);
+        cellLines.insert(cellLines.end(), lines, lines + count);
+        cellLineStart.push_back(static_cast<int>(cellLines.size()));
+    }
+}
+
+/*
+ *Description: Sets up the line counts and the lists of fours, threes and twos with the supplied ID as the attacker
+ *Precondition: prepare has been called for the board's geometry
+ *Postcondition: The search state holds the board's position
+ */
+void ThreatSearch::load(const GameBoard& board, string ownID)
+{
+    for(int s = 0; s < 2; s++)
+    {
+        lineCounts[s].assign(lineMasks.size(), 0);
+        fourSlots[s].assign(lineMasks.size(), -1);
+        threeSlots[s].assign(lineMasks.size(), -1);
+        twoSlots[s].assign(lineMasks.size(), -1);
+        fourLines[s].clear();
+        threeLines[s].clear();
+        twoLines[s].clear();
+    }
+    occupied = CellMask();
+    twoCounts.assign(geometry->getCellCount(), 0);
+    
+    int ownSide = GameBoard::getSide(ownID);
+    CellMask boardStones[2] = { board.getMask(ownSide), board.getMask(ownSide ^ 1) };
+    for(int s = 0; s < 2; s++)
+        for(CellMask rest = boardStones[s]; rest.any(); )
+            play(s, rest.popLowest());
+}
+
+/*
+ *Description: Places a stone of the supplied side on the supplied cell
+ *Precondition: The cell is vacant
+ *Postcondition: The counts and lists include the stone
+ */
+void ThreatSearch::play(int who, int cell)
+{
+    linesEvaluated += cellLineStart[cell + 1] - cellLineStart[cell];
+    for(int i = cellLineStart[cell]; i < cellLineStart[cell + 1]; i++)
+    {
+        int line = cellLines[i];
+        classify(line, -1);
+        lineCounts[who][line]++;
+        classify(line, 1);
+    }
+    occupied.set(cell);
+}
+
+/*
+ *Description: Takes back the stone of the supplied side from the supplied cell
+ *Precondition: The cell holds the side's stone
+ *Postcondition: The counts and lists no longer include the stone
+ */
+void ThreatSearch::undo(int who, int cell)
+{
+    linesEvaluated += cellLineStart[cell + 1] - cellLineStart[cell];
+    for(int i = cellLineStart[cell]; i < cellLineStart[cell + 1]; i++)
+    {
+        int line = cellLines[i];
+        classify(line, -1);
+        lineCounts[who][line]--;
+        classify(line, 1);
+    }
+    occupied.clear(cell);
+}
+
+/*
+ *Description: Adds or removes the supplied line to or from the lists its current counts put it in
+ *Precondition: When removing, the counts are those the line was added with
+ *Postcondition: The lists are updated
+ */
+void ThreatSearch::classify(int line, int delta)
+{
+    for(int s = 0; s < 2; s++)
+    {
+        if(lineCounts[s ^ 1][line] != 0)
+            continue;
+        int count = lineCounts[s][line];
+        if(count == winLength - 1)
+            delta > 0 ? addLine(fourLines[s], fourSlots[s], line) : removeLine(fourLines[s], fourSlots[s], line);
+        else if(count == winLength - 2)
+            delta > 0 ? addLine(threeLines[s], threeSlots[s], line) : removeLine(threeLines[s], threeSlots[s], line);
+        else if(count == winLength - 3 && count > 0)
+            delta > 0 ? addLine(twoLines[s], twoSlots[s], line) : removeLine(twoLines[s], twoSlots[s], line);
+    }
+}
+
+/*
+ *Description: Returns the vacant cells of the supplied lines
+ *Precondition: N/A
+ *Postcondition: A mask of cells is returned
+ */
+CellMask ThreatSearch::getEmptyCells(const vector<int>& lines) const
+{
+    CellMask cells;
+    for(size_t i = 0; i < lines.size(); i++)
+        cells = cells | lineMasks[lines[i]];
+    return cells.without(occupied);
+}
+
+/*
+ *Description: Sets the proof and disproof numbers of a new node from the current position
+ *Precondition: The position is the node's position
+ *Postcondition: The numbers are set
+ */
+void ThreatSearch::evaluate(Node& node) const
+{
+    int mover = node.attackerToMove ? 0 : 1;
+    bool proved = false;
+    bool disproved = occupied == boardMask;
+    
+    //The side to move wins with a four; otherwise two fours of the other side can not both be blocked
+    if(!fourLines[mover].empty())
+        (mover == 0 ? proved : disproved) = true;
+    else if(getEmptyCells(fourLines[mover ^ 1]).count() >= 2)
+        (mover == 0 ? disproved : proved) = true;
+    else if(mover == 1 && fourLines[0].empty() && threeLines[0].empty())
+        disproved = true;
+    
+    node.proof = proved ? 0 : disproved ? INFINITE : 1;
+    node.disproof = disproved ? 0 : proved ? INFINITE : 1;
+    
+    //A four leaves the defender one reply and a three several, so the search tries fours first
+    if(mover == 1 && !proved && !disproved && fourLines[0].empty())
+        node.proof = max(1, getEmptyCells(threeLines[0]).count());
+}
+
+/*
+ *Description: Adds the children of the supplied node and evaluates them
+ *Precondition: The position is the node's position; it is neither proved nor disproved
+ *Postcondition: The node has children, or is settled if there are none
+ */
+void ThreatSearch::expand(int index)
+{
+    bool attacker = nodes[index].attackerToMove;
+    int mover = attacker ? 0 : 1;
+    
+    //A four of the other side must be blocked. Otherwise the attacker makes a four or two threes, and
+    //the defender answers with a cell of one of the attacker's threes or a four of its own.
+    CellMask moves = getEmptyCells(fourLines[mover ^ 1]);
+    if(moves.none() && attacker)
+    {
+        moves = getEmptyCells(threeLines[0]);
+        
+        //A cell on two of the attacker's twos makes two threes; the counts are cleared as they are read
+        CellMask twoCells = getEmptyCells(twoLines[0]);
+        for(size_t i = 0; i < twoLines[0].size(); i++)
+            for(CellMask rest = lineMasks[twoLines[0][i]].without(occupied); rest.any(); )
+                twoCounts[rest.popLowest()]++;
+        while(twoCells.any())
+        {
+            int cell = twoCells.popLowest();
+            if(twoCounts[cell] >= 2)
+                moves.set(cell);
+            twoCounts[cell] = 0;
+        }
+    }
+    else if(moves.none())
+        moves = getEmptyCells(threeLines[0]) | getEmptyCells(threeLines[1]);
+    
+    if(moves.none())
+    {
+        nodes[index].proof = attacker ? INFINITE : 0;
+        nodes[index].disproof = attacker ? 0 : INFINITE;
+        return;
+    }
+    
+    int first = static_cast<int>(nodes.size());
+    for(CellMask rest = moves; rest.any(); )
+    {
+        Node child;
+        child.parent = index;
+        child.firstChild = -1;
+        child.childCount = 0;
+        child.cell = static_cast<short>(rest.popLowest());
+        child.attackerToMove = !attacker;
+        play(mover, child.cell);
+        evaluate(child);
+        undo(mover, child.cell);
+        nodes.push_back(child);
+    }
+    nodes[index].firstChild = first;
+    nodes[index].childCount = static_cast<short>(nodes.size() - first);
+    update(index);
+}
+
+/*
+ *Description: Recomputes the proof and disproof numbers of the supplied node from its children
+ *Precondition: The node has been expanded
+ *Postcondition: The numbers are updated
+ */
+void ThreatSearch::update(int index)
+{
+    Node& node = nodes[index];
+    if(node.firstChild < 0)
+        return;
+    
+    //An attacker node needs one child proved and every child disproved; a defender node the reverse
+    unsigned smallest = INFINITE;
+    unsigned sum = 0;
+    for(int child = node.firstChild; child < node.firstChild + node.childCount; child++)
+    {
+        unsigned own = node.attackerToMove ? nodes[child].proof : nodes[child].disproof;
+        unsigned other = node.attackerToMove ? nodes[child].disproof : nodes[child].proof;
+        smallest = min(smallest, own);
+        sum = min(sum + other, INFINITE);
+    }
+    node.proof = node.attackerToMove ? smallest : sum;
+    node.disproof = node.attackerToMove ? sum : smallest;
+}
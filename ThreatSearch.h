@@ -0,0 +1,194 @@
+/************************************************************************************
+ Title:         ThreatSearch.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   A proof-number search for forced wins made of threats, for large boards
+                such as 15x15 five-in-a-row(lines of at least four). The attacker only
+                plays moves that make a four(a line one stone short of a win, with no
+                stone of the defender) or at least two threes(lines two stones short);
+                the defender only plays the moves that stop them: the block of a four,
+                or a cell of one of the attacker's threes, or a four of its own. Every
+                line's stone counts and the lists of each side's fours, threes and twos
+                are kept up to date as moves are made and taken back, so a move touches
+                only the lines through its cell.
+ 
+ Purpose:       Finds the long forcing wins of large boards, which alpha-beta can not see
+                at the depth it reaches there. The tree is narrow because almost every
+                move is forced, so wins of 10 to 20 moves are proved in milliseconds.
+                Like every threat-space search it assumes the defender has nothing better
+                than those replies, so a proof is only as good as that assumption(it is
+                exact for wins made of fours only).
+ 
+ Usage:         ThreatSearch search;
+                Location move;
+                if(search.findWin(board, "X", move)) ... //'move' starts a forced win
+                if(search.findWin(board, "X", move, deadline)) ...
+                search.setNodeLimit(200000); search.getNodeCount();
+ 
+ Build with:    Compile with main.cpp.
+ 
+ Modifications: Counts the lines updated by each search.
+ ***********************************************************************************/
+
+#ifndef TicTacToe_ThreatSearch_h
+#define TicTacToe_ThreatSearch_h
+
+#include "BoardGeometry.h"
+#include "CellMask.h"
+#include "GameBoard.h"
+#include "Location.h"
+#include <chrono>
+#include <string>
+#include <vector>
+using namespace std;
+
+class ThreatSearch {
+
+public:
+    ThreatSearch();
+    /*
+     *Description: Constructor that selects DEFAULT_NODE_LIMIT; the line tables are built for the first board searched
+     *Precondition: N/A
+     *Postcondition: The search is ready; no memory has been allocated
+     */
+    
+    bool findWin(const GameBoard&, string, Location&);
+    bool findWin(const GameBoard&, string, Location&, chrono::steady_clock::time_point);
+    /*
+     *Description: Searches for a forced win of the supplied ID('X' or 'O') to move, within the node limit
+     *             and, for the second form, until the supplied deadline
+     *Precondition: The game is not over
+     *Postcondition: Returns true and sets the Location to the first move of the win if one is proved;
+     *               otherwise returns false and leaves the Location unchanged
+     */
+    
+    void setNodeLimit(long);
+    /*
+     *Description: Sets the largest number of positions a search may add to its tree
+     *Precondition: The limit is positive
+     *Postcondition: The limit is updated
+     */
+    
+    long getNodeLimit() const;
+    long getNodeCount() const;
+    long getLinesEvaluated() const;
+    /*
+     *Description: Accessor functions for the node limit, and for the number of positions the last search
+     *             added and the line counts it updated
+     *Precondition: N/A
+     *Postcondition: The requested value is returned
+     */
+    
+    static const long DEFAULT_NODE_LIMIT = 50000; //Positions a search may add unless setNodeLimit is called
+    static const int LARGE_BOARD_CELLS = 64; //Computer searches for threat wins on boards with more cells
+    static const int CLOCK_INTERVAL = 64; //Expansions between looks at the clock
+
+private:
+    //A position of the proof tree; its children are stored one after another
+    struct Node {
+        unsigned proof; //Smallest number of leaves that must be proved to prove a win here
+        unsigned disproof; //Smallest number of leaves that must be disproved to rule one out
+        int parent; //Index of the parent, or -1 for the root
+        int firstChild; //Index of the first child, or -1 until expanded
+        short childCount; //Number of children
+        short cell; //Move leading here, or -1 for the root
+        bool attackerToMove; //Whether this is an OR node
+    };
+    
+    bool search(const GameBoard&, string, Location&);
+    /*
+     *Description: Grows the proof tree of the supplied board until the root is proved or disproved, or the
+     *             node limit or the deadline(if 'timed') is reached
+     *Precondition: The game is not over
+     *Postcondition: Returns true and sets the Location if a win is proved
+     */
+    
+    void prepare(const BoardGeometry&);
+    /*
+     *Description: Copies the winning lines and the lines through each cell of the supplied geometry
+     *Precondition: N/A
+     *Postcondition: The tables match the geometry; nothing is done if they already did
+     */
+    
+    void load(const GameBoard&, string);
+    /*
+     *Description: Sets up the line counts and the lists of fours, threes and twos of the supplied board, with the
+     *             supplied ID as the attacker
+     *Precondition: prepare has been called for the board's geometry
+     *Postcondition: The search state holds the board's position
+     */
+    
+    void play(int, int);
+    void undo(int, int);
+    /*
+     *Description: Places or takes back a stone of the supplied side(0 attacker, 1 defender) on the
+     *             supplied cell, updating the line counts and the lists of fours, threes and twos
+     *Precondition: play: the cell is vacant. undo: the cell holds the side's stone
+     *Postcondition: The state reflects the move
+     */
+    
+    void classify(int, int);
+    /*
+     *Description: Adds(1) or removes(-1) the supplied line to or from the lists of fours, threes and twos its
+     *             current counts put it in
+     *Precondition: When removing, the counts are those the line was added with
+     *Postcondition: The lists are updated
+     */
+    
+    CellMask getEmptyCells(const vector<int>&) const;
+    /*
+     *Description: Returns the vacant cells of the supplied lines
+     *Precondition: N/A
+     *Postcondition: A mask of cells is returned
+     */
+    
+    void evaluate(Node&) const;
+    /*
+     *Description: Sets the proof and disproof numbers of a new node from the current position: proved if
+     *             the attacker wins on its next move whatever the defender does, disproved if the defender
+     *             wins first, the board is full or the attacker has run out of threats
+     *Precondition: The position is the node's position
+     *Postcondition: The numbers are set
+     */
+    
+    void expand(int);
+    /*
+     *Description: Adds the children of the supplied node, the attacker's threat moves or the defender's
+     *             replies, and evaluates them
+     *Precondition: The position is the node's position; it is neither proved nor disproved
+     *Postcondition: The node has children, or is disproved(proved for the defender) if there are none
+     */
+    
+    void update(int);
+    /*
+     *Description: Recomputes the proof and disproof numbers of the supplied node from its children
+     *Precondition: The node has been expanded
+     *Postcondition: The numbers are updated
+     */
+    
+    const BoardGeometry* geometry; //Geometry the tables were built for, or 0
+    vector<CellMask> lineMasks; //Cells of each winning line
+    vector<int> cellLineStart; //Offset of each cell's first entry in 'cellLines'; one extra entry at the end
+    vector<int> cellLines; //Lines through each cell, cell after cell
+    vector<unsigned char> lineCounts[2]; //Stones of the attacker and the defender on each line
+    vector<int> fourLines[2]; //Lines one stone short of a win for each side, with no stone of the other
+    vector<int> fourSlots[2]; //Position of each line in fourLines, or -1
+    vector<int> threeLines[2]; //Lines two stones short of a win for each side, with no stone of the other
+    vector<int> threeSlots[2]; //Position of each line in threeLines, or -1
+    vector<int> twoLines[2]; //Lines three stones short of a win for each side(but not empty), with no stone of the other
+    vector<int> twoSlots[2]; //Position of each line in twoLines, or -1
+    vector<unsigned char> twoCounts; //Scratch count of the attacker's twos through each cell; all zero between uses
+    int winLength; //Stones in a row needed to win
+    
+    CellMask boardMask; //Every cell of the board
+    CellMask occupied; //Cells of either side
+    vector<Node> nodes; //The proof tree; the root is node 0
+    long nodeLimit; //Largest number of nodes a search may add
+    long linesEvaluated; //Line counts updated by the last search
+    bool timed; //Whether the current search stops at 'deadline'
+    chrono::steady_clock::time_point deadline; //End of the current timed search
+};
+#endif
@@ -0,0 +1,91 @@
+/************************************************************************************
+ Title:         TranspositionTable.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of TranspositionTable.h. A key's slot is chosen by its
+                low bits; an empty slot has bound NONE.
+ 
+ Purpose:       Lets a search reuse the scores of positions it has already searched.
+ 
+ Usage:         table.probe(key, entry); table.store(key, score, depth, bound, cell);
+ 
+ Build with:    Compile with main.cpp.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#include "TranspositionTable.h"
+using namespace std;
+
+/*
+ *Description: Constructor that sizes the table to 2 to the power of the supplied number of slots
+ *Precondition: 0 <= bits <= 30
+ *Postcondition: The table is empty; no memory is allocated until the first store
+ */
+TranspositionTable::TranspositionTable(int bits) : indexMask((size_t(1) << bits) - 1)
+{
+}
+
+/*
+ *Description: Looks up the supplied key
+ *Precondition: N/A
+ *Postcondition: Returns true and copies the stored entry if the key is present; otherwise
+ *               returns false
+ */
+bool TranspositionTable::probe(uint64_t key, TranspositionEntry& entry) const
+{
+    if(entries.empty())
+        return false;
+    
+    const TranspositionEntry& slot = entries[key & indexMask];
+    if(slot.bound == NONE || slot.key != key)
+        return false;
+    
+    entry = slot;
+    return true;
+}
+
+/*
+ *Description: Stores the score, search depth, bound and best move of the supplied key
+ *Precondition: The score and depth fit in the entry fields
+ *Postcondition: The entry is stored unless a deeper result of the same key is kept
+ */
+void TranspositionTable::store(uint64_t key, int score, int depth, Bound bound, int bestCell)
+{
+    if(entries.empty())
+        entries.assign(indexMask + 1, TranspositionEntry());
+    
+    TranspositionEntry& slot = entries[key & indexMask];
+    if(slot.bound != NONE && slot.key == key && slot.depth > depth)
+        return;
+    
+    slot.key = key;
+    slot.score = static_cast<short>(score);
+    slot.depth = static_cast<signed char>(depth);
+    slot.bound = static_cast<unsigned char>(bound);
+    slot.bestCell = static_cast<short>(bestCell);
+}
+
+/*
+ *Description: Removes every entry
+ *Precondition: N/A
+ *Postcondition: Every probe fails until the next store
+ */
+void TranspositionTable::clear()
+{
+    entries.clear();
+    entries.shrink_to_fit();
+}
+
+/*
+ *Description: Accessor function that returns the number of slots
+ *Precondition: N/A
+ *Postcondition: A power of two is returned
+ */
+size_t TranspositionTable::getSize() const
+{
+    return indexMask + 1;
+}
@@ -0,0 +1,88 @@
+/************************************************************************************
+ Title:         TranspositionTable.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   A fixed-size hash table of search results keyed by Zobrist hash. Each slot
+                holds the full key, so a lookup only succeeds for the position that was
+                stored; a later position hashing to the same slot replaces it.
+ 
+ Purpose:       Lets a search reuse the score of a position it reaches again through a
+                different move order(a transposition) or, when keyed by a canonical hash,
+                through a rotation or reflection of an earlier position.
+ 
+ Usage:         TranspositionTable table(12); //4096 slots
+                TranspositionEntry entry;
+                if(table.probe(key, entry)) ... ; table.store(key, score, depth, bound, cell);
+                The slots are allocated on the first store.
+ 
+ Build with:    Compile with main.cpp.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#ifndef TicTacToe_TranspositionTable_h
+#define TicTacToe_TranspositionTable_h
+
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+struct TranspositionEntry {
+    uint64_t key; //Full hash of the stored position
+    short score; //Score for the side to move
+    signed char depth; //Remaining search depth the score was found with
+    unsigned char bound; //One of TranspositionTable::Bound
+    short bestCell; //Best move found, or -1
+};
+
+class TranspositionTable {
+    
+public:
+    enum Bound { NONE, EXACT, LOWER, UPPER };
+    
+    explicit TranspositionTable(int);
+    /*
+     *Description: Constructor that sizes the table to 2 to the power of the supplied number of slots
+     *Precondition: 0 <= bits <= 30
+     *Postcondition: The table is empty; no memory is allocated until the first store
+     */
+    
+    bool probe(uint64_t, TranspositionEntry&) const;
+    /*
+     *Description: Looks up the supplied key
+     *Precondition: N/A
+     *Postcondition: Returns true and copies the stored entry if the key is present; otherwise
+     *               returns false
+     */
+    
+    void store(uint64_t, int, int, Bound, int);
+    /*
+     *Description: Stores the score, search depth, bound and best move of the supplied key. An
+     *             entry of another position is always replaced; an entry of the same position
+     *             is only replaced by a search at least as deep.
+     *Precondition: The score and depth fit in the entry fields
+     *Postcondition: The entry is stored unless a deeper result of the same key is kept
+     */
+    
+    void clear();
+    /*
+     *Description: Removes every entry
+     *Precondition: N/A
+     *Postcondition: Every probe fails until the next store
+     */
+    
+    size_t getSize() const;
+    /*
+     *Description: Accessor function that returns the number of slots
+     *Precondition: N/A
+     *Postcondition: A power of two is returned
+     */
+    
+private:
+    size_t indexMask; //Number of slots minus one
+    vector<TranspositionEntry> entries; //The slots; empty until the first store
+};
+#endif
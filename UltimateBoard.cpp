@@ -0,0 +1,193 @@
+/************************************************************************************
+ Title:         UltimateBoard.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of UltimateBoard.h. The rules of Ultimate
+                Tic-Tac-Toe on bitboards.
+ 
+ Purpose:       Provides fast move generation and win checks for the UltimateSearch.
+ 
+ Usage:         board.generateMoves(moves); board.makeMove(move);
+ 
+ Build with:    Compile with ultimate.cpp.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#include "UltimateBoard.h"
+#include "GameBoard.h"
+#include "Zobrist.h"
+using namespace std;
+
+/*
+ *Description: Computes LINE_TABLE from GameBoard::LINE_MASKS at compile time
+ *Precondition: N/A
+ *Postcondition: The table is returned
+ */
+constexpr UltimateBoard::LineTable UltimateBoard::buildLineTable()
+{
+    LineTable table = {};
+    for(int mask = 0; mask < 512; mask++)
+        for(int line = 0; line < 8; line++)
+            if((mask & GameBoard::LINE_MASKS[line]) == GameBoard::LINE_MASKS[line])
+                table.lines[mask] = true;
+    return table;
+}
+
+const UltimateBoard::LineTable UltimateBoard::LINE_TABLE = UltimateBoard::buildLineTable();
+
+/*
+ *Description: Constructor of an empty board with 'X' to move anywhere
+ *Precondition: N/A
+ *Postcondition: The game is in progress
+ */
+UltimateBoard::UltimateBoard()
+    : wonBoards{0, 0}, closedBoards(0), nextBoard(-1), side(0), winner(-1), over(false), stoneHash(0)
+{
+    for(int board = 0; board < BOARD_COUNT; board++)
+        stones[0][board] = stones[1][board] = 0;
+}
+
+/*
+ *Description: Plays the supplied move for the side to move
+ *Precondition: N/A
+ *Error Checking: The game must be in progress and the move legal.
+ *Postcondition: Returns true and plays the move if it is legal; otherwise the board is unchanged
+ */
+bool UltimateBoard::makeMove(int move)
+{
+    if(!isLegal(move))
+        return false;
+    
+    int board = move / 9;
+    int cell = move % 9;
+    unsigned short& own = stones[side][board];
+    own |= static_cast<unsigned short>(1 << cell);
+    stoneHash ^= Zobrist::getKey(side, move);
+    
+    //Only the sub-board just played in can change, and only the mover can have won it
+    if(hasLine(own))
+    {
+        wonBoards[side] |= static_cast<unsigned short>(1 << board);
+        closedBoards |= static_cast<unsigned short>(1 << board);
+        if(hasLine(wonBoards[side]))
+        {
+            winner = side;
+            over = true;
+        }
+    }
+    else if((own | stones[side ^ 1][board]) == GameBoard::FULL_MASK)
+        closedBoards |= static_cast<unsigned short>(1 << board);
+    
+    if(closedBoards == GameBoard::FULL_MASK)
+        over = true;
+    
+    nextBoard = static_cast<signed char>((closedBoards >> cell) & 1 ? -1 : cell);
+    side ^= 1;
+    return true;
+}
+
+/*
+ *Description: Returns true if the supplied move may be played now
+ *Precondition: N/A
+ *Postcondition: A boolean value is returned
+ */
+bool UltimateBoard::isLegal(int move) const
+{
+    if(over || move < 0 || move >= CELL_COUNT)
+        return false;
+    
+    int board = move / 9;
+    if((nextBoard >= 0 && board != nextBoard) || ((closedBoards >> board) & 1))
+        return false;
+    return !(((stones[0][board] | stones[1][board]) >> (move % 9)) & 1);
+}
+
+/*
+ *Description: Writes every legal move to the supplied array, sub-board by sub-board
+ *Precondition: The array has room for CELL_COUNT moves
+ *Postcondition: Returns the number of moves; 0 once the game is over
+ */
+int UltimateBoard::generateMoves(int* moves) const
+{
+    if(over)
+        return 0;
+    
+    unsigned int boards = nextBoard >= 0 ? 1u << nextBoard : (~closedBoards & GameBoard::FULL_MASK);
+    int count = 0;
+    while(boards)
+    {
+        int board = __builtin_ctz(boards);
+        boards &= boards - 1;
+        unsigned int empty = ~(stones[0][board] | stones[1][board]) & GameBoard::FULL_MASK;
+        while(empty)
+        {
+            moves[count++] = board * 9 + __builtin_ctz(empty);
+            empty &= empty - 1;
+        }
+    }
+    return count;
+}
+
+/*
+ *Description: Accessor functions for the side to move, the sub-board it must play in, the winner and
+ *             whether the game has ended
+ *Precondition: N/A
+ *Postcondition: The requested value is returned
+ */
+int UltimateBoard::getSideToMove() const
+{
+    return side;
+}
+
+int UltimateBoard::getNextBoard() const
+{
+    return nextBoard;
+}
+
+int UltimateBoard::getWinner() const
+{
+    return winner;
+}
+
+bool UltimateBoard::isOver() const
+{
+    return over;
+}
+
+/*
+ *Description: Accessor functions for the stones of a side in a sub-board, the sub-boards won by a side
+ *             and the sub-boards that are won or full
+ *Precondition: N/A
+ *Postcondition: The requested mask is returned
+ */
+unsigned short UltimateBoard::getStones(int stoneSide, int board) const
+{
+    return stones[stoneSide][board];
+}
+
+unsigned short UltimateBoard::getWonBoards(int wonSide) const
+{
+    return wonBoards[wonSide];
+}
+
+unsigned short UltimateBoard::getClosedBoards() const
+{
+    return closedBoards;
+}
+
+/*
+ *Description: Returns the Zobrist hash of the position, including the side to move and the sub-board
+ *             it must play in
+ *Precondition: N/A
+ *Postcondition: A 64-bit hash is returned
+ */
+uint64_t UltimateBoard::getHash() const
+{
+    //The keys past the 81 cells of side 0 mark the sub-board to play in
+    uint64_t hash = stoneHash ^ Zobrist::getKey(0, CELL_COUNT + 1 + nextBoard);
+    return side ? hash ^ Zobrist::getSideKey() : hash;
+}
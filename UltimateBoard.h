@@ -0,0 +1,131 @@
+/************************************************************************************
+ Title:         UltimateBoard.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The board of Ultimate Tic-Tac-Toe: a 3x3 grid of classic 3x3 boards.
+                A move is played in one cell of one sub-board, and the cell's position
+                within its sub-board sends the opponent to the matching sub-board. A
+                sub-board is won like a classic game; the game is won by winning three
+                sub-boards in a line. A player sent to a won or full sub-board may move
+                in any sub-board still open. A game with no open sub-board left is a draw.
+ 
+ Purpose:       Provides fast move generation and win checks for the UltimateSearch.
+                Each side's stones are kept as nine 9-bit masks, one per sub-board, in the
+                layout of the classic GameBoard masks(bit 3x+y), and the won and closed
+                sub-boards as 9-bit masks of the global board, so every win check is a
+                single lookup in a 512-entry table built from GameBoard::LINE_MASKS.
+                Boards are small, so searches copy them instead of undoing moves.
+ 
+ Usage:         UltimateBoard board;
+                int moves[UltimateBoard::CELL_COUNT]; int count = board.generateMoves(moves);
+                board.makeMove(moves[0]);
+                A move is numbered board * 9 + cell, where board and cell are both
+                numbered 3x+y(x the row, y the column).
+ 
+ Build with:    Compile with ultimate.cpp.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#ifndef TicTacToe_UltimateBoard_h
+#define TicTacToe_UltimateBoard_h
+
+#include <cstdint>
+using namespace std;
+
+class UltimateBoard {
+
+public:
+    UltimateBoard();
+    /*
+     *Description: Constructor of an empty board with 'X' to move anywhere
+     *Precondition: N/A
+     *Postcondition: The game is in progress
+     */
+    
+    bool makeMove(int);
+    /*
+     *Description: Plays the supplied move for the side to move
+     *Precondition: N/A
+     *Error Checking: The game must be in progress and the move legal.
+     *Postcondition: Returns true and plays the move if it is legal; otherwise the board is unchanged
+     */
+    
+    bool isLegal(int) const;
+    /*
+     *Description: Returns true if the supplied move may be played now
+     *Precondition: N/A
+     *Postcondition: A boolean value is returned
+     */
+    
+    int generateMoves(int*) const;
+    /*
+     *Description: Writes every legal move to the supplied array, sub-board by sub-board
+     *Precondition: The array has room for CELL_COUNT moves
+     *Postcondition: Returns the number of moves; 0 once the game is over
+     */
+    
+    int getSideToMove() const;
+    int getNextBoard() const;
+    int getWinner() const;
+    bool isOver() const;
+    /*
+     *Description: Accessor functions for the side to move(0 for 'X', 1 for 'O'), the sub-board the
+     *             side to move must play in(-1 for any open one), the winner(0, 1, or -1 for none)
+     *             and whether the game has ended
+     *Precondition: N/A
+     *Postcondition: The requested value is returned
+     */
+    
+    unsigned short getStones(int, int) const;
+    unsigned short getWonBoards(int) const;
+    unsigned short getClosedBoards() const;
+    /*
+     *Description: Accessor functions for the stones of the supplied side(0 or 1) in the supplied
+     *             sub-board, the sub-boards won by the supplied side, and the sub-boards that are
+     *             won or full, all as 9-bit masks
+     *Precondition: N/A
+     *Postcondition: The requested mask is returned
+     */
+    
+    uint64_t getHash() const;
+    /*
+     *Description: Returns the Zobrist hash of the position, including the side to move and the sub-board
+     *             it must play in
+     *Precondition: N/A
+     *Postcondition: A 64-bit hash is returned
+     */
+    
+    static bool hasLine(unsigned short mask) { return LINE_TABLE.lines[mask]; }
+    /*Returns true if the 9-bit mask covers one of the 8 lines of a 3x3 board.*/
+    
+    static const int BOARD_COUNT = 9; //Sub-boards
+    static const int CELL_COUNT = 81; //Cells of all sub-boards
+
+private:
+    struct LineTable {
+        bool lines[512]; //Whether each 9-bit mask covers a line
+    };
+    
+    static constexpr LineTable buildLineTable();
+    /*
+     *Description: Computes LINE_TABLE from GameBoard::LINE_MASKS at compile time
+     *Precondition: N/A
+     *Postcondition: The table is returned
+     */
+    
+    static const LineTable LINE_TABLE; //Line lookup shared by the sub-boards and the global board
+    
+    unsigned short stones[2][BOARD_COUNT]; //Stones of 'X' and 'O' in each sub-board
+    unsigned short wonBoards[2]; //Sub-boards won by 'X' and 'O'
+    unsigned short closedBoards; //Sub-boards that are won or full
+    signed char nextBoard; //Sub-board the side to move must play in, or -1 for any
+    signed char side; //Side to move: 0 for 'X', 1 for 'O'
+    signed char winner; //Winning side, or -1
+    bool over; //Whether the game has ended
+    uint64_t stoneHash; //Zobrist hash of the stones alone
+};
+#endif
@@ -0,0 +1,295 @@
+/************************************************************************************
+ Title:         UltimateSearch.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of UltimateSearch.h. Iterative deepening alpha-beta
+                for Ultimate Tic-Tac-Toe.
+ 
+ Purpose:       Provides an engine for Ultimate Tic-Tac-Toe under a time limit.
+ 
+ Usage:         search.setTimeLimit(ms); int move = search.chooseMove(board);
+ 
+ Build with:    Compile with ultimate.cpp.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#include "UltimateSearch.h"
+#include "GameBoard.h"
+using namespace std;
+
+const double UltimateSearch::DEFAULT_TIME_LIMIT = 100;
+
+//Weights of the static evaluation
+static const int WON_BOARD = 100; //A won sub-board
+static const int WON_CENTER_BOARD = 40; //Extra for the center sub-board
+static const int GLOBAL_TWO = 250; //Two won sub-boards in an open global line
+static const int LOCAL_TWO = 12; //Two stones in an open line of a sub-board
+static const int LOCAL_CENTER = 4; //A stone in the center of a sub-board
+static const int FREE_CHOICE = 25; //The side to move may play in any sub-board
+
+/*
+ *Description: Constructor that selects DEFAULT_TIME_LIMIT milliseconds per move and no depth limit
+ *Precondition: N/A
+ *Postcondition: The search is ready to choose moves
+ */
+UltimateSearch::UltimateSearch()
+    : timeLimit(DEFAULT_TIME_LIMIT), maxDepth(MAX_DEPTH), timedOut(false), nodes(0), depth(0), score(0),
+      table(TABLE_BITS)
+{
+}
+
+/*
+ *Description: Returns the best move found for the side to move within the time and depth limits
+ *Precondition: The game is not over
+ *Postcondition: A legal move is returned
+ */
+int UltimateSearch::chooseMove(const UltimateBoard& board)
+{
+    deadline = chrono::steady_clock::now() + chrono::microseconds(static_cast<long>(timeLimit * 1000));
+    timedOut = false;
+    nodes = 0;
+    depth = 0;
+    for(int side = 0; side < 2; side++)
+        for(int move = 0; move < UltimateBoard::CELL_COUNT; move++)
+            history[side][move] /= 8;
+    
+    int moves[UltimateBoard::CELL_COUNT];
+    int count = orderMoves(board, moves, -1);
+    int bestMove = moves[0];
+    score = 0;
+    
+    for(int iteration = 1; iteration <= maxDepth; iteration++)
+    {
+        //The previous iteration's best move is searched first
+        int alpha = -WIN_SCORE - 1;
+        int iterationBest = -1;
+        for(int i = 0; i < count; i++)
+        {
+            UltimateBoard child = board;
+            child.makeMove(moves[i]);
+            int value = -negamax(child, iteration - 1, 1, -WIN_SCORE - 1, -alpha);
+            if(timedOut)
+                break;
+            if(value > alpha)
+            {
+                alpha = value;
+                iterationBest = i;
+            }
+        }
+        
+        //A partial iteration still searched the previous best move first, so its best move is safe to use
+        if(iterationBest >= 0)
+        {
+            bestMove = moves[iterationBest];
+            score = alpha;
+            int chosen = moves[iterationBest];
+            for(int i = iterationBest; i > 0; i--)
+                moves[i] = moves[i - 1];
+            moves[0] = chosen;
+        }
+        if(timedOut)
+            break;
+        depth = iteration;
+        
+        //A forced result does not change with more depth
+        if(score >= WIN_SCORE - iteration || score <= -WIN_SCORE + iteration)
+            break;
+    }
+    return bestMove;
+}
+
+/*
+ *Description: Sets the time per move in milliseconds; 0 removes the limit
+ *Precondition: The time is non-negative
+ *Postcondition: The time limit is updated
+ */
+void UltimateSearch::setTimeLimit(double milliseconds)
+{
+    timeLimit = milliseconds;
+}
+
+/*
+ *Description: Sets the deepest iteration; 0 selects MAX_DEPTH
+ *Precondition: The depth is non-negative
+ *Postcondition: The depth limit is updated
+ */
+void UltimateSearch::setMaxDepth(int deepest)
+{
+    maxDepth = (deepest > 0 && deepest < MAX_DEPTH) ? deepest : MAX_DEPTH;
+}
+
+/*
+ *Description: Accessor functions for the depth, node count and score of the last search
+ *Precondition: N/A
+ *Postcondition: The requested value is returned
+ */
+int UltimateSearch::getDepth() const
+{
+    return depth;
+}
+
+long UltimateSearch::getNodeCount() const
+{
+    return nodes;
+}
+
+int UltimateSearch::getScore() const
+{
+    return score;
+}
+
+/*
+ *Description: Returns the static evaluation of the position for the side to move
+ *Precondition: The game is not over
+ *Postcondition: A score well inside +-WIN_SCORE is returned
+ */
+int UltimateSearch::evaluate(const UltimateBoard& board) const
+{
+    int sides[2] = { 0, 0 };
+    unsigned short closed = board.getClosedBoards();
+    
+    for(int side = 0; side < 2; side++)
+    {
+        unsigned short won = board.getWonBoards(side);
+        //A global line stays open while the other side has not won and no sub-board in it is drawn
+        unsigned short blocked = closed & ~won;
+        int value = __builtin_popcount(won) * WON_BOARD + ((won >> 4) & 1) * WON_CENTER_BOARD;
+        for(int line = 0; line < 8; line++)
+        {
+            unsigned short mask = GameBoard::LINE_MASKS[line];
+            if(!(mask & blocked) && __builtin_popcount(won & mask) == 2)
+                value += GLOBAL_TWO;
+        }
+        
+        for(int b = 0; b < UltimateBoard::BOARD_COUNT; b++)
+        {
+            if((closed >> b) & 1)
+                continue;
+            unsigned short own = board.getStones(side, b);
+            unsigned short other = board.getStones(side ^ 1, b);
+            value += ((own >> 4) & 1) * LOCAL_CENTER;
+            for(int line = 0; line < 8; line++)
+            {
+                unsigned short mask = GameBoard::LINE_MASKS[line];
+                if(!(mask & other) && __builtin_popcount(own & mask) == 2)
+                    value += LOCAL_TWO;
+            }
+        }
+        sides[side] = value;
+    }
+    
+    int side = board.getSideToMove();
+    int value = sides[side] - sides[side ^ 1];
+    return board.getNextBoard() < 0 ? value + FREE_CHOICE : value;
+}
+
+/*
+ *Description: Returns the score of the position for the side to move, searched to the supplied depth
+ *Precondition: alpha < beta
+ *Postcondition: The score is returned, or 0 once the time limit has passed
+ */
+int UltimateSearch::negamax(const UltimateBoard& board, int remaining, int ply, int alpha, int beta)
+{
+    //The side that just moved won, or nobody can
+    if(board.isOver())
+        return board.getWinner() < 0 ? 0 : -(WIN_SCORE - ply);
+    if(remaining == 0)
+        return evaluate(board);
+    
+    if((++nodes & 1023) == 0 && timeLimit > 0 && chrono::steady_clock::now() > deadline)
+        timedOut = true;
+    if(timedOut)
+        return 0;
+    
+    //Win scores are stored relative to this position so they stay valid at any distance from the root
+    uint64_t key = board.getHash();
+    TranspositionEntry entry;
+    int preferred = -1;
+    if(table.probe(key, entry))
+    {
+        preferred = entry.bestCell;
+        int stored = entry.score;
+        if(stored > WIN_SCORE - MAX_DEPTH * 2)
+            stored -= ply;
+        else if(stored < -WIN_SCORE + MAX_DEPTH * 2)
+            stored += ply;
+        
+        if(entry.depth >= remaining)
+        {
+            if(entry.bound == TranspositionTable::EXACT
+               || (entry.bound == TranspositionTable::LOWER && stored >= beta)
+               || (entry.bound == TranspositionTable::UPPER && stored <= alpha))
+                return stored;
+        }
+    }
+    
+    int moves[UltimateBoard::CELL_COUNT];
+    int count = orderMoves(board, moves, preferred);
+    int originalAlpha = alpha;
+    int best = -WIN_SCORE - 1;
+    int bestMove = moves[0];
+    for(int i = 0; i < count; i++)
+    {
+        UltimateBoard child = board;
+        child.makeMove(moves[i]);
+        int value = -negamax(child, remaining - 1, ply + 1, -beta, -alpha);
+        if(timedOut)
+            return 0;
+        
+        if(value > best)
+        {
+            best = value;
+            bestMove = moves[i];
+        }
+        if(value > alpha)
+            alpha = value;
+        if(alpha >= beta)
+        {
+            history[board.getSideToMove()][moves[i]] += remaining * remaining;
+            break;
+        }
+    }
+    
+    int stored = best;
+    if(stored > WIN_SCORE - MAX_DEPTH * 2)
+        stored += ply;
+    else if(stored < -WIN_SCORE + MAX_DEPTH * 2)
+        stored -= ply;
+    TranspositionTable::Bound bound = best <= originalAlpha ? TranspositionTable::UPPER
+                                    : best >= beta ? TranspositionTable::LOWER : TranspositionTable::EXACT;
+    table.store(key, stored, remaining, bound, bestMove);
+    return best;
+}
+
+/*
+ *Description: Generates the legal moves in search order: the preferred move first, then by history score
+ *Precondition: The array has room for UltimateBoard::CELL_COUNT moves
+ *Postcondition: Returns the number of moves
+ */
+int UltimateSearch::orderMoves(const UltimateBoard& board, int* moves, int preferred) const
+{
+    int count = board.generateMoves(moves);
+    const int* scores = history[board.getSideToMove()];
+    
+    //Insertion sort; the preferred move sorts above every history score
+    for(int i = 1; i < count; i++)
+    {
+        int move = moves[i];
+        long key = move == preferred ? 1L << 40 : scores[move];
+        int j = i;
+        for(; j > 0; j--)
+        {
+            int previous = moves[j - 1];
+            long previousKey = previous == preferred ? 1L << 40 : scores[previous];
+            if(previousKey >= key)
+                break;
+            moves[j] = moves[j - 1];
+        }
+        moves[j] = move;
+    }
+    return count;
+}
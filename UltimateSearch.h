@@ -0,0 +1,121 @@
+/************************************************************************************
+ Title:         UltimateSearch.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   An alpha-beta search for Ultimate Tic-Tac-Toe(see UltimateBoard.h) with
+                iterative deepening under a time limit. A TranspositionTable keyed by the
+                board's Zobrist hash orders the moves with the best move of an earlier
+                search and skips positions searched before; the remaining moves are
+                ordered by the history heuristic. Leaves are scored by a static
+                evaluation of won sub-boards, open two-in-a-rows on the global board and
+                on the sub-boards, and center control.
+ 
+ Purpose:       Provides an engine for Ultimate Tic-Tac-Toe that reaches a useful depth in
+                a fraction of a second despite the game's branching factor.
+ 
+ Usage:         UltimateSearch search;
+                search.setTimeLimit(100); //milliseconds per move
+                int move = search.chooseMove(board);
+                search.getDepth(); search.getNodeCount(); search.getScore();
+                Each deeper iteration starts from the best move of the previous one, so
+                when time runs out the best move found so far is played.
+ 
+ Build with:    Compile with ultimate.cpp.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#ifndef TicTacToe_UltimateSearch_h
+#define TicTacToe_UltimateSearch_h
+
+#include "TranspositionTable.h"
+#include "UltimateBoard.h"
+#include <chrono>
+#include <cstdint>
+using namespace std;
+
+class UltimateSearch {
+
+public:
+    UltimateSearch();
+    /*
+     *Description: Constructor that selects DEFAULT_TIME_LIMIT milliseconds per move and no depth limit
+     *Precondition: N/A
+     *Postcondition: The search is ready to choose moves
+     */
+    
+    int chooseMove(const UltimateBoard&);
+    /*
+     *Description: Returns the best move found for the side to move within the time and depth limits
+     *Precondition: The game is not over
+     *Postcondition: A legal move is returned
+     */
+    
+    void setTimeLimit(double);
+    /*
+     *Description: Sets the time per move in milliseconds; 0 removes the limit(a depth limit must then be set)
+     *Precondition: The time is non-negative
+     *Postcondition: The time limit is updated
+     */
+    
+    void setMaxDepth(int);
+    /*
+     *Description: Sets the deepest iteration; 0 selects MAX_DEPTH
+     *Precondition: The depth is non-negative
+     *Postcondition: The depth limit is updated
+     */
+    
+    int getDepth() const;
+    long getNodeCount() const;
+    int getScore() const;
+    /*
+     *Description: Accessor functions for the depth of the last completed iteration, the number of
+     *             positions searched and the score of the chosen move(WIN_SCORE minus the number of
+     *             moves for a forced win) of the last search
+     *Precondition: N/A
+     *Postcondition: The requested value is returned
+     */
+    
+    int evaluate(const UltimateBoard&) const;
+    /*
+     *Description: Returns the static evaluation of the position for the side to move
+     *Precondition: The game is not over
+     *Postcondition: A score well inside +-WIN_SCORE is returned
+     */
+    
+    static const double DEFAULT_TIME_LIMIT; //Milliseconds per move when no limit is set
+    static const int MAX_DEPTH = 64; //Deepest iteration
+    static const int WIN_SCORE = 30000; //Score of a win on the next move; later wins score less
+    static const int TABLE_BITS = 20; //The transposition table has 2^TABLE_BITS slots
+
+private:
+    int negamax(const UltimateBoard&, int, int, int, int);
+    /*
+     *Description: Returns the score of the position for the side to move, searched to the supplied
+     *             depth at the supplied distance from the root, within the window (alpha, beta)
+     *Precondition: alpha < beta
+     *Postcondition: The score is returned, or 0 once the time limit has passed
+     */
+    
+    int orderMoves(const UltimateBoard&, int*, int) const;
+    /*
+     *Description: Generates the legal moves in search order: the supplied preferred move first, then by
+     *             history score
+     *Precondition: The array has room for UltimateBoard::CELL_COUNT moves
+     *Postcondition: Returns the number of moves
+     */
+    
+    double timeLimit; //Milliseconds per move, or 0
+    int maxDepth; //Deepest iteration
+    chrono::steady_clock::time_point deadline; //End of the current search's time
+    bool timedOut; //Set once the deadline has passed
+    long nodes; //Positions searched by the current search
+    int depth; //Last completed iteration of the last search
+    int score; //Score of the chosen move of the last search
+    int history[2][UltimateBoard::CELL_COUNT]; //Cutoffs caused by each move, weighted by depth
+    TranspositionTable table; //Results of earlier searches
+};
+#endif
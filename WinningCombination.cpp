@@ -6,13 +6,13 @@
  Created On:  February 16, 2014
  
  Description: The implementation of WinningCombination.h. Stores a winning combination,
-              that is, a set of 3 Locations that must be in the same row, column, or diagonal
-              needed to win the game. Each 'WinningCombination' has a rank(0-2) that is based
+              that is, a set of k Locations that must be in the same row, column, or diagonal
+              needed to win the game. Each 'WinningCombination' has a rank(0 to k-1) that is based
               on how many locations of that particular combination is occupied by the same
               player. A WinningCombination is marked invalid if any two of its positions are 
               occupied by different players.
  
- Purpose:     Provides functionality to initialize the 3 Locations, update and advance 'rank' of 
+ Purpose:     Provides functionality to initialize the k Locations, update and advance 'rank' of 
               the WinningCombination, and check the validity of the combination.
  
  Usage:       Initialize a WinningCombinations with three locations. Default constructor 
@@ -20,11 +20,14 @@
  
  Build with:  Compile with main.cpp. Written with Xcode on OS X 10.8.5 .
  
- Modifications: N/A
+ Modifications: Locations are now read through GameBoard::getLocation since the board is stored as masks.
+                setRank no longer writes to the console.
+                Combinations may hold any number of Locations for m,n,k boards.
+                addStone updates a combination one move at a time; checkValidity takes the board by reference.
+                getLocationSet returns a reference instead of a copy.
  ***********************************************************************************/
 
 #include "WinningCombination.h"
-#include <iostream>
 using namespace std;
 
 /*
@@ -40,6 +43,18 @@ WinningCombination::WinningCombination(Location loc1, Location loc2, Location lo
     setRank(0);
 }
 
+/*
+ *Description:Constructor that initializes the Locations of WinningCombinations to the supplied list.
+ *            Also sets default values for isValid local boolean variable and rank local int variable
+ *Precondition: The list holds the k Locations of one winning line
+ *Postcondition: The WinningCombination has k Locations
+ */
+WinningCombination::WinningCombination(const vector<Location>& locations) : locationSet(locations)
+{
+    setValidity(true);
+    setRank(0);
+}
+
 /*
  *Description:Default constructor that initializes the three Locations of WinningCombinations to position (0,0)
  *            Also sets default values for isValid local boolean variable and rank local int variable
@@ -55,21 +70,15 @@ WinningCombination::WinningCombination()
 
 /*
  *Description: Mutator function that updates the local variable 'rank'
- *Precondition: The int parameter must be between 0 and 2, inclusive.
- *              Error message is displayed if an incorrect value is entered.
+ *Precondition: The int parameter must be between 0 and the number of Locations, inclusive.
+ *              An out of range value is ignored.
  *Postcondition: The 'rank' is updated.
  */
 void WinningCombination::setRank(int combinationRank)
 {
-    if(combinationRank >= 0 && combinationRank <= 2)
-    {
+    //Ignore erroneous ranks rather than printing from inside the engine
+    if(combinationRank >= 0 && combinationRank <= static_cast<int>(locationSet.size()))
         rank = combinationRank;
-    }
-    else
-    {
-        //Display error message if incorrect rank is entered.
-        cout << "Erroneous rank entered !" << endl;
-    }
 }
 
 /*
@@ -106,11 +115,11 @@ int WinningCombination::getRank()
 }
 
 /*
- *Description: Accessor function that returns 3 Locations of the WinningCombination
+ *Description: Accessor function that returns the Locations of the WinningCombination
  *Precondition:  N/A
- *Postcondition: A vector containing the 3 Locations are returned.
+ *Postcondition: A reference to the k Locations is returned; nothing is copied.
  */
-vector<Location> WinningCombination::getLocationSet()
+const vector<Location>& WinningCombination::getLocationSet() const
 {
     return locationSet;
 }
@@ -128,18 +137,18 @@ bool WinningCombination::getValidity()
 /*
  *Description: Ensures that the WinningCombination is "valid". A WinningCombination
  *             is considered to be valid if only one player(Computer or Player) occupies
- *             its 3 Locations. If both Computer and Player occupies any two locations of
+ *             its k Locations. If both Computer and Player occupies any two locations of
  *             the WinningCombination, the WinningCombination is considered invalid.
  *Precondition: The current playing GameBoard along with an string ID('X' or 'O') must
  *              be passed in.
  *Postcondition: The WinningCombination is either valid or invalid..
  */
-void WinningCombination::checkValidity(GameBoard board, string id)
+void WinningCombination::checkValidity(const GameBoard& board, string id)
 {
     //Temporary Locaion variable
     Location currentLocation;
     /*
-     * The following loop cycles through the 3 Location of the WinningCombination. At each
+     * The following loop cycles through the k Location of the WinningCombination. At each
      * iteration, it checks if the current Location is occupied by the passed in 'id'. If the
      * id doesn't match the occupant of Location, then WinningCombination is marked invalid. If 
      * the id does match, then 'rank' is updated. For instance, given the top row of the board as follows:
@@ -147,9 +156,9 @@ void WinningCombination::checkValidity(GameBoard board, string id)
      * ([0,0],[0,1], [0,2]) but in the third iteration the location Id 'O' does not match "X". Thus, this
      *  WinningCombination is marked invalid.
      */
-    for(int i = 0; i < 3; i++)
+    for(size_t i = 0; i < locationSet.size(); i++)
     {
-        currentLocation = ( board.gameBoard[getLocationSet()[i].x][getLocationSet()[i].y]);
+        currentLocation = board.getLocation(locationSet[i].x, locationSet[i].y);
         locationSet[i].locationId = currentLocation.locationId;
         
         if( currentLocation.locationId == id )
@@ -165,10 +174,48 @@ void WinningCombination::checkValidity(GameBoard board, string id)
             setValidity(false);
             locationSet[i].isUsed = true;
         }
-        
+    
     }
 }
 
+/*
+ *Description: Records a single move onto one of the WinningCombination's Locations. A move by the
+ *             owner of the combination advances its rank; a move by the other side invalidates it.
+ *Precondition: The Location's coordinates and locationId are set and it belongs to this combination.
+ *              The bool parameter is true when the owner made the move.
+ *Postcondition: The matching Location is marked used and the rank or validity is updated.
+ */
+void WinningCombination::addStone(const Location& loc, bool isOwner)
+{
+    for(size_t i = 0; i < locationSet.size(); i++)
+        if(locationSet[i].x == loc.x && locationSet[i].y == loc.y)
+        {
+            locationSet[i].isUsed = true;
+            locationSet[i].locationId = loc.locationId;
+        }
+    
+    if(isOwner)
+        setRank(getRank() + 1);
+    else
+        setValidity(false);
+}
+
+/*
+ *Description: Returns the WinningCombination to its empty-board state
+ *Precondition:  N/A
+ *Postcondition: Rank is 0, the combination is valid and none of its Locations is marked used.
+ */
+void WinningCombination::reset()
+{
+    for(size_t i = 0; i < locationSet.size(); i++)
+    {
+        locationSet[i].isUsed = false;
+        locationSet[i].locationId = "?";
+    }
+    setValidity(true);
+    setRank(0);
+}
+
 /*
  *Description: Resets the rank of WinningCombination.
  *Precondition:  N/A
@@ -5,21 +5,24 @@
  
  Created On:    February 16, 2014
  
- Description:   Stores a winning combination, that is a set of 3 Locations that must be in the same row,
-                column, or diagonal needed to win the game. Each 'WinningCombination' has a rank(0-2) that is based
-                on how many locations of that particular combination is occupied by the same
-                player. A WinningCombination is marked invalid if any two of its positions are
+ Description:   Stores a winning combination, that is a set of k Locations(3 on the classic board) that
+                must be in the same row, column, or diagonal needed to win the game. Each 'WinningCombination'
+                has a rank(0 to k-1) that is based on how many locations of that particular combination is
+                occupied by the same player. A WinningCombination is marked invalid if any two of its positions are
                 occupied by different players.
  
- Purpose:       Provides functionality to initialize the 3 Locations, update and advance 'rank' of
+ Purpose:       Provides functionality to initialize the k Locations, update and advance 'rank' of
                 the WinningCombination, and check the validity of the combination.
  
- Usage:         Initialize a WinningCombinations with three locations. Default constructor
-                creates WinningCombination with position(0,0)
+ Usage:         Initialize a WinningCombinations with three locations, or with the k locations of a
+                BoardGeometry line. Default constructor creates WinningCombination with position(0,0)
  
  Build with:    Compile with main.cpp. Written with Xcode on OS X 10.8.5 .
  
- Modifications: N/A
+ Modifications: setRank no longer writes to the console.
+                Combinations may hold any number of Locations for m,n,k boards.
+                addStone updates a combination one move at a time; checkValidity takes the board by reference.
+                getLocationSet returns a reference instead of a copy.
  ***********************************************************************************/
 
 #ifndef TicTacToe_WinningCombination_h
@@ -32,7 +35,7 @@
 using namespace std;
 
 class WinningCombination {
-    
+
 public:
     WinningCombination(Location, Location, Location);
     /*
@@ -41,14 +44,21 @@ public:
      *Postcondition: The WinningCombination has three Locations
      */
     
+    WinningCombination(const vector<Location>&);
+    /*
+     *Description:Constructor that initializes the Locations of WinningCombinations to the supplied list
+     *Precondition: The list holds the k Locations of one winning line
+     *Postcondition: The WinningCombination has k Locations
+     */
+    
     WinningCombination();
      /*
      *Description:Constructor that initializes the three Locations of WinningCombinations to position (0,0)
      *Precondition: N/A
      *Postcondition: The WinningCombination has three Locations.
      */
-
-    void checkValidity(GameBoard, string);
+    
+    void checkValidity(const GameBoard&, string);
     /*
      *Description: Ensures that the WinningCombination is "valid". A WinningCombination
      *             is considered to be valid if only one player(Computer or Player) occupies
@@ -59,22 +69,38 @@ public:
      *              be passed in.
      *Postcondition: The WinningCombination is either valid or invalid..
      */
-
+    
+    void addStone(const Location&, bool);
+    /*
+     *Description: Records a single move onto one of the WinningCombination's Locations. A move by the
+     *             owner of the combination advances its rank; a move by the other side invalidates it.
+     *Precondition: The Location's coordinates and locationId are set and it belongs to this combination.
+     *              The bool parameter is true when the owner made the move.
+     *Postcondition: The matching Location is marked used and the rank or validity is updated.
+     */
+    
     void setRank(int);
     /*
      *Description: Mutator function that updates the local variable 'rank'
-     *Precondition: The int parameter must be between 0 and 2, inclusive.
-     *              Error message is displayed if an incorrect value is entered.
+     *Precondition: The int parameter must be between 0 and the number of Locations, inclusive.
+     *              An out of range value is ignored.
      *Postcondition: The 'rank' is updated.
      */
-
+    
+    void reset();
+    /*
+     *Description: Returns the WinningCombination to its empty-board state
+     *Precondition:  N/A
+     *Postcondition: Rank is 0, the combination is valid and none of its Locations is marked used.
+     */
+    
     void resetRank();
     /*
      *Description: Resets the rank of WinningCombination.
      *Precondition:  N/A
      *Postcondition: Rank of WinningCombination is 0.
      */
-
+    
     void setValidity(bool);
     /*
      *Description: Mutator function that updates the local bool variable 'isValid'
@@ -96,11 +122,11 @@ public:
      *Postcondition: Value of 'rank' variable is returned.
      */
     
-    vector<Location> getLocationSet();
+    const vector<Location>& getLocationSet() const;
     /*
-     *Description: Accessor function that returns 3 Location of the WinningCombination
+     *Description: Accessor function that returns the Locations of the WinningCombination
      *Precondition:  N/A
-     *Postcondition: A vector containing the 3 Locations are returned.
+     *Postcondition: A reference to the k Locations is returned; nothing is copied.
      */
     
     bool getValidity();
@@ -111,7 +137,7 @@ public:
      */
 
 private:
-    vector<Location> locationSet; //Stores the WinningCombination's 3 Locations
+    vector<Location> locationSet; //Stores the WinningCombination's k Locations
     bool isValid; //Stores the validity of the WinningCombination
     int rank; //Stores the rank of the WinningCombination
 };
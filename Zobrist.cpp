@@ -0,0 +1,53 @@
+/************************************************************************************
+ Title:         Zobrist.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   The implementation of Zobrist.h. The keys are a SplitMix64 sequence from a
+                fixed seed, computed at compile time.
+ 
+ Purpose:       Provides the keys shared by GameBoard, the searches and the transposition
+                table.
+ 
+ Usage:         Zobrist::getKey(side, cell)
+ 
+ Build with:    Compile with main.cpp. Requires C++17.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+
+#include "Zobrist.h"
+using namespace std;
+
+namespace {
+
+constexpr uint64_t splitMix(uint64_t& state)
+{
+    state += 0x9E3779B97F4A7C15ULL;
+    uint64_t z = state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+}
+
+/*
+ *Description: Generates the keys from a fixed seed
+ *Precondition: N/A
+ *Postcondition: Returns the key table
+ */
+constexpr Zobrist::KeyTable Zobrist::buildTable()
+{
+    KeyTable table = {};
+    uint64_t state = 0x5A0B1C2D3E4F6071ULL;
+    for(int side = 0; side < 2; side++)
+        for(int cell = 0; cell < CellMask::CAPACITY; cell++)
+            table.keys[side][cell] = splitMix(state);
+    table.sideKey = splitMix(state);
+    return table;
+}
+
+const Zobrist::KeyTable Zobrist::TABLE = Zobrist::buildTable();
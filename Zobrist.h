@@ -0,0 +1,75 @@
+/************************************************************************************
+ Title:         Zobrist.h
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   Fixed random keys for Zobrist hashing. A position's hash is the XOR of the
+                keys of its occupied cells, so a move updates the hash with a single XOR.
+ 
+ Purpose:       Provides the keys shared by GameBoard, the searches and the transposition
+                table. The keys are generated from a fixed seed, so hashes are identical
+                across runs and can be stored in files.
+ 
+ Usage:         hash ^= Zobrist::getKey(side, cell);
+                Side 0 is 'X'(or, inside a search, the side to move at the root) and side 1
+                is 'O'(or its opponent). getSideKey() marks which side is to move.
+ 
+ Build with:    Compile with main.cpp.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+#ifndef TicTacToe_Zobrist_h
+#define TicTacToe_Zobrist_h
+
+#include "CellMask.h"
+#include <cstdint>
+using namespace std;
+
+class Zobrist {
+
+public:
+    static uint64_t getKey(int, int);
+    /*
+     *Description: Returns the key of a stone of the supplied side on the supplied cell
+     *Precondition: side is 0 or 1 and 0 <= cell < CellMask::CAPACITY
+     *Postcondition: The same 64-bit key is returned in every run
+     */
+    
+    static uint64_t getSideKey();
+    /*
+     *Description: Returns the key XORed into a hash when side 1 is to move
+     *Precondition: N/A
+     *Postcondition: A 64-bit key is returned
+     */
+    
+    static const int MAX_SYMMETRIES = 8; //Rotations and reflections of a square board
+
+private:
+    struct KeyTable {
+        uint64_t keys[2][CellMask::CAPACITY]; //Key of each side on each cell
+        uint64_t sideKey; //Key of side 1 being to move
+    };
+    
+    static constexpr KeyTable buildTable();
+    /*
+     *Description: Generates the keys from a fixed seed
+     *Precondition: N/A
+     *Postcondition: Returns the key table
+     */
+    
+    static const KeyTable TABLE; //Constant-initialized in Zobrist.cpp
+};
+
+//Every move of every search looks up keys, so the accessors are defined here
+inline uint64_t Zobrist::getKey(int side, int cell)
+{
+    return TABLE.keys[side][cell];
+}
+
+inline uint64_t Zobrist::getSideKey()
+{
+    return TABLE.sideKey;
+}
+#endif
@@ -0,0 +1,114 @@
+/************************************************************************************
+ Title:         analyze.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   Command line driver for LogAnalyzer.
+ 
+ Purpose:       Replays 3x3 game logs written by selfplay --record on all cores and
+                reports how often each side blundered against perfect play.
+ 
+ Usage:         analyze [--threads T] [--json] file...
+                Defaults: one thread per core, text output. --json prints one JSON
+                object instead.
+ 
+ Build with:    make analyze. Linux only.
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+#include "LogAnalyzer.h"
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+int main(int argc, char* argv[])
+{
+    int threads = 0;
+    bool json = false;
+    vector<string> paths;
+    
+    for(int i = 1; i < argc; i++)
+    {
+        string option = argv[i];
+        if(option == "--threads" && i + 1 < argc)
+            threads = atoi(argv[++i]);
+        else if(option == "--json")
+            json = true;
+        else if(option.size() > 1 && option[0] == '-')
+        {
+            paths.clear();
+            break;
+        }
+        else
+            paths.push_back(option);
+    }
+    if(paths.empty())
+    {
+        cerr << "Usage: " << argv[0] << " [--threads T] [--json] file..." << endl;
+        return 1;
+    }
+    
+    LogAnalyzer analyzer;
+    for(size_t i = 0; i < paths.size(); i++)
+    {
+        string error;
+        if(!analyzer.addFile(paths[i], error))
+        {
+            cerr << paths[i] << ": " << error << endl;
+            return 1;
+        }
+    }
+    
+    LogAnalysis analysis = analyzer.run(threads);
+    const char* sides[] = { "X", "O" };
+    double gamesPerSecond = analysis.seconds > 0 ? analysis.games / analysis.seconds : 0;
+    
+    if(json)
+    {
+        cout << "{\"games\":" << analysis.games << ",\"x_won\":" << analysis.results[GameRecord::X_WON]
+             << ",\"o_won\":" << analysis.results[GameRecord::O_WON] << ",\"draws\":" << analysis.results[GameRecord::DRAW]
+             << ",\"unfinished\":" << analysis.results[GameRecord::UNFINISHED];
+        for(int side = 0; side < 2; side++)
+        {
+            cout << ",\"" << sides[side] << "\":{\"moves\":" << analysis.moves[side];
+            for(int kind = 0; kind < LogAnalyzer::BLUNDER_KINDS; kind++)
+            {
+                string name = LogAnalyzer::getBlunderName(static_cast<LogAnalyzer::Blunder>(kind));
+                for(size_t c = 0; c < name.size(); c++)
+                    if(name[c] == ' ')
+                        name[c] = '_';
+                cout << ",\"" << name << "\":" << analysis.blunders[side][kind];
+            }
+            cout << "}";
+        }
+        cout << ",\"invalid_games\":" << analysis.invalidGames << ",\"damaged_blocks\":" << analysis.damagedBlocks
+             << ",\"seconds\":" << analysis.seconds << ",\"games_per_sec\":" << static_cast<long>(gamesPerSecond) << "}" << endl;
+    }
+    else
+    {
+        cout << "games " << analysis.games << "  X won " << analysis.results[GameRecord::X_WON]
+             << "  O won " << analysis.results[GameRecord::O_WON] << "  draws " << analysis.results[GameRecord::DRAW]
+             << "  unfinished " << analysis.results[GameRecord::UNFINISHED] << endl;
+        for(int side = 0; side < 2; side++)
+        {
+            long moves = analysis.moves[side];
+            long blunders = analysis.getBlunders(side);
+            cout << sides[side] << ": " << moves << " moves, " << blunders << " blunders ("
+                 << fixed << setprecision(3) << (moves > 0 ? 100.0 * blunders / moves : 0.0) << "%)" << endl;
+            for(int kind = 0; kind < LogAnalyzer::BLUNDER_KINDS; kind++)
+                cout << "  " << left << setw(20) << LogAnalyzer::getBlunderName(static_cast<LogAnalyzer::Blunder>(kind))
+                     << right << analysis.blunders[side][kind] << endl;
+        }
+        if(analysis.invalidGames > 0 || analysis.damagedBlocks > 0)
+            cout << "invalid games " << analysis.invalidGames << "  damaged blocks " << analysis.damagedBlocks << endl;
+        cout << setprecision(3) << "seconds " << analysis.seconds << "  games/sec " << static_cast<long>(gamesPerSecond)
+             << "  MB/s " << (analysis.seconds > 0 ? analysis.bytes / analysis.seconds / 1e6 : 0.0) << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,312 @@
+/************************************************************************************
+ Title:         bench.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   Micro-benchmarks of the engine's hot paths on fixed position corpora.
+ 
+ Purpose:       Measures GameBoard::makeMove, GameBoard::updateGameStatus,
+                WinningCombination::checkValidity, Computer::updateCombinations and
+                Computer::chooseNextMove in isolation and reports ns/op, allocations/op
+                and ops/s. BatchEvaluator is measured at each instruction set level.
+ 
+ Usage:         bench [--json] [--time seconds] [--filter text] [--check-allocations]
+                --json prints one JSON object per line instead of a text table.
+                --check-allocations makes the exit status 1 if any Computer::chooseNextMove
+                measurement allocates: once a Computer has played on a board, its
+                single-threaded decisions must make no heap allocations.
+                The corpora are the positions of random games played from a fixed seed,
+                so every run measures the same positions.
+ 
+ Build with:    make bench
+ 
+ Modifications: Added the BatchEvaluator levels.
+                Added the Monte Carlo search.
+                Added Computer construction and the GameServer's session creation.
+                Added GameRecord encoding and decoding.
+                Added the 4x4x4 cube and the alpha-beta search.
+                Added --check-allocations.
+ ***********************************************************************************/
+#include "AllocationCounter.h"
+#include "BatchEvaluator.h"
+#include "Benchmark.h"
+#include "BoardGeometry.h"
+#include "Computer.h"
+#include "GameBoard.h"
+#include "GameRecord.h"
+#include "GameServer.h"
+#include "Random.h"
+#include "WinningCombination.h"
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static const long MONTE_CARLO_PLAYOUTS = 1000; //Budget of the measured Monte Carlo searches
+static const int MONTE_CARLO_POSITIONS = 64; //Positions the Monte Carlo search is measured on
+static const int ALPHA_BETA_POSITIONS = 64; //Positions the alpha-beta search is measured on beyond 3x3
+
+//One position of a corpus: the board, whose turn it is and the move that was played next
+struct CorpusPosition {
+    GameBoard board;
+    GameBoard afterMove;
+    string toMove;
+    int side; //Side index of toMove
+    Location nextMove;
+    int nextCell;
+    
+    CorpusPosition(const GameBoard& before) : board(before), afterMove(before) {}
+};
+
+//Positions of random games on the supplied board, game after game in move order
+static vector<CorpusPosition> buildCorpus(const BoardGeometry& geometry, int positions, uint64_t seed)
+{
+    vector<CorpusPosition> corpus;
+    Random random(seed);
+    
+    while(static_cast<int>(corpus.size()) < positions)
+    {
+        GameBoard board(geometry);
+        board.setPlayerID("X");
+        string toMove = "X";
+        while(!board.getGameStatus() && static_cast<int>(corpus.size()) < positions)
+        {
+            CellMask empty = board.getEmptyMask();
+            int cell = empty.nth(random.nextInt(empty.count()));
+            
+            CorpusPosition position(board);
+            position.toMove = toMove;
+            position.side = GameBoard::getSide(toMove);
+            position.nextCell = cell;
+            position.nextMove = geometry.getLocation(cell);
+            position.afterMove.makeMove(position.nextMove, position.side);
+            corpus.push_back(position);
+            
+            board.makeMove(position.nextMove, position.side);
+            toMove = GameBoard::getOtherID(toMove);
+        }
+    }
+    return corpus;
+}
+
+static string boardName(const BoardGeometry& geometry)
+{
+    ostringstream name;
+    name << geometry.getWidth() << "x" << geometry.getHeight();
+    if(geometry.getLayerCount() > 1)
+        name << "x" << geometry.getLayerCount();
+    name << "k" << geometry.getWinLength();
+    return name.str();
+}
+
+int main(int argc, char* argv[])
+{
+    bool json = false;
+    double seconds = 0.2;
+    string filter;
+    bool checkAllocations = false;
+    int allocatingDecisions = 0;
+    
+    for(int i = 1; i < argc; i++)
+    {
+        string option = argv[i];
+        if(option == "--json")
+            json = true;
+        else if(option == "--time" && i + 1 < argc)
+            seconds = atof(argv[++i]);
+        else if(option == "--filter" && i + 1 < argc)
+            filter = argv[++i];
+        else if(option == "--check-allocations")
+            checkAllocations = true;
+        else
+        {
+            cerr << "Usage: " << argv[0] << " [--json] [--time seconds] [--filter text] [--check-allocations]" << endl;
+            return 1;
+        }
+    }
+    
+    Benchmark bench(seconds);
+    volatile long sink = 0; //Keeps results alive so the work is not optimized away
+    
+    const BoardGeometry* geometries[] = {
+        &BoardGeometry::classic(), &BoardGeometry::get(4, 4, 4, 4), &BoardGeometry::get(15, 15, 5)
+    };
+    const int corpusSizes[] = { 2048, 1024, 1024 };
+    
+    for(int g = 0; g < 3; g++)
+    {
+        const BoardGeometry& geometry = *geometries[g];
+        string board = boardName(geometry);
+        vector<CorpusPosition> corpus = buildCorpus(geometry, corpusSizes[g], 20140216);
+        long size = static_cast<long>(corpus.size());
+        
+        //Every result goes through here
+        auto report = [&](const string& name, long opsPerCall, const function<void()>& body) {
+            if(!filter.empty() && (name + " " + board).find(filter) == string::npos)
+                return;
+            BenchmarkResult result = bench.measure(name, board, opsPerCall, body);
+            cout << (json ? Benchmark::toJson(result) : Benchmark::toText(result)) << endl;
+            if(checkAllocations && name.compare(0, 24, "Computer::chooseNextMove") == 0 && result.allocationsPerOp > 0)
+            {
+                cerr << "allocating decision: " << name << " " << board << endl;
+                allocatingDecisions++;
+            }
+        };
+        
+        report("GameBoard copy", size, [&]() {
+            for(long i = 0; i < size; i++)
+            {
+                GameBoard copy = corpus[i].board;
+                sink += copy.getEmptyCount();
+            }
+        });
+        
+        report("GameBoard::makeMove (with copy)", size, [&]() {
+            for(long i = 0; i < size; i++)
+            {
+                GameBoard copy = corpus[i].board;
+                sink += copy.makeMove(corpus[i].nextMove, corpus[i].side);
+            }
+        });
+        
+        report("GameBoard::updateGameStatus", size, [&]() {
+            for(long i = 0; i < size; i++)
+                Benchmark::updateGameStatus(corpus[i].afterMove, corpus[i].nextCell, corpus[i].side);
+        });
+        
+        //The whole corpus as one batch, at each level the processor supports
+        if(geometry.isClassic())
+        {
+            PositionBatch batch;
+            for(long i = 0; i < size; i++)
+                batch.add(corpus[i].afterMove);
+            vector<unsigned char> status(batch.size());
+            
+            for(int level = BatchEvaluator::SCALAR; level <= BatchEvaluator::getBestLevel(); level++)
+                report("BatchEvaluator::evaluate[" + BatchEvaluator::getLevelName(static_cast<BatchEvaluator::Level>(level)) + "]",
+                       size, [&]() {
+                    BatchEvaluator::evaluate(batch.xMasks.data(), batch.oMasks.data(), status.data(), batch.size(),
+                                             static_cast<BatchEvaluator::Level>(level));
+                    sink += status[0];
+                });
+        }
+        
+        //The corpus games as records, encoded one after another as a writer does
+        vector<GameRecord> records(1);
+        for(long i = 0; i < size; i++)
+        {
+            records.back().addMove(corpus[i].nextCell);
+            if(corpus[i].afterMove.getGameStatus())
+            {
+                records.back().setResult(corpus[i].afterMove);
+                records.push_back(GameRecord());
+            }
+        }
+        records.pop_back();
+        long recordCount = static_cast<long>(records.size());
+        int bitsPerCell = GameRecord::getBitsPerCell(geometry);
+        vector<unsigned char> encoded;
+        
+        report("GameRecord::encode", recordCount, [&]() {
+            encoded.clear();
+            for(long i = 0; i < recordCount; i++)
+                records[i].encode(bitsPerCell, encoded);
+            sink += encoded.size();
+        });
+        
+        report("GameRecord::decode", recordCount, [&]() {
+            GameRecord record;
+            const unsigned char* next = encoded.data();
+            for(long i = 0; i < recordCount; i++)
+            {
+                record.decode(next, encoded.data() + encoded.size(), bitsPerCell);
+                sink += record.getMoveCount();
+            }
+        });
+        
+        //One WinningCombination per line, validated against every position
+        vector<WinningCombination> combinations;
+        for(int line = 0; line < geometry.getLineCount(); line++)
+        {
+            vector<Location> locations;
+            for(int i = 0; i < geometry.getWinLength(); i++)
+                locations.push_back(geometry.getLocation(geometry.getLineCells(line)[i]));
+            combinations.push_back(WinningCombination(locations));
+        }
+        long checkPositions = min(size, 4096L / geometry.getLineCount() + 1);
+        report("WinningCombination::checkValidity", checkPositions * geometry.getLineCount(), [&]() {
+            for(long i = 0; i < checkPositions; i++)
+                for(size_t c = 0; c < combinations.size(); c++)
+                {
+                    combinations[c].resetRank();
+                    combinations[c].setValidity(true);
+                    combinations[c].checkValidity(corpus[i].board, corpus[i].toMove);
+                    sink += combinations[c].getRank();
+                }
+        });
+        
+        //A session that is created and resigned at once, as a client would
+        if(geometry.isClassic())
+        {
+            report("Computer construction", 1, [&]() {
+                Computer computer;
+                sink += computer.getStrategy();
+            });
+            
+            GameServer server(Computer::TABLE, 1);
+            string newCommand = "NEW O";
+            report("GameServer::execute[NEW + RESIGN]", 1, [&]() {
+                bool closeConnection;
+                string reply = server.execute(newCommand, closeConnection);
+                string resignCommand = "RESIGN " + reply.substr(3, reply.find(' ', 3) - 3);
+                sink += server.execute(resignCommand, closeConnection).size();
+            });
+        }
+        
+        //Positions arrive in game order, as they do during play, so each call records one new move
+        Computer tracker;
+        report("Computer::updateCombinations", size, [&]() {
+            for(long i = 0; i < size; i++)
+                Benchmark::updateCombinations(tracker, corpus[i].board, "O", "X");
+        });
+        
+        //A Computer always plays one side, so it sees every other position of each game
+        vector<long> oToMove;
+        for(long i = 0; i < size; i++)
+            if(corpus[i].toMove == "O")
+                oToMove.push_back(i);
+        
+        for(int s = 0; s < Computer::STRATEGY_COUNT; s++)
+        {
+            Computer::Strategy strategy = static_cast<Computer::Strategy>(s);
+            if(strategy != Computer::HEURISTIC && strategy != Computer::MONTE_CARLO && strategy != Computer::ALPHA_BETA
+               && !geometry.isClassic())
+                continue;
+            
+            //The Monte Carlo search runs a small fixed budget on the first positions only
+            Computer computer;
+            computer.setStrategy(strategy);
+            computer.getMonteCarloSearch().setPlayouts(MONTE_CARLO_PLAYOUTS);
+            size_t positions = oToMove.size();
+            string name = "Computer::chooseNextMove[" + Computer::getStrategyName(strategy) + "]";
+            if(strategy == Computer::MONTE_CARLO)
+            {
+                positions = min(positions, static_cast<size_t>(MONTE_CARLO_POSITIONS));
+                name = "Computer::chooseNextMove[mcts " + to_string(MONTE_CARLO_PLAYOUTS) + " playouts]";
+            }
+            if(strategy == Computer::ALPHA_BETA && !geometry.isClassic())
+                positions = min(positions, static_cast<size_t>(ALPHA_BETA_POSITIONS));
+            report(name, static_cast<long>(positions), [&]() {
+                for(size_t i = 0; i < positions; i++)
+                    sink += computer.chooseNextMove(corpus[oToMove[i]].board, "O").x;
+            });
+        }
+    }
+    return allocatingDecisions > 0 ? 1 : 0;
+}
@@ -5,58 +5,53 @@
  
  Created On:    February 16, 2014
  
- Description:   Invokes Location, Computer, and GameBoard classes create a game
-                of Tic-Tac-Toe
+ Description:   Starts an interactive game of Tic-Tac-Toe on the console
  
- Purpose:       A Driver class to test the functionality of all the classes.
+ Purpose:       A Driver class that hands control to the ConsoleGame front end.
  
- Usage:         Initialize the GameBoard and Computer objects.
+ Usage:         Run the executable and follow the prompts. Optional arguments select another
+                board size: tictactoe [width height winLength [layers]]
+                tictactoe 4 4 4 4 plays on the 4x4x4 Qubic cube.
  
  Build with:    Written with Xcode on OS X 10.8.5 .
  
- Modifications: N/A
+ Modifications: The game loop moved to ConsoleGame so that GameBoard and Computer stay
+                free of console I/O.
+                Added optional board size arguments.
+                Added an optional number of layers.
  ***********************************************************************************/
-#include <iostream>
-#include "Location.h"
-#include "Computer.h"
-#include "GameBoard.h"
+#include "ConsoleGame.h"
+#include "BoardGeometry.h"
+#include <cstdlib>
+#include <stdexcept>
 
 using namespace std;
 
-int main()
+int main(int argc, char* argv[])
 {
-    //Creates instances of the Computer, the GameBoard, and the Location
-    Computer cpu;
-    GameBoard gameBoard;
-    Location player;//Holds Player's moves
-    
-    char ans;
-    
-    //Asks user whether they like 'X' or 'O'
-    gameBoard.setPlayerID();
+    if(argc == 1)
+    {
+        ConsoleGame game;
+        game.play();
+        return 0;
+    }
     
-    //Asks user if they want the first move
-    cout << "Would you like to go first(y/n): ";
-    cin >> ans;
+    if(argc != 4 && argc != 5)
+    {
+        cerr << "Usage: " << argv[0] << " [width height winLength [layers]]" << endl;
+        return 1;
+    }
     
-    if(ans == 'y' || ans == 'Y')
+    try
     {
-        //Gets the Player's move, enter it to the game board, and then draw the board
-        player = gameBoard.getPlayerMove();
-        gameBoard.makeMove(player, gameBoard.getPlayerID());
-        gameBoard.drawBoard();
+        int layers = (argc == 5) ? atoi(argv[4]) : 1;
+        ConsoleGame game(BoardGeometry::get(atoi(argv[1]), atoi(argv[2]), atoi(argv[3]), layers));
+        game.play();
     }
-    while( !gameBoard.getGameStatus())
+    catch(const invalid_argument& error)
     {
-        //Allows the computer to select the move and, enter it to the game board, and then draw the board
-        gameBoard.makeMove(cpu.chooseNextMove(gameBoard), gameBoard.getComputerID());
-        gameBoard.drawBoard();
-        
-        player = gameBoard.getPlayerMove();
-        gameBoard.makeMove(player, gameBoard.getPlayerID());
-        gameBoard.drawBoard();
+        cerr << error.what() << endl;
+        return 1;
     }
-    //Display the result of the game Player, Computer, or Tie
-    gameBoard.displayGameStatus();
+    return 0;
 }
-
@@ -0,0 +1,108 @@
+/************************************************************************************
+ Title:         makebook.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   Command line driver for OpeningBookBuilder.
+ 
+ Purpose:       Builds an opening book from game logs written by selfplay --record.
+ 
+ Usage:         makebook [--plies N] [--min-games M] output.book input...
+                Defaults: the first 8 plies of each game, moves played in at least 2
+                games. Every input must hold games of the same board size.
+ 
+ Build with:    make makebook
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+#include "GameRecordReader.h"
+#include "OpeningBook.h"
+#include "OpeningBookBuilder.h"
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+int main(int argc, char* argv[])
+{
+    int plies = 8;
+    long minimumGames = 2;
+    vector<string> paths;
+    
+    for(int i = 1; i < argc; i++)
+    {
+        string option = argv[i];
+        if(option == "--plies" && i + 1 < argc)
+            plies = atoi(argv[++i]);
+        else if(option == "--min-games" && i + 1 < argc)
+            minimumGames = atol(argv[++i]);
+        else if(option.size() > 1 && option[0] == '-')
+        {
+            paths.clear();
+            break;
+        }
+        else
+            paths.push_back(option);
+    }
+    if(paths.size() < 2)
+    {
+        cerr << "Usage: " << argv[0] << " [--plies N] [--min-games M] output.book input..." << endl;
+        return 1;
+    }
+    
+    unique_ptr<OpeningBookBuilder> builder;
+    const BoardGeometry* geometry = 0;
+    long skipped = 0;
+    for(size_t i = 1; i < paths.size(); i++)
+    {
+        GameRecordReader reader;
+        string error;
+        if(!reader.open(paths[i], error))
+        {
+            cerr << paths[i] << ": " << error << endl;
+            return 1;
+        }
+        if(!builder)
+        {
+            geometry = &reader.getGeometry();
+            builder.reset(new OpeningBookBuilder(*geometry, plies));
+        }
+        else if(&reader.getGeometry() != geometry)
+        {
+            cerr << paths[i] << ": games of another board size" << endl;
+            return 1;
+        }
+        
+        GameRecord record;
+        while(reader.next(record))
+            if(!builder->add(record))
+                skipped++;
+        if(!reader.getError().empty())
+        {
+            cerr << paths[i] << ": " << reader.getError() << endl;
+            return 1;
+        }
+    }
+    
+    string error;
+    if(!builder->write(paths[0], minimumGames, error))
+    {
+        cerr << paths[0] << ": " << error << endl;
+        return 1;
+    }
+    
+    OpeningBook book;
+    if(!book.open(paths[0], error))
+    {
+        cerr << paths[0] << ": " << error << endl;
+        return 1;
+    }
+    cout << "games " << builder->getGameCount() << "  skipped " << skipped << "  position moves "
+         << builder->getMoveCount() << "  book entries " << book.getEntryCount() << endl;
+    return 0;
+}
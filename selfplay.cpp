@@ -0,0 +1,245 @@
+/************************************************************************************
+ Title:         selfplay.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   Command line driver for SelfPlay.
+ 
+ Purpose:       Plays N games of an engine against another engine or a random mover on
+                all cores and reports the engine's wins, draws, losses and games per second.
+ 
+ Usage:         selfplay [--games N] [--threads T] [--seed S]
+                         [--engine heuristic|negamax|table|mcts|alphabeta]
+                         [--opponent heuristic|negamax|table|mcts|alphabeta|random]
+                         [--size width height winLength] [--layers L] [--depth D] [--deadline ms]
+                         [--playouts N] [--movetime ms] [--search-threads T] [--mode tree|root]
+                         [--record file] [--book file] [--network file] [--stats [ms]]
+                Defaults: 100000 games, one thread per core, seed 1, heuristic vs random, 3x3.
+                The last four options set the budget of mcts engines(20000 playouts, no
+                time limit, one search thread, tree mode by default). --record logs every
+                game to a binary record file(see GameRecord.h); --book lets the engine
+                play from an opening book built by makebook. --layers stacks the board into
+                a cube(--size 4 4 4 --layers 4 is Qubic); --depth sets the depth of alphabeta
+                engines(4 by default). --deadline makes both engines answer every move within
+                that many milliseconds, searching one depth deeper at a time(see
+                Computer::chooseNextMove); heuristic engines then search as alphabeta does.
+                --search-threads also sets the threads of alphabeta engines, which then run
+                a lazy SMP search(see AlphaBetaSearch.h). --stats records every decision of
+                the engine and prints its latency percentiles, counters and the positions
+                that took longer than the optional budget in milliseconds(see EngineStats.h).
+                --network makes an alphabeta engine evaluate with an n-tuple network
+                written by the train program(see NTupleNetwork.h); the network is only
+                used at depths up to 2 without --deadline, where it beats the line weights.
+ 
+ Build with:    Compile with SelfPlay.cpp and the engine sources. Requires -pthread.
+ 
+ Modifications: Added the mcts engine and its budget options.
+                Added --record and --book.
+                Added --layers and --depth.
+                Added --deadline.
+                --search-threads applies to alphabeta engines.
+                Added --stats.
+                Added --network.
+                Warns when the depth or deadline leaves --network unused.
+ ***********************************************************************************/
+#include "AllocationCounter.h"
+#include "BoardGeometry.h"
+#include "Computer.h"
+#include "EngineStats.h"
+#include "GameRecordWriter.h"
+#include "NTupleNetwork.h"
+#include "OpeningBook.h"
+#include "SelfPlay.h"
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+int main(int argc, char* argv[])
+{
+    long games = 100000;
+    int threads = 0;
+    uint64_t seed = 1;
+    string engineName = "heuristic";
+    string opponentName = "random";
+    int width = 3, height = 3, winLength = 3, layers = 1;
+    int depth = AlphaBetaSearch::DEFAULT_DEPTH;
+    double deadline = 0;
+    long playouts = MonteCarloSearch::DEFAULT_PLAYOUTS;
+    double moveTime = 0;
+    int searchThreads = 1;
+    MonteCarloSearch::Mode mode = MonteCarloSearch::TREE;
+    string recordPath;
+    string bookPath;
+    string networkPath;
+    bool recordStats = false;
+    double latencyBudget = 0;
+    
+    for(int i = 1; i < argc; i++)
+    {
+        string option = argv[i];
+        bool hasValue = i + 1 < argc;
+        if(option == "--games" && hasValue)
+            games = atol(argv[++i]);
+        else if(option == "--threads" && hasValue)
+            threads = atoi(argv[++i]);
+        else if(option == "--seed" && hasValue)
+            seed = strtoull(argv[++i], 0, 10);
+        else if(option == "--engine" && hasValue)
+            engineName = argv[++i];
+        else if(option == "--opponent" && hasValue)
+            opponentName = argv[++i];
+        else if(option == "--playouts" && hasValue)
+            playouts = atol(argv[++i]);
+        else if(option == "--movetime" && hasValue)
+            moveTime = atof(argv[++i]);
+        else if(option == "--search-threads" && hasValue)
+            searchThreads = atoi(argv[++i]);
+        else if(option == "--mode" && hasValue && MonteCarloSearch::parseMode(argv[i + 1], mode))
+            i++;
+        else if(option == "--record" && hasValue)
+            recordPath = argv[++i];
+        else if(option == "--book" && hasValue)
+            bookPath = argv[++i];
+        else if(option == "--network" && hasValue)
+            networkPath = argv[++i];
+        else if(option == "--layers" && hasValue)
+            layers = atoi(argv[++i]);
+        else if(option == "--depth" && hasValue)
+            depth = atoi(argv[++i]);
+        else if(option == "--deadline" && hasValue)
+            deadline = atof(argv[++i]);
+        else if(option == "--stats")
+        {
+            recordStats = true;
+            if(hasValue && isdigit(static_cast<unsigned char>(argv[i + 1][0])))
+                latencyBudget = atof(argv[++i]);
+        }
+        else if(option == "--size" && i + 3 < argc)
+        {
+            width = atoi(argv[++i]);
+            height = atoi(argv[++i]);
+            winLength = atoi(argv[++i]);
+        }
+        else
+        {
+            cerr << "Usage: " << argv[0] << " [--games N] [--threads T] [--seed S]"
+                 << " [--engine STRATEGY] [--opponent STRATEGY|random] [--size W H K] [--layers L] [--depth D]"
+                 << " [--deadline ms]"
+                 << " [--playouts N] [--movetime ms] [--search-threads T] [--mode tree|root]"
+                 << " [--record file] [--book file] [--network file] [--stats [ms]]" << endl;
+            return 1;
+        }
+    }
+    
+    try
+    {
+        const BoardGeometry& geometry = BoardGeometry::get(width, height, winLength, layers);
+        SelfPlay selfPlay(geometry);
+        selfPlay.setSearchBudget(playouts, moveTime, searchThreads, mode);
+        selfPlay.setSearchDepth(depth);
+        selfPlay.setMoveTime(deadline);
+        
+        EngineStats stats;
+        if(recordStats)
+        {
+            stats.setLatencyBudget(latencyBudget);
+            EngineStats::setAllocationCounter(AllocationCounter::getThreadCount);
+            selfPlay.setStats(&stats);
+        }
+        
+        GameRecordWriter recorder;
+        if(!recordPath.empty())
+        {
+            string error;
+            if(!recorder.open(recordPath, geometry, error))
+            {
+                cerr << "Cannot write " << recordPath << ": " << error << endl;
+                return 1;
+            }
+            selfPlay.setRecorder(&recorder);
+        }
+        
+        OpeningBook book;
+        if(!bookPath.empty())
+        {
+            string error;
+            if(!book.open(bookPath, error))
+            {
+                cerr << "Cannot read " << bookPath << ": " << error << endl;
+                return 1;
+            }
+            selfPlay.setOpeningBook(&book);
+        }
+        
+        NTupleNetwork network;
+        if(!networkPath.empty())
+        {
+            string error;
+            if(!network.open(networkPath, error))
+            {
+                cerr << "Cannot read " << networkPath << ": " << error << endl;
+                return 1;
+            }
+            if(!network.matches(geometry))
+            {
+                cerr << networkPath << " was trained on another board size" << endl;
+                return 1;
+            }
+            selfPlay.setNetwork(&network);
+            if(depth > AlphaBetaSearch::NETWORK_MAX_DEPTH || deadline > 0)
+                cerr << "The network only evaluates searches of depth " << AlphaBetaSearch::NETWORK_MAX_DEPTH
+                     << " or less without --deadline; the engine keeps the line weights" << endl;
+        }
+        
+        Computer::Strategy strategy;
+        if(!Computer::parseStrategy(engineName, strategy))
+        {
+            cerr << "Unknown engine: " << engineName << endl;
+            return 1;
+        }
+        selfPlay.setEngine(strategy);
+        
+        if(opponentName == "random")
+            selfPlay.setRandomOpponent();
+        else if(Computer::parseStrategy(opponentName, strategy))
+            selfPlay.setOpponent(strategy);
+        else
+        {
+            cerr << "Unknown opponent: " << opponentName << endl;
+            return 1;
+        }
+        
+        SelfPlayResult result = selfPlay.run(games, seed, threads);
+        
+        cout << "board " << width << "x" << height << (layers > 1 ? "x" + to_string(layers) : "") << " k=" << winLength
+             << "  " << engineName << " vs " << opponentName << "  seed " << seed << endl;
+        cout << "wins " << result.wins << "  draws " << result.draws << "  losses " << result.losses << endl;
+        cout << "games " << result.getGames() << "  seconds " << result.seconds
+             << "  games/sec " << static_cast<long>(result.getGamesPerSecond()) << endl;
+        if(recordStats)
+            cout << stats.toText();
+        
+        if(!recordPath.empty())
+        {
+            if(!recorder.close())
+            {
+                cerr << "Cannot write " << recordPath << endl;
+                return 1;
+            }
+            cout << "recorded " << recorder.getGameCount() << " games to " << recordPath << endl;
+        }
+    }
+    catch(const invalid_argument& error)
+    {
+        cerr << error.what() << endl;
+        return 1;
+    }
+    return 0;
+}
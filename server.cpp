@@ -0,0 +1,132 @@
+/************************************************************************************
+ Title:         server.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   Command line driver for GameServer.
+ 
+ Purpose:       Runs the engine as a local game server that hosts many concurrent games
+                over a line protocol(see GameServer.h).
+ 
+ Usage:         server [--port N | --unix path] [--threads T] [--engine STRATEGY] [--seed S]
+                       [--book file] [--movetime ms] [--stats ms]
+                Defaults: TCP port 7373 on 127.0.0.1, one worker per core, table strategy
+                (heuristic on boards other than 3x3), seed 1. Stops on SIGINT or SIGTERM.
+                --book serves the opening moves of games of the book's size from an
+                opening book built by makebook. --movetime makes the engine answer every
+                move within that many milliseconds, searching as deep as the time allows.
+                --stats records every decision of the engine for the STATS command and
+                keeps the positions that took longer than that many milliseconds.
+ 
+ Build with:    make server. Linux only.
+ 
+ Modifications: Added --book.
+                Added --movetime.
+                Added --stats.
+ ***********************************************************************************/
+#include "AllocationCounter.h"
+#include "Computer.h"
+#include "EngineStats.h"
+#include "GameServer.h"
+#include "OpeningBook.h"
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+static GameServer* runningServer = 0; //Stopped by the signal handler
+
+static void stopServer(int)
+{
+    if(runningServer)
+        runningServer->stop();
+}
+
+int main(int argc, char* argv[])
+{
+    int port = 7373;
+    string unixPath;
+    int threads = 0;
+    string engineName = "table";
+    uint64_t seed = 1;
+    string bookPath;
+    double moveTime = 0;
+    double latencyBudget = -1;
+    
+    for(int i = 1; i < argc; i++)
+    {
+        string option = argv[i];
+        bool hasValue = i + 1 < argc;
+        if(option == "--port" && hasValue)
+            port = atoi(argv[++i]);
+        else if(option == "--unix" && hasValue)
+            unixPath = argv[++i];
+        else if(option == "--threads" && hasValue)
+            threads = atoi(argv[++i]);
+        else if(option == "--engine" && hasValue)
+            engineName = argv[++i];
+        else if(option == "--seed" && hasValue)
+            seed = strtoull(argv[++i], 0, 10);
+        else if(option == "--book" && hasValue)
+            bookPath = argv[++i];
+        else if(option == "--movetime" && hasValue)
+            moveTime = atof(argv[++i]);
+        else if(option == "--stats" && hasValue)
+            latencyBudget = atof(argv[++i]);
+        else
+        {
+            cerr << "Usage: " << argv[0] << " [--port N | --unix path] [--threads T]"
+                 << " [--engine STRATEGY] [--seed S] [--book file] [--movetime ms]"
+                 << " [--stats ms]" << endl;
+            return 1;
+        }
+    }
+    
+    Computer::Strategy strategy;
+    if(!Computer::parseStrategy(engineName, strategy))
+    {
+        cerr << "Unknown engine: " << engineName << endl;
+        return 1;
+    }
+    
+    GameServer server(strategy, seed);
+    server.setMoveTime(moveTime);
+    EngineStats stats;
+    if(latencyBudget >= 0)
+    {
+        stats.setLatencyBudget(latencyBudget);
+        EngineStats::setAllocationCounter(AllocationCounter::getThreadCount);
+        server.setStats(&stats);
+    }
+    string error;
+    OpeningBook book;
+    if(!bookPath.empty())
+    {
+        if(!book.open(bookPath, error))
+        {
+            cerr << "Cannot read " << bookPath << ": " << error << endl;
+            return 1;
+        }
+        server.setOpeningBook(&book);
+    }
+    
+    bool listening = unixPath.empty() ? server.listenTcp(port, error) : server.listenUnix(unixPath, error);
+    if(!listening)
+    {
+        cerr << "Cannot listen: " << error << endl;
+        return 1;
+    }
+    
+    runningServer = &server;
+    signal(SIGINT, stopServer);
+    signal(SIGTERM, stopServer);
+    
+    cout << "listening on " << (unixPath.empty() ? "127.0.0.1:" + to_string(port) : unixPath) << endl;
+    server.run(threads);
+    cout << "stopped with " << server.getSessionCount() << " games in progress" << endl;
+    return 0;
+}
@@ -0,0 +1,142 @@
+/************************************************************************************
+ Title:         train.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   Command line driver for NTupleTrainer.
+ 
+ Purpose:       Trains an n-tuple network by TD self-play and writes it for the alphabeta
+                engine(see NTupleNetwork.h).
+ 
+ Usage:         train [--size width height winLength] [--layers L] [--games N] [--alpha rate]
+                      [--epsilon probability] [--seed S] [--input file] --output file
+                Defaults: 15x15 with five in a row, 100000 games, learning rate 0.1, random
+                moves 10% of the time, seed 1. --input continues the training of a network
+                written earlier for the same board. The results of every tenth of the games
+                are printed as they finish.
+                selfplay --engine alphabeta --depth 2 --network file plays with the result.
+ 
+ Build with:    make train
+ 
+ Modifications: The usage names a depth at which the network is used.
+ ***********************************************************************************/
+#include "BoardGeometry.h"
+#include "NTupleNetwork.h"
+#include "NTupleTrainer.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+int main(int argc, char* argv[])
+{
+    int width = 15, height = 15, winLength = 5, layers = 1;
+    long games = 100000;
+    double learningRate = NTupleTrainer::DEFAULT_LEARNING_RATE;
+    double exploration = NTupleTrainer::DEFAULT_EXPLORATION;
+    uint64_t seed = 1;
+    string inputPath;
+    string outputPath;
+    
+    for(int i = 1; i < argc; i++)
+    {
+        string option = argv[i];
+        bool hasValue = i + 1 < argc;
+        if(option == "--games" && hasValue)
+            games = atol(argv[++i]);
+        else if(option == "--alpha" && hasValue)
+            learningRate = atof(argv[++i]);
+        else if(option == "--epsilon" && hasValue)
+            exploration = atof(argv[++i]);
+        else if(option == "--seed" && hasValue)
+            seed = strtoull(argv[++i], 0, 10);
+        else if(option == "--input" && hasValue)
+            inputPath = argv[++i];
+        else if(option == "--output" && hasValue)
+            outputPath = argv[++i];
+        else if(option == "--layers" && hasValue)
+            layers = atoi(argv[++i]);
+        else if(option == "--size" && i + 3 < argc)
+        {
+            width = atoi(argv[++i]);
+            height = atoi(argv[++i]);
+            winLength = atoi(argv[++i]);
+        }
+        else
+        {
+            outputPath.clear();
+            break;
+        }
+    }
+    if(outputPath.empty())
+    {
+        cerr << "Usage: " << argv[0] << " [--size W H K] [--layers L] [--games N] [--alpha rate]"
+             << " [--epsilon probability] [--seed S] [--input file] --output file" << endl;
+        return 1;
+    }
+    
+    try
+    {
+        const BoardGeometry& geometry = BoardGeometry::get(width, height, winLength, layers);
+        NTupleTrainer trainer(geometry);
+        trainer.setLearningRate(learningRate);
+        trainer.setExploration(exploration);
+        trainer.setSeed(seed);
+        
+        NTupleNetwork network;
+        network.reset(geometry);
+        string error;
+        if(!inputPath.empty())
+        {
+            if(!network.open(inputPath, error))
+            {
+                cerr << "Cannot read " << inputPath << ": " << error << endl;
+                return 1;
+            }
+            if(!network.matches(geometry))
+            {
+                cerr << inputPath << " was trained on another board size" << endl;
+                return 1;
+            }
+            trainer.readNetwork(network);
+        }
+        
+        cout << "board " << width << "x" << height << (layers > 1 ? "x" + to_string(layers) : "") << " k=" << winLength
+             << "  lines " << geometry.getLineCount() << "  weights " << static_cast<long>(geometry.getLineCount())
+             * network.getTableSize() << "  alpha " << learningRate << "  epsilon " << exploration << endl;
+        
+        //Each report covers the games since the one before
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        long reported[3] = { 0, 0, 0 };
+        for(int part = 1; part <= 10; part++)
+        {
+            trainer.train(games * part / 10 - trainer.getGameCount());
+            long results[3] = { trainer.getXWins(), trainer.getOWins(), trainer.getDraws() };
+            double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            cout << "games " << trainer.getGameCount() << "  X wins " << results[0] - reported[0]
+                 << "  O wins " << results[1] - reported[1] << "  draws " << results[2] - reported[2]
+                 << "  games/sec " << static_cast<long>(seconds > 0 ? trainer.getGameCount() / seconds : 0) << endl;
+            for(int i = 0; i < 3; i++)
+                reported[i] = results[i];
+        }
+        
+        trainer.writeNetwork(network);
+        if(!network.save(outputPath, error))
+        {
+            cerr << "Cannot write " << outputPath << ": " << error << endl;
+            return 1;
+        }
+        cout << "wrote " << outputPath << endl;
+    }
+    catch(const invalid_argument& error)
+    {
+        cerr << error.what() << endl;
+        return 1;
+    }
+    return 0;
+}
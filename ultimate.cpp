@@ -0,0 +1,203 @@
+/************************************************************************************
+ Title:         ultimate.cpp
+ 
+ Author:        Anton Desilva
+ 
+ Created On:    October 17, 2026
+ 
+ Description:   Command line driver for Ultimate Tic-Tac-Toe(see UltimateBoard.h and
+                UltimateSearch.h).
+ 
+ Purpose:       Plays Ultimate Tic-Tac-Toe against the UltimateSearch engine, or measures
+                the engine against random play.
+ 
+ Usage:         ultimate [--movetime ms] [--depth D] [--selfplay N] [--seed S]
+                Without --selfplay the user plays one game on the console, entering the
+                row and column(0-8) of the 9x9 grid. --selfplay plays N games of the engine
+                against random moves, alternating sides, and reports the results with the
+                average depth reached and the positions searched per second.
+                Defaults: 100 milliseconds per move, no depth limit, seed 1.
+ 
+ Build with:    make ultimate
+ 
+ Modifications: N/A
+ ***********************************************************************************/
+#include "Random.h"
+#include "UltimateBoard.h"
+#include "UltimateSearch.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+static const char MARKS[2] = { 'X', 'O' }; //Mark of each side
+
+/*
+ *Description: Prints the 9x9 grid with the sub-boards separated and the playable sub-boards marked
+ *Precondition: N/A
+ *Postcondition: The board is written to standard output
+ */
+static void printBoard(const UltimateBoard& board)
+{
+    cout << "\n    0 1 2   3 4 5   6 7 8\n";
+    for(int row = 0; row < 9; row++)
+    {
+        if(row > 0 && row % 3 == 0)
+            cout << "   -------+-------+-------\n";
+        cout << " " << row << " ";
+        for(int column = 0; column < 9; column++)
+        {
+            if(column > 0 && column % 3 == 0)
+                cout << " |";
+            int b = (row / 3) * 3 + column / 3;
+            int cell = (row % 3) * 3 + column % 3;
+            char mark = '.';
+            if((board.getStones(0, b) >> cell) & 1)
+                mark = 'X';
+            else if((board.getStones(1, b) >> cell) & 1)
+                mark = 'O';
+            else if((board.getWonBoards(0) >> b) & 1)
+                mark = 'x';
+            else if((board.getWonBoards(1) >> b) & 1)
+                mark = 'o';
+            else if(!board.isOver() && board.isLegal(b * 9 + cell))
+                mark = '-';
+            cout << " " << mark;
+        }
+        cout << "\n";
+    }
+    cout << endl;
+}
+
+/*
+ *Description: Plays one game between the user and the engine on the console
+ *Precondition: N/A
+ *Postcondition: Returns 0 when the game was played to the end
+ */
+static int playInteractive(UltimateSearch& search)
+{
+    cout << "Play as X or O? ";
+    string choice;
+    if(!(cin >> choice))
+        return 1;
+    int human = (choice == "O" || choice == "o") ? 1 : 0;
+    
+    UltimateBoard board;
+    while(!board.isOver())
+    {
+        printBoard(board);
+        if(board.getSideToMove() == human)
+        {
+            cout << MARKS[human] << " to move; enter row and column: ";
+            int row, column;
+            if(!(cin >> row >> column))
+                return 1;
+            int move = (row / 3) * 27 + (column / 3) * 9 + (row % 3) * 3 + column % 3;
+            if(row < 0 || row > 8 || column < 0 || column > 8 || !board.makeMove(move))
+                cout << "That move is not allowed." << endl;
+        }
+        else
+        {
+            int move = search.chooseMove(board);
+            board.makeMove(move);
+            int b = move / 9, cell = move % 9;
+            cout << "Computer plays " << (b / 3) * 3 + cell / 3 << " " << (b % 3) * 3 + cell % 3
+                 << " (depth " << search.getDepth() << ", " << search.getNodeCount() << " positions)" << endl;
+        }
+    }
+    printBoard(board);
+    if(board.getWinner() < 0)
+        cout << "The game is a draw." << endl;
+    else
+        cout << (board.getWinner() == human ? "You win!" : "The computer wins.") << endl;
+    return 0;
+}
+
+/*
+ *Description: Plays the supplied number of games of the engine against random moves, alternating sides
+ *Precondition: N/A
+ *Postcondition: The results are written to standard output
+ */
+static void playRandom(UltimateSearch& search, int games, uint64_t seed)
+{
+    int results[3] = { 0, 0, 0 }; //Engine wins, losses, draws
+    long searches = 0, depths = 0, nodes = 0;
+    double seconds = 0;
+    
+    for(int game = 0; game < games; game++)
+    {
+        Random random(Random::derive(seed, game));
+        int engine = game & 1;
+        UltimateBoard board;
+        int moves[UltimateBoard::CELL_COUNT];
+        while(!board.isOver())
+        {
+            if(board.getSideToMove() == engine)
+            {
+                auto start = chrono::steady_clock::now();
+                board.makeMove(search.chooseMove(board));
+                seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                searches++;
+                depths += search.getDepth();
+                nodes += search.getNodeCount();
+            }
+            else
+            {
+                int count = board.generateMoves(moves);
+                board.makeMove(moves[random.nextInt(count)]);
+            }
+        }
+        results[board.getWinner() < 0 ? 2 : board.getWinner() == engine ? 0 : 1]++;
+    }
+    
+    cout << games << " games against random play: " << results[0] << " won, " << results[1] << " lost, "
+         << results[2] << " drawn" << endl;
+    if(searches > 0)
+        cout << fixed << setprecision(1) << "average depth " << double(depths) / searches << ", "
+             << setprecision(0) << nodes / seconds << " positions per second" << endl;
+}
+
+int main(int argc, char* argv[])
+{
+    double moveTime = UltimateSearch::DEFAULT_TIME_LIMIT;
+    int depth = 0;
+    int games = 0;
+    uint64_t seed = 1;
+    
+    for(int i = 1; i < argc; i++)
+    {
+        string option = argv[i];
+        bool hasValue = i + 1 < argc;
+        if(option == "--movetime" && hasValue)
+            moveTime = atof(argv[++i]);
+        else if(option == "--depth" && hasValue)
+            depth = atoi(argv[++i]);
+        else if(option == "--selfplay" && hasValue)
+            games = atoi(argv[++i]);
+        else if(option == "--seed" && hasValue)
+            seed = strtoull(argv[++i], 0, 10);
+        else
+        {
+            cerr << "Usage: " << argv[0] << " [--movetime ms] [--depth D] [--selfplay N] [--seed S]" << endl;
+            return 1;
+        }
+    }
+    if(moveTime <= 0 && depth <= 0)
+    {
+        cerr << "A move time or a depth is required" << endl;
+        return 1;
+    }
+    
+    UltimateSearch search;
+    search.setTimeLimit(moveTime > 0 ? moveTime : 0);
+    search.setMaxDepth(depth);
+    if(games > 0)
+    {
+        playRandom(search, games, seed);
+        return 0;
+    }
+    return playInteractive(search);
+}